@@ -1,16 +1,109 @@
 ﻿#include "first_app_raytracing.h"
+#include "lve_scene_file.h"
 #include <stdexcept>
+#include <algorithm>
 #include <array>
 #include <random>
 #include <iostream>
 #include <cmath>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 
 namespace lve {
 
     // Static instance pointer for GLFW callbacks
     FirstAppRayTracing* FirstAppRayTracing::instance = nullptr;
 
+    namespace {
+        // BGRA8 → binary PPM (P6)
+        void writePPM(const std::string& path, const uint8_t* bgra, uint32_t width, uint32_t height) {
+            std::ofstream file(path, std::ios::binary);
+            if (!file) {
+                throw std::runtime_error("failed to open output file: " + path);
+            }
+
+            file << "P6\n" << width << " " << height << "\n255\n";
+
+            std::vector<uint8_t> row(width * 3);
+            for (uint32_t y = 0; y < height; y++) {
+                const uint8_t* src = bgra + static_cast<size_t>(y) * width * 4;
+                for (uint32_t x = 0; x < width; x++) {
+                    row[x * 3 + 0] = src[x * 4 + 2];
+                    row[x * 3 + 1] = src[x * 4 + 1];
+                    row[x * 3 + 2] = src[x * 4 + 0];
+                }
+                file.write(reinterpret_cast<const char*>(row.data()), row.size());
+            }
+        }
+
+        const char* sceneTypeName(SceneType scene) {
+            switch (scene) {
+            case SceneType::SmallLights: return "lights";
+            case SceneType::Stress: return "stress";
+            default: return "weekend";
+            }
+        }
+
+        const char* integratorModeName(IntegratorMode mode) {
+            return mode == IntegratorMode::Wavefront ? "wavefront" : "megakernel";
+        }
+
+        // JSON 문자열 (따옴표 / 역슬래시 / 제어 문자만 escape)
+        std::string jsonString(const std::string& value) {
+            std::string result = "\"";
+            for (char c : value) {
+                if (c == '"' || c == '\\') {
+                    result += '\\';
+                    result += c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    result += escaped;
+                }
+                else {
+                    result += c;
+                }
+            }
+            return result + "\"";
+        }
+
+        // Benchmark 프레임별 값 요약 (min / avg / p50 / p99 / max)
+        void writeJsonSummary(std::ostream& out, const char* name, std::vector<float> values, bool last = false) {
+            out << "    " << jsonString(name) << ": ";
+            if (values.empty()) {
+                out << "null" << (last ? "\n" : ",\n");
+                return;
+            }
+
+            std::sort(values.begin(), values.end());
+            double sum = 0.0;
+            for (float value : values) sum += value;
+            const size_t p99Index = std::min(values.size() - 1, static_cast<size_t>(values.size() * 0.99));
+
+            out << "{ \"min\": " << values.front() << ", \"avg\": " << sum / values.size()
+                << ", \"p50\": " << values[values.size() / 2] << ", \"p99\": " << values[p99Index]
+                << ", \"max\": " << values.back() << " }" << (last ? "\n" : ",\n");
+        }
+
+        // 처음 대기에서 막히지 않도록 signaled 상태로 생성
+        std::vector<VkFence> createBenchmarkFences(LveDevice& device, uint32_t count) {
+            std::vector<VkFence> fences(count);
+            for (VkFence& fence : fences) {
+                VkFenceCreateInfo fenceInfo{};
+                fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+                fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+                if (vkCreateFence(device.device(), &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+                    throw std::runtime_error("failed to create benchmark fence!");
+                }
+            }
+            return fences;
+        }
+    }
+
     // Random utility class for scene generation
     class RandomGenerator {
     public:
@@ -84,6 +177,137 @@ namespace lve {
         std::cout << "Created " << sphereCount << " random spheres + 3 big spheres + ground" << std::endl;
     }
 
+    void FirstAppRayTracing::createSmallLightsScene() {
+        createOneWeekendFinalScene();
+
+        // 하늘은 거의 끄고 작은 발광 구 몇 개로 조명 (화면에서 차지하는 면적이 작을수록 NEE 효과가 큼)
+        skyIntensity = 0.02f;
+        accelerationStructure->addEmissiveSphere(glm::vec3(0.0f, 3.0f, 0.0f), glm::vec3(1.0f, 0.9f, 0.7f), 0.25f, 60.0f);
+        accelerationStructure->addEmissiveSphere(glm::vec3(-4.0f, 2.6f, 1.5f), glm::vec3(0.6f, 0.7f, 1.0f), 0.15f, 80.0f);
+        accelerationStructure->addEmissiveSphere(glm::vec3(4.0f, 2.6f, -1.5f), glm::vec3(1.0f, 0.6f, 0.4f), 0.15f, 80.0f);
+
+        std::cout << "Added 3 emissive spheres (sky intensity " << skyIntensity << ")" << std::endl;
+    }
+
+    void FirstAppRayTracing::createStressScene() {
+        RandomGenerator rng(7);
+
+        std::cout << "Creating stress scene..." << std::endl;
+
+        accelerationStructure->addSphereMesh(
+            glm::vec3(0.0f, -1000.0f, 0.0f), glm::vec3(0.5f, 0.5f, 0.5f), 1000.0f, 0.0f, 0.0f, 64, 32);
+
+        // 이웃한 pixel이 서로 다른 material을 맞도록 고르게 섞고, 유리 비율을 높여 path 길이 편차를 키움
+        uint32_t lightCount = 0;
+        const int gridSize = static_cast<int>(std::max(options.stressGridSize, 1u));
+        const int gridBegin = -gridSize / 2;
+        for (int a = gridBegin; a < gridBegin + gridSize; a++) {
+            for (int b = gridBegin; b < gridBegin + gridSize; b++) {
+                float choose_mat = rng.randomFloat();
+                glm::vec3 center(a + 0.9f * rng.randomFloat(), 0.2f, b + 0.9f * rng.randomFloat());
+
+                if (choose_mat < 0.3f) {
+                    glm::vec3 albedo = rng.randomVec3() * rng.randomVec3();
+                    accelerationStructure->addSphereMesh(center, albedo, 0.2f, 0.0f, 0.0f, 16, 8);
+                }
+                else if (choose_mat < 0.6f) {
+                    glm::vec3 albedo = rng.randomVec3(0.5f, 1.0f);
+                    float fuzz = rng.randomFloat(0.0f, 0.5f);
+                    accelerationStructure->addSphereMesh(center, albedo, 0.2f, 1.0f, fuzz, 16, 8);
+                }
+                else if (choose_mat < 0.95f) {
+                    accelerationStructure->addSphereMesh(center, glm::vec3(1.0f), 0.2f, 2.0f, 1.5f, 16, 8);
+                }
+                else {
+                    accelerationStructure->addEmissiveSphere(center, rng.randomVec3(0.5f, 1.0f), 0.2f, rng.randomFloat(4.0f, 8.0f));
+                    lightCount++;
+                }
+            }
+        }
+
+        accelerationStructure->addSphereMesh(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f), 1.0f, 2.0f, 1.5f, 32, 16);
+        accelerationStructure->addSphereMesh(glm::vec3(-4.0f, 1.0f, 0.0f), glm::vec3(0.4f, 0.2f, 0.1f), 1.0f, 0.0f, 0.0f, 32, 16);
+        accelerationStructure->addSphereMesh(glm::vec3(4.0f, 1.0f, 0.0f), glm::vec3(0.7f, 0.6f, 0.5f), 1.0f, 1.0f, 0.0f, 32, 16);
+
+        skyIntensity = 0.25f;
+        std::cout << "Created " << gridSize * gridSize << " small spheres (" << lightCount << " emissive) + 3 big spheres + ground" << std::endl;
+    }
+
+    void FirstAppRayTracing::loadSceneFile(const std::string& path) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // mmap한 table을 그대로 복사 (요소별 parsing 없음), sceneFile은 복사 후 바로 unmap
+        LveSceneFile sceneFile{ path };
+        accelerationStructure->addSpheres(sceneFile.getSpheres(), sceneFile.getSphereCount(),
+            sceneFile.getLightIndices(), sceneFile.getLightCount());
+        skyIntensity = sceneFile.getSkyIntensity();
+
+        float loadMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "Loaded scene " << path << ": " << sceneFile.getSphereCount() << " spheres ("
+            << sceneFile.getLightCount() << " emissive) in " << loadMs << " ms" << std::endl;
+    }
+
+    void FirstAppRayTracing::addMeshInstances() {
+        RandomGenerator rng(11);
+
+        // 파일 하나 = model 하나 (glTF node 전부), 같은 mesh는 library가 handle 하나로 합침
+        struct MeshModel {
+            std::vector<LveMeshNode> nodes;
+            float radius = 0.0f;  // 원점 기준 bounding radius (크기 맞춤용)
+        };
+        std::vector<MeshModel> models;
+        for (const std::string& path : options.meshFiles) {
+            MeshModel model;
+            model.nodes = meshLibrary.load(path);
+            for (const LveMeshNode& node : model.nodes) {
+                float scale = std::max({ glm::length(glm::vec3(node.transform[0])),
+                    glm::length(glm::vec3(node.transform[1])), glm::length(glm::vec3(node.transform[2])) });
+                model.radius = std::max(model.radius,
+                    glm::length(glm::vec3(node.transform[3])) + meshLibrary.getMesh(node.mesh).boundingRadius * scale);
+            }
+            if (model.nodes.empty() || model.radius <= 0.0f) {
+                std::cout << "Mesh file " << path << " has no triangles, skipped" << std::endl;
+                continue;
+            }
+            models.push_back(std::move(model));
+        }
+        if (models.empty()) return;
+
+        // 큰 구 앞 (카메라 쪽) 바닥 위, 작은 구보다 높게 띄워 겹치지 않게
+        constexpr float cellSize = 1.4f;
+        constexpr float fitRadius = 0.55f;
+        const int gridSize = static_cast<int>(std::max(options.meshGridSize, 1u));
+        const glm::vec3 gridCenter(0.0f, 1.2f, 2.5f);
+        uint32_t instanceCount = 0;
+        for (int a = 0; a < gridSize; a++) {
+            for (int b = 0; b < gridSize; b++) {
+                const MeshModel& model = models[(a * gridSize + b) % models.size()];
+                glm::vec3 center = gridCenter +
+                    glm::vec3((a - (gridSize - 1) * 0.5f) * cellSize, 0.0f, (b - (gridSize - 1) * 0.5f) * cellSize);
+                glm::mat4 placement = glm::translate(glm::mat4(1.0f), center) *
+                    glm::rotate(glm::mat4(1.0f), rng.randomFloat(0.0f, 6.2831853f), glm::vec3(0.0f, 1.0f, 0.0f)) *
+                    glm::scale(glm::mat4(1.0f), glm::vec3(fitRadius / model.radius));
+
+                // model 안의 node는 같은 material
+                float choose_mat = rng.randomFloat();
+                glm::vec3 albedo = rng.randomVec3(0.3f, 1.0f);
+                float materialType = choose_mat < 0.6f ? 0.0f : (choose_mat < 0.85f ? 1.0f : 2.0f);
+                float materialParam = materialType == 1.0f ? rng.randomFloat(0.0f, 0.3f) : (materialType == 2.0f ? 1.5f : 0.0f);
+                if (materialType == 2.0f) albedo = glm::vec3(1.0f);
+
+                for (const LveMeshNode& node : model.nodes) {
+                    accelerationStructure->addMeshInstance(
+                        node.mesh, placement * node.transform, albedo, materialType, materialParam);
+                    instanceCount++;
+                }
+            }
+        }
+
+        std::cout << "Added " << instanceCount << " mesh instances (" << meshLibrary.getMeshCount() << " unique meshes, "
+            << meshLibrary.getDuplicateCount() << " duplicates shared)" << std::endl;
+    }
+
     void FirstAppRayTracing::initCamera() {
         cameraPos = glm::vec3(13.0f, 2.0f, 3.0f);
 
@@ -108,7 +332,9 @@ namespace lve {
 
         instance = this;
 
-        GLFWwindow* window = lveWindow.getGLFWwindow();
+        if (!lveWindow) return;
+
+        GLFWwindow* window = lveWindow->getGLFWwindow();
         glfwSetCursorPosCallback(window, mouseCallback);
         glfwSetKeyCallback(window, keyCallback);
         glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -174,10 +400,99 @@ namespace lve {
             instance->updateCameraVectors();
             std::cout << "Camera reset to initial position" << std::endl;
         }
+
+        if (key == GLFW_KEY_T && action == GLFW_PRESS) {
+            instance->sphereAnimationEnabled = !instance->sphereAnimationEnabled;
+            std::cout << "Sphere animation " << (instance->sphereAnimationEnabled ? "ON" : "OFF") << std::endl;
+        }
+
+        if (key == GLFW_KEY_F && action == GLFW_PRESS) {
+            instance->svgfEnabled = !instance->svgfEnabled;
+            // 꺼져 있던 동안의 history / 누적 결과는 쓸 수 없음
+            if (instance->svgfEnabled) {
+                instance->svgfDenoiser->resetHistory();
+            }
+            else {
+                instance->accumulatedFrames = 0;
+            }
+            std::cout << "SVGF denoiser " << (instance->svgfEnabled ? "ON" : "OFF") << std::endl;
+        }
+
+        // Quality preset: 모든 variant가 미리 만들어져 있어 바로 전환
+        if (key >= GLFW_KEY_1 && key <= GLFW_KEY_9 && action == GLFW_PRESS) {
+            uint32_t index = static_cast<uint32_t>(key - GLFW_KEY_1);
+            if (index < instance->rayTracingPipeline->getPresetCount()) {
+                instance->rayTracingPipeline->setActivePreset(index);
+                instance->accumulatedFrames = 0;
+                std::cout << "Quality preset: " << instance->rayTracingPipeline->getPreset(index).name << std::endl;
+            }
+        }
+
+        if (key == GLFW_KEY_I && action == GLFW_PRESS && instance->accelerationStructure->getMeshInstanceCount() > 0) {
+            std::cout << "Integrator: wavefront does not support meshes" << std::endl;
+        }
+        else if (key == GLFW_KEY_I && action == GLFW_PRESS) {
+            instance->integratorMode = instance->integratorMode == IntegratorMode::Megakernel
+                ? IntegratorMode::Wavefront : IntegratorMode::Megakernel;
+            instance->accumulatedFrames = 0;
+            std::cout << "Integrator: " << integratorModeName(instance->integratorMode)
+                << (instance->svgfEnabled ? " (megakernel while SVGF is on)" : "") << std::endl;
+        }
+
+        if (key == GLFW_KEY_N && action == GLFW_PRESS) {
+            instance->sampler->setType(instance->sampler->nextType());
+            instance->accumulatedFrames = 0;
+            std::cout << "Sampler: " << LveSampler::getTypeName(instance->sampler->getType()) << std::endl;
+        }
+
+        if (key == GLFW_KEY_V && action == GLFW_PRESS) {
+            instance->adaptiveEnabled = !instance->adaptiveEnabled;
+            // moments가 없는 누적 결과에는 이어 붙일 수 없음
+            instance->accumulatedFrames = 0;
+            std::cout << "Adaptive sampling " << (instance->adaptiveEnabled ? "ON" : "OFF")
+                << (instance->adaptiveEnabled && !instance->isAdaptiveActive() ? " (uniform while SVGF / wavefront is on)" : "")
+                << std::endl;
+        }
+
+        if (key == GLFW_KEY_G && action == GLFW_PRESS && instance->presentBlitSupported) {
+            instance->dynamicResolutionEnabled = !instance->dynamicResolutionEnabled;
+            std::cout << "Dynamic resolution " << (instance->dynamicResolutionEnabled ? "ON" : "OFF")
+                << (instance->dynamicResolutionEnabled && !instance->isDynamicResolutionActive()
+                    ? " (full resolution while SVGF / wavefront is on)" : "")
+                << std::endl;
+        }
+
+        if (key == GLFW_KEY_P && action == GLFW_PRESS) {
+            instance->gpuProfiler->printStatistics();
+        }
+    }
+
+    void FirstAppRayTracing::animateSpheres(float time) {
+        const uint32_t sphereCount = accelerationStructure->getSphereCount();
+
+        // 애니메이션 시작 시점의 위치를 기준으로 통통 튀기기
+        if (animationBaseCenters.size() != sphereCount) {
+            animationBaseCenters.resize(sphereCount);
+            for (uint32_t i = 0; i < sphereCount; i++) {
+                animationBaseCenters[i] = accelerationStructure->getSphereInfo(i).center;
+            }
+        }
+
+        for (uint32_t i = 0; i < sphereCount; i++) {
+            const SphereInfo& sphere = accelerationStructure->getSphereInfo(i);
+
+            // 작은 구만 (바닥 / 큰 구는 고정)
+            if (sphere.radius > 0.5f) continue;
+
+            float phase = static_cast<float>(i) * 0.618f;
+            float bounce = std::abs(std::sin(time * 2.0f + phase)) * 0.3f;
+            accelerationStructure->setSphereTransform(
+                i, animationBaseCenters[i] + glm::vec3(0.0f, bounce, 0.0f), sphere.radius);
+        }
     }
 
     void FirstAppRayTracing::processInput(float deltaTime) {
-        GLFWwindow* window = lveWindow.getGLFWwindow();
+        GLFWwindow* window = lveWindow->getGLFWwindow();
 
         float velocity = moveSpeed * deltaTime;
 
@@ -201,34 +516,137 @@ namespace lve {
             moveSpeed = 5.0f;
     }
 
-    FirstAppRayTracing::FirstAppRayTracing() {
+    FirstAppRayTracing::FirstAppRayTracing(const AppOptions& options)
+        : options{ options },
+        lveWindow{ options.headless
+            ? nullptr
+            : std::make_unique<LveWindow>(WIDTH, HEIGHT, "Ray Tracing - WASD Move, Mouse Look, ESC Release") },
+        lveDevice{ lveWindow.get() },
+        resolutionController{ options.resolutionSettings } {
+        if (lveWindow) {
+            lveSwapChain = std::make_unique<LveSwapChain>(*lveWindow, lveDevice);
+            renderExtent = lveSwapChain->getSwapChainExtent();
+        }
+        else if (isOffline()) {
+            // Offline은 image를 tile 크기로만 만들고 tile마다 다시 씀
+            const uint32_t tileSize = std::max(options.tileSize, 1u);
+            renderExtent = { std::min(tileSize, options.offlineWidth), std::min(tileSize, options.offlineHeight) };
+        }
+        else {
+            renderExtent = { static_cast<uint32_t>(WIDTH), static_cast<uint32_t>(HEIGHT) };
+        }
+        traceExtent = renderExtent;
+
+        // Dynamic resolution은 storage image (B8G8R8A8) → swapchain blit으로 확대
+        if (lveSwapChain) {
+            VkFormatProperties srcProperties{};
+            VkFormatProperties dstProperties{};
+            vkGetPhysicalDeviceFormatProperties(lveDevice.getPhysicalDevice(), VK_FORMAT_B8G8R8A8_UNORM, &srcProperties);
+            vkGetPhysicalDeviceFormatProperties(
+                lveDevice.getPhysicalDevice(), lveSwapChain->getSwapChainImageFormat(), &dstProperties);
+
+            presentBlitSupported = (srcProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_SRC_BIT) &&
+                (dstProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT);
+            presentBlitFilter = (srcProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)
+                ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+        }
+        if (options.dynamicResolution && !presentBlitSupported) {
+            std::cout << "Dynamic resolution: blit to the swapchain format is not supported, disabled" << std::endl;
+        }
+        dynamicResolutionEnabled = options.dynamicResolution && presentBlitSupported;
+
         vkCmdTraceRaysKHR = reinterpret_cast<PFN_vkCmdTraceRaysKHR>(
             vkGetDeviceProcAddr(lveDevice.device(), "vkCmdTraceRaysKHR"));
 
         initCamera();
 
-        accelerationStructure = std::make_unique<LveAccelerationStructure>(lveDevice);
-        createOneWeekendFinalScene();
+        gpuProfiler = std::make_unique<LveGpuProfiler>(lveDevice, LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+
+        accelerationStructure = std::make_unique<LveAccelerationStructure>(
+            lveDevice, LveSwapChain::MAX_FRAMES_IN_FLIGHT, options.geometryMode);
+        accelerationStructure->setProfiler(gpuProfiler.get());
+        accelerationStructure->setMeshLibrary(&meshLibrary);
+        accelerationStructure->setCachePath(options.accelerationCachePath);
+        accelerationStructure->setHostBuilds(options.hostAccelerationBuilds);
+        // 두 모드 모두 material 수만큼 hit record가 있으므로 instance offset은 모드와 무관
+        accelerationStructure->setHitGroupCount(
+            LveMaterialRegistry::createDefault(options.hitGroupMode).getMaterialCount());
+        if (!options.sceneFile.empty()) {
+            loadSceneFile(options.sceneFile);
+        }
+        else if (options.scene == SceneType::SmallLights) {
+            createSmallLightsScene();
+        }
+        else if (options.scene == SceneType::Stress) {
+            createStressScene();
+        }
+        else {
+            createOneWeekendFinalScene();
+        }
+        addMeshInstances();
+        if (!options.exportScene.empty()) {
+            // .lvscene에는 mesh (vertex / index / transform) table이 없음
+            if (accelerationStructure->getMeshInstanceCount() > 0) {
+                throw std::runtime_error("--export-scene does not support mesh instances");
+            }
+            LveSceneFile::write(options.exportScene, accelerationStructure->getSphereInfos(),
+                accelerationStructure->getLightIndices(), skyIntensity);
+        }
         accelerationStructure->buildAccelerationStructures();
 
-        rayTracingPipeline = std::make_unique<LveRayTracingPipeline>(
-            lveDevice,
-            "shaders/raygen.rgen.spv",
-            "shaders/miss.rmiss.spv",
-            "shaders/closesthit.rchit.spv"
-        );
+        hitGroupMode = options.hitGroupMode;
+        rayTracingPipeline = createRayTracingPipeline(hitGroupMode);
 
         createStorageImage();
+
+        svgfEnabled = options.denoiser == DenoiserMode::Svgf;
+        svgfDenoiser = std::make_unique<LveSvgfDenoiser>(
+            lveDevice, renderExtent, storageImageViews, options.svgfSettings);
+        svgfDenoiser->setProfiler(gpuProfiler.get());
+        createPreviousCameraBuffers();
+
+        adaptiveEnabled = options.adaptive;
+        adaptiveSampler = std::make_unique<LveAdaptiveSampler>(lveDevice, renderExtent, options.adaptiveSettings);
+        adaptiveSampler->setProfiler(gpuProfiler.get());
+
+        sampler = std::make_unique<LveSampler>(lveDevice, options.sampler);
+
+        // 꺼져 있어도 생성 (I 키로 바로 전환)
+        // Wavefront kernel은 구만 교차 / shading하므로 mesh가 있으면 megakernel 고정
+        integratorMode = options.integrator;
+        if (integratorMode == IntegratorMode::Wavefront && accelerationStructure->getMeshInstanceCount() > 0) {
+            std::cout << "Integrator: wavefront does not support meshes, using megakernel" << std::endl;
+            integratorMode = IntegratorMode::Megakernel;
+        }
+        wavefrontTracer = std::make_unique<LveWavefrontTracer>(
+            lveDevice, renderExtent, *accelerationStructure, *sampler, accumulationImageView, storageImageViews,
+            options.geometryMode == SphereGeometryMode::Procedural ? "shaders/sphere.rint.spv" : "");
+        wavefrontTracer->setProfiler(gpuProfiler.get());
+
         createDescriptorPool();
         createDescriptorSets();
         createCommandBuffers();
+        if (options.headless || isOffline()) {
+            createReadbackResources();
+        }
+
+        lveDevice.printMemoryStatistics();
     }
 
     FirstAppRayTracing::~FirstAppRayTracing() {
+        for (ReadbackFrame& readback : readbackFrames) {
+            vkDestroyFence(lveDevice.device(), readback.fence, nullptr);
+            lveDevice.destroyBuffer(readback.buffer, readback.allocation);
+        }
+
         for (size_t i = 0; i < storageImages.size(); i++) {
             vkDestroyImageView(lveDevice.device(), storageImageViews[i], nullptr);
-            vkDestroyImage(lveDevice.device(), storageImages[i], nullptr);
-            vkFreeMemory(lveDevice.device(), storageImageMemories[i], nullptr);
+            lveDevice.destroyImage(storageImages[i], storageImageAllocations[i]);
+        }
+        vkDestroyImageView(lveDevice.device(), accumulationImageView, nullptr);
+        lveDevice.destroyImage(accumulationImage, accumulationImageAllocation);
+        for (size_t i = 0; i < previousCameraBuffers.size(); i++) {
+            lveDevice.destroyBuffer(previousCameraBuffers[i], previousCameraAllocations[i]);
         }
         vkDestroyDescriptorPool(lveDevice.device(), descriptorPool, nullptr);
 
@@ -242,10 +660,60 @@ namespace lve {
         instance = nullptr;
     }
 
+    std::unique_ptr<LveRayTracingPipeline> FirstAppRayTracing::createRayTracingPipeline(LveHitGroupMode mode) {
+        // Procedural 모드는 AABB hit group에 intersection shader 추가
+        const bool procedural = options.geometryMode == SphereGeometryMode::Procedural;
+        auto pipeline = std::make_unique<LveRayTracingPipeline>(
+            lveDevice,
+            "shaders/raygen.rgen.spv",
+            std::vector<std::string>{ "shaders/miss.rmiss.spv", "shaders/shadow.rmiss.spv" },
+            LveMaterialRegistry::createDefault(mode),
+            procedural ? "shaders/sphere.rint.spv" : ""
+        );
+        if (!pipeline->setActivePreset(options.qualityPreset)) {
+            throw std::runtime_error("unknown quality preset: " + options.qualityPreset);
+        }
+        return pipeline;
+    }
+
     void FirstAppRayTracing::run() {
+        if (options.hitGroupBenchmark) {
+            runHitGroupBenchmark();
+            return;
+        }
+
+        if (options.integratorBenchmark) {
+            if (accelerationStructure->getMeshInstanceCount() > 0) {
+                throw std::runtime_error("--benchmark-integrators does not support meshes (wavefront is spheres only)");
+            }
+            runIntegratorBenchmark();
+            return;
+        }
+
+        if (options.pathBenchmark) {
+            runPathBenchmark();
+            return;
+        }
+
+        if (isOffline()) {
+            runOffline();
+            return;
+        }
+
+        if (options.headless) {
+            runHeadless();
+            return;
+        }
+
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        while (!lveWindow.shouldClose()) {
+        // 평균 frame time 출력 (geometry 모드 비교용)
+        const char* modeName =
+            options.geometryMode == SphereGeometryMode::Procedural ? "procedural" : "triangles";
+        float reportStartTime = 0.0f;
+        uint32_t reportFrameCount = 0;
+
+        while (!lveWindow->shouldClose()) {
             glfwPollEvents();
 
             auto currentTime = std::chrono::high_resolution_clock::now();
@@ -254,24 +722,483 @@ namespace lve {
             lastFrameTime = time;
 
             processInput(deltaTime);
+            if (!options.recordPathFile.empty()) {
+                LveCameraKey key{};
+                key.time = time;
+                key.position = cameraPos;
+                key.yaw = yaw;
+                key.pitch = pitch;
+                recordedPath.addKey(key);
+            }
+            if (sphereAnimationEnabled) {
+                animateSpheres(time);
+            }
+            updateDynamicResolution();
             drawFrame();
+
+            reportFrameCount++;
+            if (time - reportStartTime >= 2.0f) {
+                float avgMs = (time - reportStartTime) * 1000.0f / static_cast<float>(reportFrameCount);
+                const LveQualityPreset& preset = rayTracingPipeline->getPreset(rayTracingPipeline->getActivePreset());
+                std::cout << "[" << modeName << ", " << preset.name << ", " << hitGroupModeName(hitGroupMode)
+                    << ", " << integratorModeName(svgfEnabled ? IntegratorMode::Megakernel : integratorMode)
+                    << ", " << LveSampler::getTypeName(sampler->getType())
+                    << (svgfEnabled ? " + svgf" : "") << (isAdaptiveActive() ? " + adaptive" : "") << "] avg frame time: "
+                    << avgMs << " ms";
+                if (isDynamicResolutionActive()) {
+                    std::cout << ", trace " << traceExtent.width << "x" << traceExtent.height
+                        << " (gpu " << resolutionController.getSmoothedMs() << " ms)";
+                }
+                std::cout << std::endl;
+                reportStartTime = time;
+                reportFrameCount = 0;
+            }
         }
 
         vkDeviceWaitIdle(lveDevice.device());
+        if (!options.recordPathFile.empty() && !recordedPath.empty()) {
+            recordedPath.save(options.recordPathFile);
+        }
+        reportGpuTimings();
+    }
+
+    bool FirstAppRayTracing::isAdaptiveActive() const {
+        return adaptiveEnabled && !svgfEnabled && integratorMode == IntegratorMode::Megakernel;
+    }
+
+    bool FirstAppRayTracing::isDynamicResolutionActive() const {
+        // SVGF / wavefront image pass는 전체 image 크기를 가정
+        return dynamicResolutionEnabled && !svgfEnabled && integratorMode == IntegratorMode::Megakernel;
+    }
+
+    void FirstAppRayTracing::updateDynamicResolution() {
+        VkExtent2D nextExtent = renderExtent;
+
+        if (!isDynamicResolutionActive()) {
+            resolutionController.reset();
+        }
+        else {
+            // 결과는 frame slot을 다시 쓸 때 수집되므로 MAX_FRAMES_IN_FLIGHT 프레임 늦음
+            float gpuMs = 0.0f;
+            uint64_t sampleIndex = 0;
+            if (gpuProfiler->getLatestSample("gpu frame", gpuMs, sampleIndex) && sampleIndex != lastFrameTimeSample) {
+                lastFrameTimeSample = sampleIndex;
+                resolutionController.update(gpuMs);
+            }
+            nextExtent = resolutionController.getExtent(renderExtent);
+        }
+
+        if (nextExtent.width != traceExtent.width || nextExtent.height != traceExtent.height) {
+            // pixel 위치가 바뀌므로 누적 결과는 버림
+            traceExtent = nextExtent;
+            accumulatedFrames = 0;
+            std::cout << "Dynamic resolution: " << traceExtent.width << "x" << traceExtent.height
+                << " (" << static_cast<int>(resolutionController.getScale() * 100.0f + 0.5f) << "%)" << std::endl;
+        }
+    }
+
+    void FirstAppRayTracing::reportGpuTimings() {
+        gpuProfiler->resolveFrames();
+        gpuProfiler->printStatistics();
+        if (!options.profileCsvPath.empty()) {
+            gpuProfiler->writeCsv(options.profileCsvPath);
+        }
+    }
+
+    FirstAppRayTracing::BenchmarkResult FirstAppRayTracing::runBenchmarkPass(
+        const std::string& label, const std::vector<VkFence>& fences) {
+        const uint32_t framesInFlight = static_cast<uint32_t>(fences.size());
+        const uint32_t warmupFrames = options.warmupFrames;
+        const uint32_t frameCount = std::max(options.benchmarkFrames, 1u);
+
+        BenchmarkResult result{};
+        result.label = label;
+        const std::string measuredScope = "trace rays [" + label + "]";
+
+        // 모든 pass가 같은 sample 수 / 같은 seed 순서로 렌더하도록
+        accumulatedFrames = 0;
+        svgfFrameCounter = 0;
+        svgfDenoiser->resetHistory();
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t frame = 0; frame < warmupFrames + frameCount; frame++) {
+            if (frame == warmupFrames) {
+                vkWaitForFences(lveDevice.device(), framesInFlight, fences.data(), VK_TRUE, UINT64_MAX);
+                startTime = std::chrono::high_resolution_clock::now();
+            }
+            if (lveWindow) {
+                glfwPollEvents();
+            }
+
+            const uint32_t currentFrame = frame % framesInFlight;
+            vkWaitForFences(lveDevice.device(), 1, &fences[currentFrame], VK_TRUE, UINT64_MAX);
+            vkResetFences(lveDevice.device(), 1, &fences[currentFrame]);
+
+            VkCommandBuffer commandBuffer = commandBuffers[currentFrame];
+            vkResetCommandBuffer(commandBuffer, 0);
+
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+            if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+                throw std::runtime_error("failed to begin recording command buffer!");
+            }
+
+            gpuProfiler->beginFrame(commandBuffer, currentFrame);
+            traceScopeName = frame < warmupFrames ? "trace rays (warm-up)" : measuredScope;
+            recordTraceRays(commandBuffer, currentFrame);
+            if (svgfEnabled) {
+                svgfDenoiser->record(commandBuffer, currentFrame);
+            }
+
+            if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+                throw std::runtime_error("failed to record command buffer!");
+            }
+
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+
+            if (vkQueueSubmit(lveDevice.graphicsQueue(), 1, &submitInfo, fences[currentFrame]) != VK_SUCCESS) {
+                throw std::runtime_error("failed to submit benchmark command buffer!");
+            }
+        }
+
+        vkWaitForFences(lveDevice.device(), framesInFlight, fences.data(), VK_TRUE, UINT64_MAX);
+        result.wallMsPerFrame = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count() / static_cast<float>(frameCount);
+        traceScopeName = "trace rays";
+
+        gpuProfiler->resolveFrames();
+        for (const LveGpuProfiler::ScopeStatistics& stats : gpuProfiler->getStatistics()) {
+            if (stats.name == measuredScope) {
+                result.traceRays = stats;
+            }
+        }
+        return result;
+    }
+
+    void FirstAppRayTracing::printBenchmarkResults(const std::string& title, const std::vector<BenchmarkResult>& results) {
+        const LveQualityPreset& preset = rayTracingPipeline->getPreset(rayTracingPipeline->getActivePreset());
+        std::cout << title << " ("
+            << (options.geometryMode == SphereGeometryMode::Procedural ? "procedural" : "triangles") << ", "
+            << sceneTypeName(options.scene) << ", " << preset.name << ", " << std::max(options.benchmarkFrames, 1u)
+            << " frames, " << renderExtent.width << "x" << renderExtent.height << "):" << std::endl;
+
+        for (const BenchmarkResult& result : results) {
+            std::cout << "  " << result.label << ": wall " << result.wallMsPerFrame << " ms/frame";
+            if (result.traceRays.windowSamples > 0) {
+                std::cout << ", trace rays avg " << result.traceRays.avgMs << " ms, p99 "
+                    << result.traceRays.p99Ms << " ms";
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    void FirstAppRayTracing::runHitGroupBenchmark() {
+        // 반대 모드 pipeline도 생성 (descriptor set layout이 같으므로 같은 descriptor set 사용)
+        const LveHitGroupMode otherMode = hitGroupMode == LveHitGroupMode::Specialized
+            ? LveHitGroupMode::Branching : LveHitGroupMode::Specialized;
+        std::unique_ptr<LveRayTracingPipeline> otherPipeline = createRayTracingPipeline(otherMode);
+
+        std::vector<VkFence> fences = createBenchmarkFences(lveDevice, LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+
+        std::vector<BenchmarkResult> results;
+        for (uint32_t pass = 0; pass < 2; pass++) {
+            results.push_back(runBenchmarkPass(hitGroupModeName(hitGroupMode), fences));
+
+            // 다음 pass는 반대 모드 (두 번 바꾸므로 끝나면 원래 모드로 돌아옴)
+            std::swap(rayTracingPipeline, otherPipeline);
+            hitGroupMode = hitGroupMode == LveHitGroupMode::Specialized
+                ? LveHitGroupMode::Branching : LveHitGroupMode::Specialized;
+        }
+
+        vkDeviceWaitIdle(lveDevice.device());
+        for (VkFence fence : fences) {
+            vkDestroyFence(lveDevice.device(), fence, nullptr);
+        }
+
+        printBenchmarkResults("Hit group benchmark", results);
+
+        // results[0] = 시작 모드이므로 이름으로 찾음
+        const BenchmarkResult* branching = nullptr;
+        const BenchmarkResult* specialized = nullptr;
+        for (const BenchmarkResult& result : results) {
+            if (result.label == hitGroupModeName(LveHitGroupMode::Branching)) {
+                branching = &result;
+            }
+            else {
+                specialized = &result;
+            }
+        }
+        if (branching && specialized && branching->traceRays.windowSamples > 0 && specialized->traceRays.avgMs > 0.0f) {
+            std::cout << "  specialized speedup (trace rays avg): "
+                << branching->traceRays.avgMs / specialized->traceRays.avgMs << "x" << std::endl;
+        }
+
+        reportGpuTimings();
+    }
+
+    void FirstAppRayTracing::runIntegratorBenchmark() {
+        // wavefront는 SVGF G-buffer를 안 쓰므로 두 모드 모두 progressive accumulation으로 비교
+        // adaptive sampling도 megakernel에만 있으므로 끄고 같은 spp로 비교
+        const bool svgfWasEnabled = svgfEnabled;
+        const bool adaptiveWasEnabled = adaptiveEnabled;
+        const IntegratorMode startMode = integratorMode;
+        svgfEnabled = false;
+        adaptiveEnabled = false;
+
+        std::vector<VkFence> fences = createBenchmarkFences(lveDevice, LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+
+        std::vector<BenchmarkResult> results;
+        for (IntegratorMode mode : { IntegratorMode::Megakernel, IntegratorMode::Wavefront }) {
+            integratorMode = mode;
+            results.push_back(runBenchmarkPass(integratorModeName(mode), fences));
+        }
+        integratorMode = startMode;
+        svgfEnabled = svgfWasEnabled;
+        adaptiveEnabled = adaptiveWasEnabled;
+
+        vkDeviceWaitIdle(lveDevice.device());
+        for (VkFence fence : fences) {
+            vkDestroyFence(lveDevice.device(), fence, nullptr);
+        }
+
+        printBenchmarkResults("Integrator benchmark", results);
+        std::cout << "  wavefront trace rays: "
+            << (wavefrontTracer->usesIndirectTrace() ? "indirect" : "full-size launch with early-out") << std::endl;
+
+        const BenchmarkResult& megakernel = results[0];
+        const BenchmarkResult& wavefront = results[1];
+        if (megakernel.traceRays.windowSamples > 0 && wavefront.traceRays.avgMs > 0.0f) {
+            std::cout << "  wavefront speedup (trace rays avg): "
+                << megakernel.traceRays.avgMs / wavefront.traceRays.avgMs << "x" << std::endl;
+        }
+
+        reportGpuTimings();
+    }
+
+    void FirstAppRayTracing::runPathBenchmark() {
+        // 경로 파일이 없으면 시작 카메라 높이 / 거리로 원점을 한 바퀴
+        const LveCameraPath cameraPath = options.cameraPathFile.empty()
+            ? LveCameraPath::orbit(cameraPos, glm::vec3(0.0f), 8.0f)
+            : LveCameraPath::load(options.cameraPathFile);
+
+        const uint32_t framesInFlight = LveSwapChain::MAX_FRAMES_IN_FLIGHT;
+        const uint32_t warmupFrames = options.warmupFrames;
+        const uint32_t frameCount = std::max(options.benchmarkFrames, 1u);
+        const std::string frameScope = "gpu frame [path]";
+        const std::string measuredScope = "trace rays [path]";
+
+        std::vector<VkFence> fences = createBenchmarkFences(lveDevice, framesInFlight);
+
+        // 매 실행이 같은 sample 수 / 같은 seed 순서로 렌더하도록
+        accumulatedFrames = 0;
+        svgfFrameCounter = 0;
+        svgfDenoiser->resetHistory();
+
+        std::vector<float> pathTimes;
+        std::vector<float> cpuMs;
+        std::vector<float> gpuFrameMs;
+        std::vector<float> traceRaysMs;
+        uint64_t gpuFrameSample = 0;
+        uint64_t traceRaysSample = 0;
+        pathTimes.reserve(frameCount);
+        cpuMs.reserve(frameCount);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t frame = 0; frame < warmupFrames + frameCount; frame++) {
+            if (frame == warmupFrames) {
+                vkWaitForFences(lveDevice.device(), framesInFlight, fences.data(), VK_TRUE, UINT64_MAX);
+                startTime = std::chrono::high_resolution_clock::now();
+            }
+            if (lveWindow) {
+                glfwPollEvents();
+            }
+
+            // Warm-up은 경로 시작, 측정 구간은 프레임 번호로 경로를 고르게 나눔 (실제 frame time과 무관)
+            const bool measuring = frame >= warmupFrames;
+            const float pathTime = measuring && frameCount > 1
+                ? cameraPath.getDuration() * static_cast<float>(frame - warmupFrames) / static_cast<float>(frameCount - 1)
+                : 0.0f;
+            const LveCameraKey key = cameraPath.sample(pathTime);
+            cameraPos = key.position;
+            yaw = key.yaw;
+            pitch = key.pitch;
+            updateCameraVectors();
+
+            const uint32_t currentFrame = frame % framesInFlight;
+            vkWaitForFences(lveDevice.device(), 1, &fences[currentFrame], VK_TRUE, UINT64_MAX);
+            vkResetFences(lveDevice.device(), 1, &fences[currentFrame]);
+
+            // CPU 시간 = fence 대기를 뺀 기록 + 제출
+            auto cpuStart = std::chrono::high_resolution_clock::now();
+
+            VkCommandBuffer commandBuffer = commandBuffers[currentFrame];
+            vkResetCommandBuffer(commandBuffer, 0);
+
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+            if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+                throw std::runtime_error("failed to begin recording command buffer!");
+            }
+
+            // 이 slot의 지난 프레임 결과가 방금 수집됨 → 측정 프레임 순서대로 모음 (history가 넘치기 전에)
+            gpuProfiler->beginFrame(commandBuffer, currentFrame);
+            gpuFrameSample = gpuProfiler->getSamplesSince(frameScope, gpuFrameSample, gpuFrameMs);
+            traceRaysSample = gpuProfiler->getSamplesSince(measuredScope, traceRaysSample, traceRaysMs);
+
+            {
+                LveGpuProfiler::Scope gpuFrameScope{ gpuProfiler.get(), commandBuffer,
+                    measuring ? frameScope : "gpu frame (warm-up)" };
+                traceScopeName = measuring ? measuredScope : "trace rays (warm-up)";
+                recordTraceRays(commandBuffer, currentFrame);
+                if (svgfEnabled) {
+                    svgfDenoiser->record(commandBuffer, currentFrame);
+                }
+            }
+
+            if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+                throw std::runtime_error("failed to record command buffer!");
+            }
+
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+
+            if (vkQueueSubmit(lveDevice.graphicsQueue(), 1, &submitInfo, fences[currentFrame]) != VK_SUCCESS) {
+                throw std::runtime_error("failed to submit benchmark command buffer!");
+            }
+
+            if (measuring) {
+                pathTimes.push_back(pathTime);
+                cpuMs.push_back(std::chrono::duration<float, std::milli>(
+                    std::chrono::high_resolution_clock::now() - cpuStart).count());
+            }
+        }
+
+        vkWaitForFences(lveDevice.device(), framesInFlight, fences.data(), VK_TRUE, UINT64_MAX);
+        const float wallMsPerFrame = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count() / static_cast<float>(frameCount);
+        traceScopeName = "trace rays";
+
+        gpuProfiler->resolveFrames();
+        gpuFrameSample = gpuProfiler->getSamplesSince(frameScope, gpuFrameSample, gpuFrameMs);
+        traceRaysSample = gpuProfiler->getSamplesSince(measuredScope, traceRaysSample, traceRaysMs);
+
+        for (VkFence fence : fences) {
+            vkDestroyFence(lveDevice.device(), fence, nullptr);
+        }
+
+        // Primary ray = pixel당 sample 하나 (secondary / shadow ray는 세지 않음). adaptive도 총량은 같음
+        const LveQualityPreset& preset = rayTracingPipeline->getPreset(rayTracingPipeline->getActivePreset());
+        const uint32_t samplesPerPixel = svgfEnabled ? 1 : preset.samplesPerPixel;
+        const double primaryRays = static_cast<double>(traceExtent.width) * traceExtent.height * samplesPerPixel;
+        std::vector<float> raysPerSecond;
+        for (float ms : traceRaysMs) {
+            if (ms > 0.0f) {
+                raysPerSecond.push_back(static_cast<float>(primaryRays / (ms * 1.0e-3)));
+            }
+        }
+
+        const LveMemoryStatistics memory = lveDevice.getMemoryStatistics();
+
+        std::ofstream file(options.benchmarkJsonPath);
+        if (!file) {
+            throw std::runtime_error("failed to open benchmark output: " + options.benchmarkJsonPath);
+        }
+
+        file << "{\n";
+        file << "  \"scene\": " << jsonString(sceneTypeName(options.scene)) << ",\n";
+        file << "  \"geometry\": "
+            << jsonString(options.geometryMode == SphereGeometryMode::Procedural ? "procedural" : "triangles") << ",\n";
+        file << "  \"integrator\": " << jsonString(integratorModeName(svgfEnabled ? IntegratorMode::Megakernel : integratorMode)) << ",\n";
+        file << "  \"hitGroups\": " << jsonString(hitGroupModeName(hitGroupMode)) << ",\n";
+        file << "  \"sampler\": " << jsonString(LveSampler::getTypeName(sampler->getType())) << ",\n";
+        file << "  \"denoiser\": " << jsonString(svgfEnabled ? "svgf" : "none") << ",\n";
+        file << "  \"adaptive\": " << (isAdaptiveActive() ? "true" : "false") << ",\n";
+        file << "  \"preset\": " << jsonString(preset.name) << ",\n";
+        file << "  \"device\": " << jsonString(lveDevice.properties.deviceName) << ",\n";
+        file << "  \"headless\": " << (lveWindow ? "false" : "true") << ",\n";
+        file << "  \"width\": " << traceExtent.width << ",\n";
+        file << "  \"height\": " << traceExtent.height << ",\n";
+        file << "  \"samplesPerPixel\": " << samplesPerPixel << ",\n";
+        file << "  \"cameraPath\": " << jsonString(options.cameraPathFile.empty() ? "orbit" : options.cameraPathFile) << ",\n";
+        file << "  \"pathDuration\": " << cameraPath.getDuration() << ",\n";
+        file << "  \"warmupFrames\": " << warmupFrames << ",\n";
+        file << "  \"frames\": " << frameCount << ",\n";
+        file << "  \"wallMsPerFrame\": " << wallMsPerFrame << ",\n";
+
+        file << "  \"summary\": {\n";
+        writeJsonSummary(file, "cpuMs", cpuMs);
+        writeJsonSummary(file, "gpuFrameMs", gpuFrameMs);
+        writeJsonSummary(file, "traceRaysMs", traceRaysMs);
+        writeJsonSummary(file, "primaryRaysPerSecond", raysPerSecond, true);
+        file << "  },\n";
+
+        file << "  \"memory\": {\n";
+        file << "    \"usedBytes\": " << memory.usedBytes << ",\n";
+        file << "    \"peakUsedBytes\": " << memory.peakUsedBytes << ",\n";
+        file << "    \"blockBytes\": " << memory.blockBytes << ",\n";
+        file << "    \"dedicatedBytes\": " << memory.dedicatedBytes << ",\n";
+        file << "    \"allocationCount\": " << memory.allocationCount << ",\n";
+        file << "    \"allocateCalls\": " << memory.allocateCalls << "\n";
+        file << "  },\n";
+
+        // GPU 값은 timestamp를 지원하지 않으면 null
+        file << "  \"perFrame\": [\n";
+        for (uint32_t i = 0; i < frameCount; i++) {
+            file << "    { \"frame\": " << i << ", \"pathTime\": " << pathTimes[i] << ", \"cpuMs\": " << cpuMs[i];
+            file << ", \"gpuFrameMs\": ";
+            if (i < gpuFrameMs.size()) file << gpuFrameMs[i]; else file << "null";
+            file << ", \"traceRaysMs\": ";
+            if (i < traceRaysMs.size()) file << traceRaysMs[i]; else file << "null";
+            file << ", \"primaryRaysPerSecond\": ";
+            if (i < traceRaysMs.size() && traceRaysMs[i] > 0.0f) {
+                file << primaryRays / (traceRaysMs[i] * 1.0e-3);
+            }
+            else {
+                file << "null";
+            }
+            file << (i + 1 < frameCount ? " },\n" : " }\n");
+        }
+        file << "  ]\n";
+        file << "}\n";
+
+        std::cout << "Path benchmark (" << sceneTypeName(options.scene) << ", " << preset.name << ", "
+            << frameCount << " frames, " << traceExtent.width << "x" << traceExtent.height << "): wall "
+            << wallMsPerFrame << " ms/frame";
+        if (!traceRaysMs.empty()) {
+            double sum = 0.0;
+            for (float ms : traceRaysMs) sum += ms;
+            const double avgMs = sum / traceRaysMs.size();
+            std::cout << ", trace rays avg " << avgMs << " ms (" << primaryRays / (avgMs * 1.0e-3) * 1.0e-6 << " Mrays/s)";
+        }
+        std::cout << std::endl;
+        std::cout << "Wrote benchmark results to " << options.benchmarkJsonPath << std::endl;
+
+        reportGpuTimings();
     }
 
     void FirstAppRayTracing::createStorageImage() {
         const size_t framesInFlight = LveSwapChain::MAX_FRAMES_IN_FLIGHT;
         storageImages.resize(framesInFlight);
-        storageImageMemories.resize(framesInFlight);
+        storageImageAllocations.resize(framesInFlight);
         storageImageViews.resize(framesInFlight);
 
         for (size_t i = 0; i < framesInFlight; i++) {
             VkImageCreateInfo imageInfo{};
             imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
             imageInfo.imageType = VK_IMAGE_TYPE_2D;
-            imageInfo.extent.width = lveSwapChain.width();
-            imageInfo.extent.height = lveSwapChain.height();
+            imageInfo.extent.width = renderExtent.width;
+            imageInfo.extent.height = renderExtent.height;
             imageInfo.extent.depth = 1;
             imageInfo.mipLevels = 1;
             imageInfo.arrayLayers = 1;
@@ -286,7 +1213,7 @@ namespace lve {
                 imageInfo,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 storageImages[i],
-                storageImageMemories[i]
+                storageImageAllocations[i]
             );
 
             VkImageViewCreateInfo viewInfo{};
@@ -305,24 +1232,61 @@ namespace lve {
             }
         }
 
+        // Accumulation Image (HDR running average, 하나만)
+        VkImageCreateInfo accumulationInfo{};
+        accumulationInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        accumulationInfo.imageType = VK_IMAGE_TYPE_2D;
+        accumulationInfo.extent.width = renderExtent.width;
+        accumulationInfo.extent.height = renderExtent.height;
+        accumulationInfo.extent.depth = 1;
+        accumulationInfo.mipLevels = 1;
+        accumulationInfo.arrayLayers = 1;
+        accumulationInfo.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        accumulationInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        accumulationInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        accumulationInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;  // offline readback
+        accumulationInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        accumulationInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        lveDevice.createImageWithInfo(
+            accumulationInfo,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            accumulationImage,
+            accumulationImageAllocation
+        );
+
+        VkImageViewCreateInfo accumulationViewInfo{};
+        accumulationViewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        accumulationViewInfo.image = accumulationImage;
+        accumulationViewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        accumulationViewInfo.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        accumulationViewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+        if (vkCreateImageView(lveDevice.device(), &accumulationViewInfo, nullptr, &accumulationImageView) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create accumulation image view!");
+        }
+
         VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
 
-        std::vector<VkImageMemoryBarrier> barriers(framesInFlight);
-        for (size_t i = 0; i < framesInFlight; i++) {
+        std::vector<VkImage> images = storageImages;
+        images.push_back(accumulationImage);
+
+        std::vector<VkImageMemoryBarrier> barriers(images.size());
+        for (size_t i = 0; i < images.size(); i++) {
             barriers[i] = {};
             barriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
             barriers[i].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
             barriers[i].newLayout = VK_IMAGE_LAYOUT_GENERAL;
             barriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
             barriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barriers[i].image = storageImages[i];
+            barriers[i].image = images[i];
             barriers[i].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
             barriers[i].subresourceRange.baseMipLevel = 0;
             barriers[i].subresourceRange.levelCount = 1;
             barriers[i].subresourceRange.baseArrayLayer = 0;
             barriers[i].subresourceRange.layerCount = 1;
             barriers[i].srcAccessMask = 0;
-            barriers[i].dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            barriers[i].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
         }
 
         vkCmdPipelineBarrier(
@@ -338,18 +1302,35 @@ namespace lve {
         lveDevice.endSingleTimeCommands(commandBuffer);
     }
 
+    void FirstAppRayTracing::createPreviousCameraBuffers() {
+        const size_t framesInFlight = LveSwapChain::MAX_FRAMES_IN_FLIGHT;
+        previousCameraBuffers.resize(framesInFlight);
+        previousCameraAllocations.resize(framesInFlight);
+
+        for (size_t i = 0; i < framesInFlight; i++) {
+            lveDevice.createBuffer(
+                sizeof(PreviousCameraUniform),
+                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                previousCameraBuffers[i],
+                previousCameraAllocations[i]
+            );
+        }
+    }
+
     void FirstAppRayTracing::createDescriptorPool() {
         const uint32_t framesInFlight = LveSwapChain::MAX_FRAMES_IN_FLIGHT;
 
         VkDescriptorPoolSize poolSizes[] = {
             {VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, framesInFlight},
-            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, framesInFlight},
-            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight},
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, framesInFlight * 8},  // output + accumulation + SVGF G-buffer 4개 + adaptive 2개
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight * 4},  // sphere info + light list + blue noise + mesh table
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight},     // 이전 프레임 카메라
         };
 
         VkDescriptorPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolInfo.poolSizeCount = 3;
+        poolInfo.poolSizeCount = 4;
         poolInfo.pPoolSizes = poolSizes;
         poolInfo.maxSets = framesInFlight;
 
@@ -374,11 +1355,12 @@ namespace lve {
             throw std::runtime_error("failed to allocate descriptor sets!");
         }
 
+        writeDescriptorSets();
+    }
+
+    void FirstAppRayTracing::writeDescriptorSets() {
+        const size_t framesInFlight = LveSwapChain::MAX_FRAMES_IN_FLIGHT;
         VkAccelerationStructureKHR tlas = accelerationStructure->getTLAS();
-        VkDescriptorBufferInfo sphereBufferInfo{};
-        sphereBufferInfo.buffer = accelerationStructure->getSphereInfoBuffer();
-        sphereBufferInfo.offset = 0;
-        sphereBufferInfo.range = VK_WHOLE_SIZE;
 
         for (size_t i = 0; i < framesInFlight; i++) {
             // Binding 0: TLAS
@@ -408,7 +1390,12 @@ namespace lve {
             imageWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             imageWrite.pImageInfo = &imageInfo;
 
-            // Binding 2: Sphere Info Buffer
+            // Binding 2: Sphere Info Buffer (frame별)
+            VkDescriptorBufferInfo sphereBufferInfo{};
+            sphereBufferInfo.buffer = accelerationStructure->getSphereInfoBuffer(static_cast<uint32_t>(i));
+            sphereBufferInfo.offset = 0;
+            sphereBufferInfo.range = VK_WHOLE_SIZE;
+
             VkWriteDescriptorSet sphereWrite{};
             sphereWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
             sphereWrite.dstSet = descriptorSets[i];
@@ -417,13 +1404,113 @@ namespace lve {
             sphereWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
             sphereWrite.pBufferInfo = &sphereBufferInfo;
 
-            VkWriteDescriptorSet writes[] = { asWrite, imageWrite, sphereWrite };
-            vkUpdateDescriptorSets(lveDevice.device(), 3, writes, 0, nullptr);
+            // Binding 3: Accumulation Image (공유)
+            VkDescriptorImageInfo accumulationInfo{};
+            accumulationInfo.imageView = accumulationImageView;
+            accumulationInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+            VkWriteDescriptorSet accumulationWrite{};
+            accumulationWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            accumulationWrite.dstSet = descriptorSets[i];
+            accumulationWrite.dstBinding = 3;
+            accumulationWrite.descriptorCount = 1;
+            accumulationWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            accumulationWrite.pImageInfo = &accumulationInfo;
+
+            // Binding 4-7: SVGF G-buffer (공유)
+            VkDescriptorImageInfo gBufferInfos[] = {
+                { VK_NULL_HANDLE, svgfDenoiser->getColorView(), VK_IMAGE_LAYOUT_GENERAL },
+                { VK_NULL_HANDLE, svgfDenoiser->getAlbedoView(), VK_IMAGE_LAYOUT_GENERAL },
+                { VK_NULL_HANDLE, svgfDenoiser->getNormalDepthView(), VK_IMAGE_LAYOUT_GENERAL },
+                { VK_NULL_HANDLE, svgfDenoiser->getMotionMeshView(), VK_IMAGE_LAYOUT_GENERAL },
+            };
+
+            VkWriteDescriptorSet gBufferWrite{};
+            gBufferWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            gBufferWrite.dstSet = descriptorSets[i];
+            gBufferWrite.dstBinding = 4;
+            gBufferWrite.descriptorCount = 1;
+            gBufferWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+
+            // Binding 8: 이전 프레임 카메라 (frame별)
+            VkDescriptorBufferInfo previousCameraInfo{};
+            previousCameraInfo.buffer = previousCameraBuffers[i];
+            previousCameraInfo.offset = 0;
+            previousCameraInfo.range = sizeof(PreviousCameraUniform);
+
+            VkWriteDescriptorSet previousCameraWrite{};
+            previousCameraWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            previousCameraWrite.dstSet = descriptorSets[i];
+            previousCameraWrite.dstBinding = 8;
+            previousCameraWrite.descriptorCount = 1;
+            previousCameraWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            previousCameraWrite.pBufferInfo = &previousCameraInfo;
+
+            std::vector<VkWriteDescriptorSet> writes = { asWrite, imageWrite, sphereWrite, accumulationWrite };
+            for (uint32_t g = 0; g < 4; g++) {
+                gBufferWrite.dstBinding = 4 + g;
+                gBufferWrite.pImageInfo = &gBufferInfos[g];
+                writes.push_back(gBufferWrite);
+            }
+            writes.push_back(previousCameraWrite);
+
+            // Binding 9: 발광 구 목록 (frame별)
+            VkDescriptorBufferInfo lightBufferInfo{};
+            lightBufferInfo.buffer = accelerationStructure->getLightBuffer(static_cast<uint32_t>(i));
+            lightBufferInfo.offset = 0;
+            lightBufferInfo.range = VK_WHOLE_SIZE;
+
+            VkWriteDescriptorSet lightWrite = sphereWrite;
+            lightWrite.dstBinding = 9;
+            lightWrite.pBufferInfo = &lightBufferInfo;
+            writes.push_back(lightWrite);
+
+            // Binding 10: blue-noise texture (공유)
+            VkDescriptorBufferInfo blueNoiseInfo{};
+            blueNoiseInfo.buffer = sampler->getBlueNoiseBuffer();
+            blueNoiseInfo.offset = 0;
+            blueNoiseInfo.range = VK_WHOLE_SIZE;
+
+            VkWriteDescriptorSet blueNoiseWrite = sphereWrite;
+            blueNoiseWrite.dstBinding = 10;
+            blueNoiseWrite.pBufferInfo = &blueNoiseInfo;
+            writes.push_back(blueNoiseWrite);
+
+            // Binding 11-12: adaptive sampling moments / sample count map (공유)
+            VkDescriptorImageInfo adaptiveInfos[] = {
+                { VK_NULL_HANDLE, adaptiveSampler->getMomentsView(), VK_IMAGE_LAYOUT_GENERAL },
+                { VK_NULL_HANDLE, adaptiveSampler->getSampleCountView(), VK_IMAGE_LAYOUT_GENERAL },
+            };
+            for (uint32_t a = 0; a < 2; a++) {
+                VkWriteDescriptorSet adaptiveWrite = accumulationWrite;
+                adaptiveWrite.dstBinding = 11 + a;
+                adaptiveWrite.pImageInfo = &adaptiveInfos[a];
+                writes.push_back(adaptiveWrite);
+            }
+
+            // Binding 13: mesh table (공유)
+            VkDescriptorBufferInfo meshTableInfo{};
+            meshTableInfo.buffer = accelerationStructure->getMeshTableBuffer();
+            meshTableInfo.offset = 0;
+            meshTableInfo.range = VK_WHOLE_SIZE;
+
+            VkWriteDescriptorSet meshTableWrite = sphereWrite;
+            meshTableWrite.dstBinding = 13;
+            meshTableWrite.pBufferInfo = &meshTableInfo;
+            writes.push_back(meshTableWrite);
+
+            vkUpdateDescriptorSets(lveDevice.device(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
         }
+
+        // wavefront compute kernel도 같은 sphere / light buffer를 읽음
+        wavefrontTracer->writeSceneDescriptors();
     }
 
     void FirstAppRayTracing::createCommandBuffers() {
-        commandBuffers.resize(lveSwapChain.imageCount());
+        // headless는 swapchain image가 없으므로 frame in flight마다 하나
+        commandBuffers.resize(lveSwapChain
+            ? lveSwapChain->imageCount()
+            : static_cast<size_t>(LveSwapChain::MAX_FRAMES_IN_FLIGHT));
 
         VkCommandBufferAllocateInfo allocInfo{};
         allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -446,50 +1533,19 @@ namespace lve {
             throw std::runtime_error("failed to begin recording command buffer!");
         }
 
-        VkImage storageImage = storageImages[currentFrame];
-
-        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, rayTracingPipeline->getPipeline());
-        vkCmdBindDescriptorSets(
-            commandBuffer,
-            VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR,
-            rayTracingPipeline->getPipelineLayout(),
-            0, 1, &descriptorSets[currentFrame], 0, nullptr
-        );
+        // 이 frame slot의 지난 결과 수집 (fence 대기 후라 WAIT 없이 읽힘)
+        gpuProfiler->beginFrame(commandBuffer, currentFrame);
 
-        // Push Constants로 카메라 데이터 전송!
-        CameraPushConstants pushConstants{};
-        pushConstants.position = cameraPos;
-        pushConstants.forward = cameraFront;
-        pushConstants.right = cameraRight;
-        pushConstants.up = cameraUp;
-        pushConstants.vfov = vfov;
-        pushConstants.defocus_angle = defocusAngle;
-        pushConstants.focus_dist = focusDist;
+        // Dynamic resolution 입력 (trace부터 present copy까지)
+        uint32_t frameScope = gpuProfiler->beginScope(commandBuffer, "gpu frame");
 
-        vkCmdPushConstants(
-            commandBuffer,
-            rayTracingPipeline->getPipelineLayout(),
-            VK_SHADER_STAGE_RAYGEN_BIT_KHR,
-            0,
-            sizeof(CameraPushConstants),
-            &pushConstants
-        );
-
-        VkStridedDeviceAddressRegionKHR raygenRegion = rayTracingPipeline->getRaygenRegion();
-        VkStridedDeviceAddressRegionKHR missRegion = rayTracingPipeline->getMissRegion();
-        VkStridedDeviceAddressRegionKHR hitRegion = rayTracingPipeline->getHitRegion();
-        VkStridedDeviceAddressRegionKHR callableRegion = rayTracingPipeline->getCallableRegion();
+        recordTraceRays(commandBuffer, currentFrame);
+        if (svgfEnabled) {
+            svgfDenoiser->record(commandBuffer, currentFrame);
+        }
 
-        vkCmdTraceRaysKHR(
-            commandBuffer,
-            &raygenRegion,
-            &missRegion,
-            &hitRegion,
-            &callableRegion,
-            lveSwapChain.width(),
-            lveSwapChain.height(),
-            1
-        );
+        VkImage storageImage = storageImages[currentFrame];
+        uint32_t copyScope = gpuProfiler->beginScope(commandBuffer, "present copy");
 
         // Storage image → Transfer src
         VkImageMemoryBarrier barrier1{};
@@ -507,10 +1563,11 @@ namespace lve {
         barrier1.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
         barrier1.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
 
-        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+        // SVGF가 켜져 있으면 마지막 쓰기는 modulate compute pass
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier1);
 
-        VkImage swapChainImage = lveSwapChain.getSwapChainImage(imageIndex);
+        VkImage swapChainImage = lveSwapChain->getSwapChainImage(imageIndex);
 
         // Swap chain image → Transfer dst
         VkImageMemoryBarrier barrier2{};
@@ -531,14 +1588,27 @@ namespace lve {
         vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier2);
 
-        // Copy
-        VkImageCopy copyRegion{};
-        copyRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
-        copyRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
-        copyRegion.extent = { lveSwapChain.width(), lveSwapChain.height(), 1 };
+        if (traceExtent.width == renderExtent.width && traceExtent.height == renderExtent.height) {
+            // Copy
+            VkImageCopy copyRegion{};
+            copyRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+            copyRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+            copyRegion.extent = { renderExtent.width, renderExtent.height, 1 };
 
-        vkCmdCopyImage(commandBuffer, storageImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-            swapChainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+            vkCmdCopyImage(commandBuffer, storageImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                swapChainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+        }
+        else {
+            // Dynamic resolution: 왼쪽 위 traceExtent 영역을 전체 화면으로 확대 (bilinear)
+            VkImageBlit blitRegion{};
+            blitRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+            blitRegion.srcOffsets[1] = { static_cast<int32_t>(traceExtent.width), static_cast<int32_t>(traceExtent.height), 1 };
+            blitRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+            blitRegion.dstOffsets[1] = { static_cast<int32_t>(renderExtent.width), static_cast<int32_t>(renderExtent.height), 1 };
+
+            vkCmdBlitImage(commandBuffer, storageImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                swapChainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blitRegion, presentBlitFilter);
+        }
 
         // Swap chain image → Present
         VkImageMemoryBarrier barrier3{};
@@ -576,32 +1646,489 @@ namespace lve {
         barrier4.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
 
         vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, 0, 0, nullptr, 0, nullptr, 1, &barrier4);
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier4);
+
+        gpuProfiler->endScope(commandBuffer, copyScope);
+        gpuProfiler->endScope(commandBuffer, frameScope);
 
         if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
             throw std::runtime_error("failed to record command buffer!");
         }
     }
 
+    void FirstAppRayTracing::recordTraceRays(VkCommandBuffer commandBuffer, uint32_t currentFrame) {
+        // 움직인 구만 instance buffer에 반영 + TLAS refit (필요 시 rebuild)
+        if (accelerationStructure->updateInstances(commandBuffer, currentFrame)) {
+            writeDescriptorSets();
+        }
+
+        // Push Constants로 카메라 데이터 전송!
+        CameraPushConstants pushConstants{};
+        pushConstants.position = cameraPos;
+        pushConstants.forward = cameraFront;
+        pushConstants.right = cameraRight;
+        pushConstants.up = cameraUp;
+        pushConstants.vfov = vfov;
+        pushConstants.defocus_angle = defocusAngle;
+        pushConstants.focus_dist = focusDist;
+        pushConstants.skyIntensity = skyIntensity;
+        pushConstants.samplerType = static_cast<uint32_t>(sampler->getType());
+        pushConstants.tileOffsetX = static_cast<uint32_t>(tileOffset.x);
+        pushConstants.tileOffsetY = static_cast<uint32_t>(tileOffset.y);
+        pushConstants.imageWidth = tileImageExtent.width > 0 ? tileImageExtent.width : traceExtent.width;
+        pushConstants.imageHeight = tileImageExtent.height > 0 ? tileImageExtent.height : traceExtent.height;
+
+        if (svgfEnabled) {
+            // SVGF는 history를 reprojection으로 관리하므로 sample index만 매 프레임 바꿈
+            pushConstants.frameIndex = svgfFrameCounter++;
+            pushConstants.flags = CAMERA_FLAG_SVGF;
+        }
+        else {
+            // 카메라가 움직였거나 장면이 바뀌면 누적 reset
+            bool cameraMoved = cameraPos != accumulationCameraPos ||
+                yaw != accumulationYaw ||
+                pitch != accumulationPitch;
+            if (cameraMoved || sphereAnimationEnabled) {
+                accumulatedFrames = 0;
+                accumulationCameraPos = cameraPos;
+                accumulationYaw = yaw;
+                accumulationPitch = pitch;
+            }
+            pushConstants.frameIndex = accumulatedFrames++;
+        }
+
+        // 이전 프레임 카메라 → 이 frame의 uniform buffer (fence 대기 후라 GPU가 읽는 중 아님)
+        PreviousCameraUniform currentCamera{};
+        currentCamera.position = glm::vec4(cameraPos, vfov);
+        currentCamera.forward = glm::vec4(cameraFront, 0.0f);
+        currentCamera.right = glm::vec4(cameraRight, 0.0f);
+        currentCamera.up = glm::vec4(cameraUp, 0.0f);
+        if (!hasLastCamera) {
+            lastCamera = currentCamera;
+            hasLastCamera = true;
+        }
+        memcpy(previousCameraAllocations[currentFrame].mapped, &lastCamera, sizeof(PreviousCameraUniform));
+        lastCamera = currentCamera;
+
+        // Wavefront: 같은 preset / 같은 accumulation image, bounce별 kernel로 렌더
+        if (integratorMode == IntegratorMode::Wavefront && !svgfEnabled) {
+            LveWavefrontCamera camera{};
+            camera.position = cameraPos;
+            camera.forward = cameraFront;
+            camera.right = cameraRight;
+            camera.up = cameraUp;
+            camera.vfov = vfov;
+            camera.defocusAngle = defocusAngle;
+            camera.focusDist = focusDist;
+            camera.skyIntensity = skyIntensity;
+            camera.frameIndex = pushConstants.frameIndex;
+            camera.sampler = sampler->getType();
+
+            LveGpuProfiler::Scope traceScope{ gpuProfiler.get(), commandBuffer, traceScopeName };
+            wavefrontTracer->record(commandBuffer, currentFrame, descriptorSets[currentFrame], camera,
+                rayTracingPipeline->getPreset(rayTracingPipeline->getActivePreset()));
+            return;
+        }
+
+        // Adaptive: 지난 프레임까지의 moments → 이번 프레임 pixel별 sample 수 (총량은 preset spp 기준)
+        if (isAdaptiveActive()) {
+            pushConstants.flags |= CAMERA_FLAG_ADAPTIVE;
+            adaptiveSampler->record(commandBuffer, pushConstants.frameIndex == 0,
+                rayTracingPipeline->getPreset(rayTracingPipeline->getActivePreset()).samplesPerPixel, traceExtent);
+        }
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, rayTracingPipeline->getPipeline());
+        vkCmdBindDescriptorSets(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR,
+            rayTracingPipeline->getPipelineLayout(),
+            0, 1, &descriptorSets[currentFrame], 0, nullptr
+        );
+
+        vkCmdPushConstants(
+            commandBuffer,
+            rayTracingPipeline->getPipelineLayout(),
+            VK_SHADER_STAGE_RAYGEN_BIT_KHR,
+            0,
+            sizeof(CameraPushConstants),
+            &pushConstants
+        );
+
+        VkStridedDeviceAddressRegionKHR raygenRegion = rayTracingPipeline->getRaygenRegion();
+        VkStridedDeviceAddressRegionKHR missRegion = rayTracingPipeline->getMissRegion();
+        VkStridedDeviceAddressRegionKHR hitRegion = rayTracingPipeline->getHitRegion();
+        VkStridedDeviceAddressRegionKHR callableRegion = rayTracingPipeline->getCallableRegion();
+
+        // 이전 프레임 (다른 frame in flight)의 누적 결과를 읽기 전에 완료 대기
+        // + SVGF G-buffer는 이전 프레임 compute / copy가 다 읽은 뒤에 덮어씀
+        VkMemoryBarrier gBufferBarrier{};
+        gBufferBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        gBufferBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        gBufferBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        VkImageMemoryBarrier accumulationBarrier{};
+        accumulationBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        accumulationBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+        accumulationBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        accumulationBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        accumulationBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        accumulationBarrier.image = accumulationImage;
+        accumulationBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        accumulationBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        accumulationBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, 0, 1, &gBufferBarrier, 0, nullptr, 1, &accumulationBarrier);
+
+        LveGpuProfiler::Scope traceScope{ gpuProfiler.get(), commandBuffer, traceScopeName };
+        vkCmdTraceRaysKHR(
+            commandBuffer,
+            &raygenRegion,
+            &missRegion,
+            &hitRegion,
+            &callableRegion,
+            traceExtent.width,
+            traceExtent.height,
+            1
+        );
+    }
+
     void FirstAppRayTracing::drawFrame() {
         uint32_t imageIndex;
-        auto result = lveSwapChain.acquireNextImage(&imageIndex);
+        auto result = lveSwapChain->acquireNextImage(&imageIndex);
 
         if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
             throw std::runtime_error("failed to acquire swap chain image!");
         }
 
-        lveSwapChain.waitForImageInFlight(imageIndex);
+        lveSwapChain->waitForImageInFlight(imageIndex);
         // submitCommandBuffers 안에서 currentFrame이 증가하므로 그 전에 캡처
-        uint32_t currentFrame = static_cast<uint32_t>(lveSwapChain.getCurrentFrame());
+        uint32_t currentFrame = static_cast<uint32_t>(lveSwapChain->getCurrentFrame());
         // 매 프레임 Command Buffer 기록!
         vkResetCommandBuffer(commandBuffers[imageIndex], 0);
         recordCommandBuffer(commandBuffers[imageIndex], imageIndex, currentFrame);
 
-        result = lveSwapChain.submitCommandBuffers(&commandBuffers[imageIndex], &imageIndex);
+        result = lveSwapChain->submitCommandBuffers(&commandBuffers[imageIndex], &imageIndex);
         if (result != VK_SUCCESS) {
             throw std::runtime_error("failed to present swap chain image!");
         }
     }
 
+    void FirstAppRayTracing::createReadbackResources() {
+        // Headless: BGRA8 storage image, offline: RGBA32F accumulation image (HDR 그대로)
+        const VkDeviceSize bytesPerPixel = isOffline() ? 16 : 4;
+        const VkDeviceSize readbackSize = static_cast<VkDeviceSize>(renderExtent.width) * renderExtent.height * bytesPerPixel;
+
+        readbackFrames.resize(LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+        for (ReadbackFrame& readback : readbackFrames) {
+            lveDevice.createBuffer(
+                readbackSize,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                readback.buffer,
+                readback.allocation
+            );
+
+            // 처음 대기에서 막히지 않도록 signaled 상태로 생성
+            VkFenceCreateInfo fenceInfo{};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+            if (vkCreateFence(lveDevice.device(), &fenceInfo, nullptr, &readback.fence) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create readback fence!");
+            }
+        }
+    }
+
+    void FirstAppRayTracing::runHeadless() {
+        const uint32_t framesInFlight = LveSwapChain::MAX_FRAMES_IN_FLIGHT;
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t frame = 0; frame < options.headlessFrames; frame++) {
+            const uint32_t currentFrame = frame % framesInFlight;
+            ReadbackFrame& readback = readbackFrames[currentFrame];
+
+            // 이 slot의 이전 프레임이 끝났으면 저장 (GPU는 다른 slot 프레임을 계속 렌더)
+            vkWaitForFences(lveDevice.device(), 1, &readback.fence, VK_TRUE, UINT64_MAX);
+            writeReadback(currentFrame);
+            vkResetFences(lveDevice.device(), 1, &readback.fence);
+
+            VkCommandBuffer commandBuffer = commandBuffers[currentFrame];
+            vkResetCommandBuffer(commandBuffer, 0);
+            recordHeadlessCommandBuffer(commandBuffer, currentFrame);
+
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+
+            if (vkQueueSubmit(lveDevice.graphicsQueue(), 1, &submitInfo, readback.fence) != VK_SUCCESS) {
+                throw std::runtime_error("failed to submit headless command buffer!");
+            }
+            readback.pendingFrame = frame;
+        }
+
+        // 남은 프레임을 순서대로 저장
+        for (uint32_t i = 0; i < framesInFlight; i++) {
+            const uint32_t currentFrame = (options.headlessFrames + i) % framesInFlight;
+            vkWaitForFences(lveDevice.device(), 1, &readbackFrames[currentFrame].fence, VK_TRUE, UINT64_MAX);
+            writeReadback(currentFrame);
+        }
+
+        float totalMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "[headless] " << options.headlessFrames << " frames in " << totalMs << " ms" << std::endl;
+
+        vkDeviceWaitIdle(lveDevice.device());
+        reportGpuTimings();
+    }
+
+    void FirstAppRayTracing::recordHeadlessCommandBuffer(VkCommandBuffer commandBuffer, uint32_t currentFrame) {
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+            throw std::runtime_error("failed to begin recording command buffer!");
+        }
+
+        // 이 frame slot의 지난 결과 수집 (fence 대기 후라 WAIT 없이 읽힘)
+        gpuProfiler->beginFrame(commandBuffer, currentFrame);
+
+        recordTraceRays(commandBuffer, currentFrame);
+        if (svgfEnabled) {
+            svgfDenoiser->record(commandBuffer, currentFrame);
+        }
+
+        VkImage storageImage = storageImages[currentFrame];
+        uint32_t copyScope = gpuProfiler->beginScope(commandBuffer, "readback copy");
+
+        // Storage image → Transfer src
+        VkImageMemoryBarrier toTransfer{};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = storageImage;
+        toTransfer.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        toTransfer.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+        // Storage image → readback buffer (tightly packed BGRA8)
+        VkBufferImageCopy region{};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent = { renderExtent.width, renderExtent.height, 1 };
+
+        vkCmdCopyImageToBuffer(commandBuffer, storageImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            readbackFrames[currentFrame].buffer, 1, &region);
+
+        // Readback buffer → Host read
+        VkMemoryBarrier toHost{};
+        toHost.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &toHost, 0, nullptr, 0, nullptr);
+
+        // Storage image → General (다음 프레임용)
+        VkImageMemoryBarrier toGeneral = toTransfer;
+        toGeneral.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toGeneral.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        toGeneral.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        toGeneral.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &toGeneral);
+
+        gpuProfiler->endScope(commandBuffer, copyScope);
+
+        if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to record command buffer!");
+        }
+    }
+
+    void FirstAppRayTracing::writeReadback(uint32_t currentFrame) {
+        ReadbackFrame& readback = readbackFrames[currentFrame];
+        if (readback.pendingFrame < 0) return;
+
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "_%04lld.ppm", static_cast<long long>(readback.pendingFrame));
+        std::string path = options.outputPrefix + suffix;
+
+        writePPM(path, static_cast<const uint8_t*>(readback.allocation.mapped), renderExtent.width, renderExtent.height);
+        std::cout << "Wrote " << path << std::endl;
+
+        readback.pendingFrame = -1;
+    }
+
+    void FirstAppRayTracing::runOffline() {
+        // Tile은 서로 독립이어야 하므로 history가 필요한 경로는 끔 (wavefront는 tile offset 미지원)
+        svgfEnabled = false;
+        adaptiveEnabled = false;
+        sphereAnimationEnabled = false;
+        integratorMode = IntegratorMode::Megakernel;
+
+        const uint32_t framesInFlight = LveSwapChain::MAX_FRAMES_IN_FLIGHT;
+        const uint32_t tileWidth = renderExtent.width;
+        const uint32_t tileHeight = renderExtent.height;
+        const uint32_t tilesX = (options.offlineWidth + tileWidth - 1) / tileWidth;
+        const uint32_t tilesY = (options.offlineHeight + tileHeight - 1) / tileHeight;
+        const uint32_t tileCount = tilesX * tilesY;
+
+        // preset spp씩 누적하는 pass를 tile 하나의 command buffer에 연속 기록
+        const uint32_t presetSamples = rayTracingPipeline->getPreset(rayTracingPipeline->getActivePreset()).samplesPerPixel;
+        const uint32_t passes = std::max((options.offlineSamples + presetSamples - 1) / presetSamples, 1u);
+
+        const std::string path = options.outputPrefix + ".pfm";
+        LvePfmTileWriter writer{ path, options.offlineWidth, options.offlineHeight };
+        tileImageExtent = { options.offlineWidth, options.offlineHeight };
+
+        std::cout << "[offline] " << options.offlineWidth << "x" << options.offlineHeight << ", "
+            << tilesX << "x" << tilesY << " tiles of " << tileWidth << "x" << tileHeight << ", "
+            << passes * presetSamples << " spp (" << passes << " passes)" << std::endl;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t tile = 0; tile < tileCount; tile++) {
+            const uint32_t currentFrame = tile % framesInFlight;
+            ReadbackFrame& readback = readbackFrames[currentFrame];
+
+            // 이 slot의 이전 tile을 파일로 (GPU는 그동안 다른 slot의 tile을 렌더)
+            vkWaitForFences(lveDevice.device(), 1, &readback.fence, VK_TRUE, UINT64_MAX);
+            writeOfflineTile(currentFrame, writer);
+            vkResetFences(lveDevice.device(), 1, &readback.fence);
+
+            // 오른쪽 / 아래 끝 tile은 잘림
+            const uint32_t x = (tile % tilesX) * tileWidth;
+            const uint32_t y = (tile / tilesX) * tileHeight;
+            tileOffset = { static_cast<int32_t>(x), static_cast<int32_t>(y) };
+            traceExtent = { std::min(tileWidth, options.offlineWidth - x), std::min(tileHeight, options.offlineHeight - y) };
+            accumulatedFrames = 0;
+
+            VkCommandBuffer commandBuffer = commandBuffers[currentFrame];
+            vkResetCommandBuffer(commandBuffer, 0);
+            recordOfflineTile(commandBuffer, currentFrame, passes);
+
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+
+            if (vkQueueSubmit(lveDevice.graphicsQueue(), 1, &submitInfo, readback.fence) != VK_SUCCESS) {
+                throw std::runtime_error("failed to submit offline tile command buffer!");
+            }
+            readback.pendingFrame = tile;
+            readback.pendingTile = { tileOffset, traceExtent };
+        }
+
+        // 남은 tile을 순서대로 저장
+        for (uint32_t i = 0; i < framesInFlight; i++) {
+            const uint32_t currentFrame = (tileCount + i) % framesInFlight;
+            vkWaitForFences(lveDevice.device(), 1, &readbackFrames[currentFrame].fence, VK_TRUE, UINT64_MAX);
+            writeOfflineTile(currentFrame, writer);
+        }
+
+        float totalMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "[offline] " << tileCount << " tiles in " << totalMs << " ms ("
+            << totalMs / static_cast<float>(tileCount) << " ms/tile), wrote " << path << std::endl;
+
+        tileOffset = { 0, 0 };
+        tileImageExtent = { 0, 0 };
+        traceExtent = renderExtent;
+
+        vkDeviceWaitIdle(lveDevice.device());
+        reportGpuTimings();
+    }
+
+    void FirstAppRayTracing::recordOfflineTile(VkCommandBuffer commandBuffer, uint32_t currentFrame, uint32_t passes) {
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+            throw std::runtime_error("failed to begin recording command buffer!");
+        }
+
+        gpuProfiler->beginFrame(commandBuffer, currentFrame);
+
+        {
+            // pass마다 trace rays 구간도 기록되지만 query가 모자라면 앞쪽만 측정됨 → tile 전체 구간을 먼저 열어둠
+            LveGpuProfiler::Scope tileScope{ gpuProfiler.get(), commandBuffer, "offline tile" };
+
+            // 각 pass는 accumulationImage를 읽고 쓰므로 recordTraceRays 앞의 barrier로 순서 보장
+            for (uint32_t pass = 0; pass < passes; pass++) {
+                recordTraceRays(commandBuffer, currentFrame);
+            }
+        }
+
+        uint32_t copyScope = gpuProfiler->beginScope(commandBuffer, "readback copy");
+
+        // Accumulation image (running average, GENERAL 유지) → Transfer read
+        VkImageMemoryBarrier toTransfer{};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = accumulationImage;
+        toTransfer.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        toTransfer.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+        // 잘린 끝 tile은 traceExtent만 (tightly packed RGBA32F)
+        VkBufferImageCopy region{};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent = { traceExtent.width, traceExtent.height, 1 };
+
+        vkCmdCopyImageToBuffer(commandBuffer, accumulationImage, VK_IMAGE_LAYOUT_GENERAL,
+            readbackFrames[currentFrame].buffer, 1, &region);
+
+        // Readback buffer → Host read
+        // (다음 tile의 accumulation 쓰기는 recordTraceRays 앞 barrier의 TRANSFER src stage가 기다림)
+        VkMemoryBarrier toHost{};
+        toHost.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &toHost, 0, nullptr, 0, nullptr);
+
+        gpuProfiler->endScope(commandBuffer, copyScope);
+
+        if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to record command buffer!");
+        }
+    }
+
+    void FirstAppRayTracing::writeOfflineTile(uint32_t currentFrame, LvePfmTileWriter& writer) {
+        ReadbackFrame& readback = readbackFrames[currentFrame];
+        if (readback.pendingFrame < 0) return;
+
+        const VkRect2D& rect = readback.pendingTile;
+        writer.writeTile(static_cast<uint32_t>(rect.offset.x), static_cast<uint32_t>(rect.offset.y),
+            rect.extent.width, rect.extent.height, static_cast<const float*>(readback.allocation.mapped), rect.extent.width);
+
+        readback.pendingFrame = -1;
+    }
+
 } // namespace lve
\ No newline at end of file
@@ -4,7 +4,16 @@
 #include "lve_device.h"
 #include "lve_swap_chain.h"
 #include "lve_acceleration_structure.h"
+#include "lve_adaptive_sampler.h"
+#include "lve_camera_path.h"
+#include "lve_gpu_profiler.h"
+#include "lve_mesh_library.h"
+#include "lve_pfm_writer.h"
 #include "lve_ray_tracing_pipeline.h"
+#include "lve_resolution_controller.h"
+#include "lve_sampler.h"
+#include "lve_svgf_denoiser.h"
+#include "lve_wavefront_tracer.h"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -12,6 +21,7 @@
 #include <gtc/matrix_transform.hpp>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace lve {
@@ -25,15 +35,113 @@ namespace lve {
         float vfov;                        // 4 bytes
         float defocus_angle;               // 4 bytes
         float focus_dist;                  // 4 bytes
-        float padding;                     // 4 bytes
-    };  // 총 80 bytes
+        uint32_t frameIndex;               // 4 bytes (누적 프레임 수, sample index 시작)
+        uint32_t flags;                    // 4 bytes (CAMERA_FLAG_*)
+        float skyIntensity;                // 4 bytes (miss shader 하늘색 배율)
+        uint32_t samplerType;              // 4 bytes (LveSamplerType)
+        uint32_t tileOffsetX;              // 4 bytes (offline tile의 이미지 내 위치, 평소 0)
+        uint32_t tileOffsetY;              // 4 bytes
+        uint32_t imageWidth;               // 4 bytes (카메라가 담는 전체 이미지, 평소 trace 해상도)
+        uint32_t imageHeight;              // 4 bytes
+    };  // 총 112 bytes (끝 padding 4)
+
+    constexpr uint32_t CAMERA_FLAG_SVGF = 1u;      // raygen: 1 spp + G-buffer 출력, 누적 안 함
+    constexpr uint32_t CAMERA_FLAG_ADAPTIVE = 2u;  // raygen: pixel별 sample 수를 budget map에서 읽음
+
+    // 이전 프레임 카메라 (raygen binding 8, motion vector 계산용, std140)
+    struct PreviousCameraUniform {
+        glm::vec4 position;  // w = vfov
+        glm::vec4 forward;
+        glm::vec4 right;
+        glm::vec4 up;
+    };
+
+    enum class SceneType {
+        OneWeekend,   // 하늘이 유일한 광원
+        SmallLights,  // 같은 장면 + 작은 발광 구, 어두운 하늘 (NEE가 없으면 수렴이 매우 느림)
+        Stress        // 작은 구 1600개, material 고르게 섞음 + 발광 구 (divergence / path 길이 편차가 큼)
+    };
+
+    enum class IntegratorMode {
+        Megakernel,  // raygen.rgen 하나가 bounce loop 전체 (I 키로 전환)
+        Wavefront    // bounce마다 trace / sort / shade kernel (LveWavefrontTracer), SVGF 켜지면 megakernel
+    };
+
+    enum class DenoiserMode {
+        None,  // progressive accumulation
+        Svgf   // 1 spp + SVGF compute passes
+    };
+
+    // 실행 옵션 (main에서 command line으로 설정)
+    struct AppOptions {
+        SphereGeometryMode geometryMode = SphereGeometryMode::Procedural;
+        SceneType scene = SceneType::OneWeekend;
+        std::string sceneFile;    // 비어있지 않으면 binary scene (.lvscene)을 mmap으로 로드, scene은 무시
+        std::string exportScene;  // 비어있지 않으면 만든 장면을 .lvscene으로 저장 (생성 장면 → 파일)
+        DenoiserMode denoiser = DenoiserMode::None;
+        std::string qualityPreset = "balanced";  // interactive / balanced / final (1, 2, 3 키로 전환)
+        LveHitGroupMode hitGroupMode = LveHitGroupMode::Specialized;
+        IntegratorMode integrator = IntegratorMode::Megakernel;
+        LveSamplerType sampler = LveSamplerType::Sobol;  // N 키로 순환
+        LveSvgfSettings svgfSettings{};
+        bool adaptive = false;  // variance 기반 pixel별 sample 수 (V 키로 전환, megakernel + 누적 모드만)
+        LveAdaptiveSettings adaptiveSettings{};
+
+        // GPU frame time 목표에 맞춰 trace 해상도 조절 (G 키로 전환, 창 모드 + megakernel 누적 모드만)
+        bool dynamicResolution = false;
+        LveResolutionSettings resolutionSettings{};
+
+        // Headless: window / swapchain 없이 N 프레임 렌더 후 PPM으로 저장
+        bool headless = false;
+        uint32_t headlessFrames = 1;
+        std::string outputPrefix = "frame";
+
+        // Offline: offlineWidth × offlineHeight를 tileSize 단위로 나눠 offlineSamples spp로 렌더, PFM으로 저장
+        // (tile 하나가 한 번의 submit - driver timeout (TDR)이 나면 tileSize를 줄임)
+        uint32_t offlineWidth = 0;  // 0이면 offline 아님
+        uint32_t offlineHeight = 0;
+        uint32_t tileSize = 512;
+        uint32_t offlineSamples = 1024;
+
+        // 종료 시 GPU 구간 통계를 CSV로 저장 (비어있으면 콘솔 출력만)
+        std::string profileCsvPath;
+
+        // Branching / specialized hit group을 같은 장면, 같은 카메라로 N 프레임씩 렌더해 trace rays 시간 비교
+        bool hitGroupBenchmark = false;
+        uint32_t benchmarkFrames = 256;
+
+        // Megakernel / wavefront를 같은 장면, 같은 카메라로 N 프레임씩 렌더해 비교
+        bool integratorBenchmark = false;
+
+        // 카메라 경로를 재생하며 warm-up 후 N (benchmarkFrames) 프레임 측정, 프레임별 결과를 JSON으로 (headless 가능)
+        bool pathBenchmark = false;
+        std::string cameraPathFile;  // 비어있으면 시작 카메라에서 원점을 도는 orbit
+        std::string benchmarkJsonPath = "benchmark.json";
+        uint32_t warmupFrames = 16;  // 모든 benchmark 공통
+
+        // 창 모드에서 매 프레임 카메라를 기록해 종료 시 저장 (cameraPathFile로 재생)
+        std::string recordPathFile;
+
+        // Stress 장면 small sphere 격자 한 변 개수 (총 stressGridSize² 개)
+        uint32_t stressGridSize = 40;
+
+        // OBJ / glTF mesh 파일 (여러 개 가능), 장면 앞쪽 meshGridSize² 칸에 파일을 돌려가며 배치 (megakernel만)
+        std::vector<std::string> meshFiles;
+        uint32_t meshGridSize = 3;
+
+        // Acceleration structure disk 캐시 (비어있으면 끔). 같은 장면 / GPU / 드라이버면 다음 실행에서 build 생략
+        std::string accelerationCachePath;
+
+        // BLAS를 CPU worker thread에서 build (accelerationStructureHostCommands 필요, 없으면 device build)
+        bool hostAccelerationBuilds = false;
+    };
 
     class FirstAppRayTracing {
     public:
         static constexpr int WIDTH = 1200;
         static constexpr int HEIGHT = 675;
 
-        FirstAppRayTracing();
+        explicit FirstAppRayTracing(const AppOptions& options = AppOptions{});
         ~FirstAppRayTracing();
 
         FirstAppRayTracing(const FirstAppRayTracing&) = delete;
@@ -43,12 +151,52 @@ namespace lve {
 
     private:
         void createOneWeekendFinalScene();
+        void createSmallLightsScene();
+        void createStressScene();
+        void loadSceneFile(const std::string& path);
+        void addMeshInstances();
         void createStorageImage();
+        void createPreviousCameraBuffers();
         void createDescriptorPool();
         void createDescriptorSets();
+        void writeDescriptorSets();
         void createCommandBuffers();
         void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex, uint32_t currentFrame);
+        void recordTraceRays(VkCommandBuffer commandBuffer, uint32_t currentFrame);
         void drawFrame();
+        void reportGpuTimings();
+        bool isAdaptiveActive() const;           // SVGF / wavefront에서는 uniform spp
+        bool isDynamicResolutionActive() const;  // SVGF / wavefront에서는 전체 해상도
+        void updateDynamicResolution();          // drawFrame 전, 최신 "gpu frame" 측정으로 traceExtent 갱신
+
+        std::unique_ptr<LveRayTracingPipeline> createRayTracingPipeline(LveHitGroupMode mode);
+
+        // Benchmark: 현재 설정으로 warm-up 후 N 프레임, "trace rays [label]" 구간 통계
+        struct BenchmarkResult {
+            std::string label;
+            float wallMsPerFrame = 0.0f;
+            LveGpuProfiler::ScopeStatistics traceRays{};
+        };
+        BenchmarkResult runBenchmarkPass(const std::string& label, const std::vector<VkFence>& fences);
+        void printBenchmarkResults(const std::string& title, const std::vector<BenchmarkResult>& results);
+        void runHitGroupBenchmark();
+        void runIntegratorBenchmark();
+        void runPathBenchmark();
+
+        // Headless: storage image → readback buffer → 파일
+        void runHeadless();
+        void createReadbackResources();
+        void recordHeadlessCommandBuffer(VkCommandBuffer commandBuffer, uint32_t currentFrame);
+        void writeReadback(uint32_t currentFrame);
+
+        // Offline: tile별 accumulation image → readback ring → PFM (전체 framebuffer는 host에 두지 않음)
+        bool isOffline() const { return options.offlineWidth > 0 && options.offlineHeight > 0; }
+        void runOffline();
+        void recordOfflineTile(VkCommandBuffer commandBuffer, uint32_t currentFrame, uint32_t passes);
+        void writeOfflineTile(uint32_t currentFrame, LvePfmTileWriter& writer);
+
+        // Sphere animation (TLAS refit 경로)
+        void animateSpheres(float time);
 
         // Camera system
         void initCamera();
@@ -59,22 +207,76 @@ namespace lve {
         static void mouseCallback(GLFWwindow* window, double xpos, double ypos);
         static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 
-        LveWindow lveWindow{ WIDTH, HEIGHT, "Ray Tracing - WASD Move, Mouse Look, ESC Release" };
-        LveDevice lveDevice{ lveWindow };
-        LveSwapChain lveSwapChain{ lveWindow, lveDevice };
+        AppOptions options;
+
+        // headless면 window / swapchain은 nullptr
+        std::unique_ptr<LveWindow> lveWindow;
+        LveDevice lveDevice;
+        std::unique_ptr<LveSwapChain> lveSwapChain;
+        VkExtent2D renderExtent{};  // storage / accumulation image 크기 (= swapchain)
+        VkExtent2D traceExtent{};   // 이번 프레임 trace 해상도 (dynamic resolution이 아니면 renderExtent)
+
+        // Offline tile: 전체 이미지 안에서 traceExtent 영역의 위치 (평소 0, 0 / traceExtent)
+        VkOffset2D tileOffset{ 0, 0 };
+        VkExtent2D tileImageExtent{ 0, 0 };  // 0이면 traceExtent
 
+        std::unique_ptr<LveGpuProfiler> gpuProfiler;
+        LveMeshLibrary meshLibrary;  // accelerationStructure가 참조 (먼저 선언 → 나중에 파괴)
         std::unique_ptr<LveAccelerationStructure> accelerationStructure;
         std::unique_ptr<LveRayTracingPipeline> rayTracingPipeline;
+        LveHitGroupMode hitGroupMode = LveHitGroupMode::Specialized;  // rayTracingPipeline의 모드
+        std::string traceScopeName = "trace rays";                    // profiler 구간 이름
+
+        std::unique_ptr<LveSampler> sampler;
+        std::unique_ptr<LveWavefrontTracer> wavefrontTracer;
+        IntegratorMode integratorMode = IntegratorMode::Megakernel;
 
         // Storage Image (per frame in flight)
         std::vector<VkImage> storageImages;
-        std::vector<VkDeviceMemory> storageImageMemories;
+        std::vector<LveAllocation> storageImageAllocations;
         std::vector<VkImageView> storageImageViews;
 
+        // Accumulation Image (RGBA32F, 모든 frame이 공유 - 이전 프레임 결과에 누적)
+        VkImage accumulationImage = VK_NULL_HANDLE;
+        LveAllocation accumulationImageAllocation{};
+        VkImageView accumulationImageView = VK_NULL_HANDLE;
+
+        // SVGF (descriptor binding이 항상 필요하므로 꺼져 있어도 생성)
+        std::unique_ptr<LveSvgfDenoiser> svgfDenoiser;
+        bool svgfEnabled = false;
+        uint32_t svgfFrameCounter = 0;  // RNG seed (reset 없음)
+
+        // Adaptive sampling (descriptor binding이 항상 필요하므로 꺼져 있어도 생성)
+        std::unique_ptr<LveAdaptiveSampler> adaptiveSampler;
+        bool adaptiveEnabled = false;
+
+        // Dynamic resolution: image는 renderExtent로 만들고 왼쪽 위 traceExtent만 trace, present에서 blit
+        LveResolutionController resolutionController;
+        bool dynamicResolutionEnabled = false;
+        uint64_t lastFrameTimeSample = 0;           // 이미 controller에 넘긴 profiler sample 번호
+        bool presentBlitSupported = false;
+        VkFilter presentBlitFilter = VK_FILTER_LINEAR;
+
+        // 이전 프레임 카메라 uniform buffer (frame in flight별, persistent map)
+        std::vector<VkBuffer> previousCameraBuffers;
+        std::vector<LveAllocation> previousCameraAllocations;
+        PreviousCameraUniform lastCamera{};
+        bool hasLastCamera = false;
+
         VkDescriptorPool descriptorPool;
         std::vector<VkDescriptorSet> descriptorSets;
         std::vector<VkCommandBuffer> commandBuffers;
 
+        // Headless readback (frame in flight별, fence로 완료 확인 후 파일 저장)
+        struct ReadbackFrame {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            LveAllocation allocation{};
+            VkFence fence = VK_NULL_HANDLE;
+            int64_t pendingFrame = -1;  // 아직 저장 안 한 프레임 번호
+            VkRect2D pendingTile{};     // offline: pendingFrame tile의 이미지 내 영역
+        };
+        std::vector<ReadbackFrame> readbackFrames;
+
         // Camera state
         glm::vec3 cameraPos;
         glm::vec3 cameraFront;
@@ -86,6 +288,7 @@ namespace lve {
         float mouseSensitivity;
         float vfov;
         float defocusAngle;
+        float skyIntensity = 1.0f;
         float focusDist;
 
         // Mouse state
@@ -96,6 +299,19 @@ namespace lve {
         // Timing
         float lastFrameTime;
 
+        // --record-path: 창 모드에서 매 프레임 카메라 (종료 시 저장)
+        LveCameraPath recordedPath;
+
+        // Progressive accumulation (카메라가 움직이면 0으로 reset)
+        uint32_t accumulatedFrames = 0;
+        glm::vec3 accumulationCameraPos{ 0.0f };
+        float accumulationYaw = 0.0f;
+        float accumulationPitch = 0.0f;
+
+        // Animation state
+        bool sphereAnimationEnabled = false;
+        std::vector<glm::vec3> animationBaseCenters;
+
         // Ray tracing function pointer
         PFN_vkCmdTraceRaysKHR vkCmdTraceRaysKHR;
 
@@ -1,12 +1,20 @@
 ﻿#include "lve_acceleration_structure.h"
+#include "lve_hash.h"
+#include "lve_staging_ring.h"
 #include <stdexcept>
 #include <iostream>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <cassert>
+#include <thread>
 
 namespace lve {
 
-    LveAccelerationStructure::LveAccelerationStructure(LveDevice& device) : lveDevice{ device } {
+    LveAccelerationStructure::LveAccelerationStructure(
+        LveDevice& device, uint32_t framesInFlight, SphereGeometryMode geometryMode)
+        : lveDevice{ device }, framesInFlight{ framesInFlight }, geometryMode{ geometryMode } {
         // Ray tracing function pointer load
         vkGetBufferDeviceAddressKHR = reinterpret_cast<PFN_vkGetBufferDeviceAddressKHR>(
             vkGetDeviceProcAddr(lveDevice.device(), "vkGetBufferDeviceAddressKHR"));
@@ -20,50 +28,88 @@ namespace lve {
             vkGetDeviceProcAddr(lveDevice.device(), "vkCmdBuildAccelerationStructuresKHR"));
         vkGetAccelerationStructureDeviceAddressKHR = reinterpret_cast<PFN_vkGetAccelerationStructureDeviceAddressKHR>(
             vkGetDeviceProcAddr(lveDevice.device(), "vkGetAccelerationStructureDeviceAddressKHR"));
+        vkCmdWriteAccelerationStructuresPropertiesKHR = reinterpret_cast<PFN_vkCmdWriteAccelerationStructuresPropertiesKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkCmdWriteAccelerationStructuresPropertiesKHR"));
+        vkCmdCopyAccelerationStructureKHR = reinterpret_cast<PFN_vkCmdCopyAccelerationStructureKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkCmdCopyAccelerationStructureKHR"));
+        vkCmdCopyAccelerationStructureToMemoryKHR = reinterpret_cast<PFN_vkCmdCopyAccelerationStructureToMemoryKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkCmdCopyAccelerationStructureToMemoryKHR"));
+        vkCmdCopyMemoryToAccelerationStructureKHR = reinterpret_cast<PFN_vkCmdCopyMemoryToAccelerationStructureKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkCmdCopyMemoryToAccelerationStructureKHR"));
+        vkGetDeviceAccelerationStructureCompatibilityKHR = reinterpret_cast<PFN_vkGetDeviceAccelerationStructureCompatibilityKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkGetDeviceAccelerationStructureCompatibilityKHR"));
+
+        // Host build (accelerationStructureHostCommands 지원 시에만 사용)
+        vkBuildAccelerationStructuresKHR = reinterpret_cast<PFN_vkBuildAccelerationStructuresKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkBuildAccelerationStructuresKHR"));
+        vkWriteAccelerationStructuresPropertiesKHR = reinterpret_cast<PFN_vkWriteAccelerationStructuresPropertiesKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkWriteAccelerationStructuresPropertiesKHR"));
+        vkCreateDeferredOperationKHR = reinterpret_cast<PFN_vkCreateDeferredOperationKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkCreateDeferredOperationKHR"));
+        vkDestroyDeferredOperationKHR = reinterpret_cast<PFN_vkDestroyDeferredOperationKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkDestroyDeferredOperationKHR"));
+        vkGetDeferredOperationMaxConcurrencyKHR = reinterpret_cast<PFN_vkGetDeferredOperationMaxConcurrencyKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkGetDeferredOperationMaxConcurrencyKHR"));
+        vkDeferredOperationJoinKHR = reinterpret_cast<PFN_vkDeferredOperationJoinKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkDeferredOperationJoinKHR"));
+        vkGetDeferredOperationResultKHR = reinterpret_cast<PFN_vkGetDeferredOperationResultKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkGetDeferredOperationResultKHR"));
+
+        // Batch build의 scratch 영역 offset 정렬 + disk 캐시 key의 driver / device UUID
+        VkPhysicalDeviceIDProperties idProperties{};
+        idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+        VkPhysicalDeviceAccelerationStructurePropertiesKHR asProperties{};
+        asProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR;
+        asProperties.pNext = &idProperties;
+        VkPhysicalDeviceProperties2 deviceProperties{};
+        deviceProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        deviceProperties.pNext = &asProperties;
+        vkGetPhysicalDeviceProperties2(lveDevice.getPhysicalDevice(), &deviceProperties);
+        scratchOffsetAlignment = std::max<VkDeviceSize>(asProperties.minAccelerationStructureScratchOffsetAlignment, 1);
+        memcpy(cacheKey.driverUUID, idProperties.driverUUID, VK_UUID_SIZE);
+        memcpy(cacheKey.deviceUUID, idProperties.deviceUUID, VK_UUID_SIZE);
+
+        // Compacted size query (batch build는 ensureCompactionQueries로 늘림)
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+        queryPoolInfo.queryCount = 1;
+
+        if (vkCreateQueryPool(lveDevice.device(), &queryPoolInfo, nullptr, &compactionQueryPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compaction query pool!");
+        }
     }
 
     LveAccelerationStructure::~LveAccelerationStructure() {
-        // Cleaning sphere info buffer
-        if (sphereInfoBuffer != VK_NULL_HANDLE) {
-            vkDestroyBuffer(lveDevice.device(), sphereInfoBuffer, nullptr);
-        }
-        if (sphereInfoMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(lveDevice.device(), sphereInfoMemory, nullptr);
-        }
+        // Cleaning per-frame instance / sphere info buffers
+        destroyInstanceBuffers();
 
         // Cleaning TLAS
-        if (topLevelAS != VK_NULL_HANDLE) {
-            vkDestroyAccelerationStructureKHR(lveDevice.device(), topLevelAS, nullptr);
-        }
-        if (topLevelASBuffer != VK_NULL_HANDLE) {
-            vkDestroyBuffer(lveDevice.device(), topLevelASBuffer, nullptr);
-        }
-        if (topLevelASMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(lveDevice.device(), topLevelASMemory, nullptr);
+        destroyTopLevelAS();
+
+        if (compactionQueryPool != VK_NULL_HANDLE) {
+            vkDestroyQueryPool(lveDevice.device(), compactionQueryPool, nullptr);
         }
 
         // Cleaning unit sphere BLAS (하나만!)
         if (unitSphereMesh.bottomLevelAS != VK_NULL_HANDLE) {
             vkDestroyAccelerationStructureKHR(lveDevice.device(), unitSphereMesh.bottomLevelAS, nullptr);
         }
-        if (unitSphereMesh.bottomLevelASBuffer != VK_NULL_HANDLE) {
-            vkDestroyBuffer(lveDevice.device(), unitSphereMesh.bottomLevelASBuffer, nullptr);
-        }
-        if (unitSphereMesh.bottomLevelASMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(lveDevice.device(), unitSphereMesh.bottomLevelASMemory, nullptr);
-        }
-        if (unitSphereMesh.vertexBuffer != VK_NULL_HANDLE) {
-            vkDestroyBuffer(lveDevice.device(), unitSphereMesh.vertexBuffer, nullptr);
-        }
-        if (unitSphereMesh.vertexBufferMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(lveDevice.device(), unitSphereMesh.vertexBufferMemory, nullptr);
-        }
-        if (unitSphereMesh.indexBuffer != VK_NULL_HANDLE) {
-            vkDestroyBuffer(lveDevice.device(), unitSphereMesh.indexBuffer, nullptr);
-        }
-        if (unitSphereMesh.indexBufferMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(lveDevice.device(), unitSphereMesh.indexBufferMemory, nullptr);
+        lveDevice.destroyBuffer(unitSphereMesh.bottomLevelASBuffer, unitSphereMesh.bottomLevelASAllocation);
+        lveDevice.destroyBuffer(unitSphereMesh.vertexBuffer, unitSphereMesh.vertexBufferAllocation);
+        lveDevice.destroyBuffer(unitSphereMesh.indexBuffer, unitSphereMesh.indexBufferAllocation);
+        lveDevice.destroyBuffer(unitSphereMesh.aabbBuffer, unitSphereMesh.aabbBufferAllocation);
+
+        // Cleaning mesh BLAS / buffers
+        for (MeshBlas& mesh : meshBlases) {
+            if (mesh.bottomLevelAS != VK_NULL_HANDLE) {
+                vkDestroyAccelerationStructureKHR(lveDevice.device(), mesh.bottomLevelAS, nullptr);
+            }
+            lveDevice.destroyBuffer(mesh.bottomLevelASBuffer, mesh.bottomLevelASAllocation);
+            lveDevice.destroyBuffer(mesh.vertexBuffer, mesh.vertexBufferAllocation);
+            lveDevice.destroyBuffer(mesh.indexBuffer, mesh.indexBufferAllocation);
         }
+        lveDevice.destroyBuffer(meshTableBuffer, meshTableAllocation);
     }
 
     void LveAccelerationStructure::addSphereMesh(
@@ -82,11 +128,105 @@ namespace lve {
         info.color = color;
         info.materialType = materialType;
         info.materialParam = materialParam;
+        info.meshId = 0;
         info.padding[0] = 0.0f;
         info.padding[1] = 0.0f;
-        info.padding[2] = 0.0f;
 
+        if (std::abs(materialType - MATERIAL_EMISSIVE) < 0.1f) {
+            lightIndices.push_back(static_cast<uint32_t>(sphereInfos.size()));
+        }
+
+        sphereInfos.push_back(info);
+        instanceVersion++;
+    }
+
+    void LveAccelerationStructure::addEmissiveSphere(
+        const glm::vec3& center, const glm::vec3& color, float radius, float intensity) {
+        addSphereMesh(center, color, radius, MATERIAL_EMISSIVE, intensity);
+    }
+
+    void LveAccelerationStructure::addSpheres(
+        const SphereInfo* spheres, uint32_t count, const uint32_t* lights, uint32_t lightCount) {
+        const uint32_t base = static_cast<uint32_t>(sphereInfos.size());
+
+        sphereInfos.insert(sphereInfos.end(), spheres, spheres + count);
+        lightIndices.reserve(lightIndices.size() + lightCount);
+        for (uint32_t i = 0; i < lightCount; i++) {
+            lightIndices.push_back(base + lights[i]);
+        }
+        instanceVersion++;
+    }
+
+    uint32_t LveAccelerationStructure::addMeshInstance(
+        LveMeshHandle mesh, const glm::mat4& transform, const glm::vec3& color, float materialType, float materialParam) {
+        if (!meshLibrary) {
+            throw std::runtime_error("addMeshInstance needs a mesh library!");
+        }
+        const LveMesh& meshData = meshLibrary->getMesh(mesh);
+        if (unitSphereCreated && mesh > meshBlases.size()) {
+            throw std::runtime_error("new meshes need buildAccelerationStructures before they can be instanced!");
+        }
+
+        // Bounding sphere: 원점 기준 반지름 × 가장 큰 축 scale (refit 이동량 추정용)
+        const float maxScale = std::max({ glm::length(glm::vec3(transform[0])),
+            glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2])) });
+
+        SphereInfo info{};
+        info.center = glm::vec3(transform[3]);
+        info.radius = meshData.boundingRadius * maxScale;
+        info.color = color;
+        info.materialType = materialType;
+        info.materialParam = materialParam;
+        info.meshId = mesh;
+
+        const uint32_t index = static_cast<uint32_t>(sphereInfos.size());
+        meshTransforms[index] = transform;
         sphereInfos.push_back(info);
+        instanceVersion++;
+        return index;
+    }
+
+    void LveAccelerationStructure::setSphereTransform(uint32_t index, const glm::vec3& center, float radius) {
+        if (index >= sphereInfos.size()) {
+            throw std::runtime_error("Sphere index out of range!");
+        }
+
+        SphereInfo& info = sphereInfos[index];
+        auto meshTransform = meshTransforms.find(index);
+        if (meshTransform != meshTransforms.end()) {
+            glm::mat4& transform = meshTransform->second;
+            const float scale = radius / std::max(info.radius, 1e-6f);
+            transform[0] *= scale;
+            transform[1] *= scale;
+            transform[2] *= scale;
+            transform[3] = glm::vec4(center, 1.0f);
+        }
+        info.center = center;
+        info.radius = radius;
+
+        // BVH 품질 저하 추정 (빌드 이후 이동량을 반지름 단위로)
+        if (index < displacementRatios.size()) {
+            float ratio = glm::length(center - buildCenters[index]) / std::max(radius, 1e-4f);
+            displacementSum += ratio - displacementRatios[index];
+            displacementRatios[index] = ratio;
+        }
+
+        markDirty(index);
+        instanceVersion++;
+    }
+
+    void LveAccelerationStructure::markDirty(uint32_t index) {
+        if (index >= dirtyFrameMask.size()) {
+            return;  // 아직 GPU 버퍼에 없는 인스턴스 (count 변경 시 전체 갱신)
+        }
+
+        for (uint32_t frame = 0; frame < framesInFlight; frame++) {
+            uint32_t bit = 1u << frame;
+            if ((dirtyFrameMask[index] & bit) == 0) {
+                dirtyFrameMask[index] |= bit;
+                frameResources[frame].pendingDirty.push_back(index);
+            }
+        }
     }
 
     // 단위 구 생성 (원점, 반지름 1)
@@ -148,6 +288,22 @@ namespace lve {
         return mesh;
     }
 
+    // 단위 구 AABB (원점, 반지름 1) - 교차 판정은 intersection shader가 담당
+    MeshData LveAccelerationStructure::createSphereAabbData() {
+        MeshData mesh;
+
+        VkAabbPositionsKHR aabb{};
+        aabb.minX = -1.0f;
+        aabb.minY = -1.0f;
+        aabb.minZ = -1.0f;
+        aabb.maxX = 1.0f;
+        aabb.maxY = 1.0f;
+        aabb.maxZ = 1.0f;
+        mesh.aabbs.push_back(aabb);
+
+        return mesh;
+    }
+
     void LveAccelerationStructure::buildAccelerationStructures() {
         if (sphereInfos.empty()) {
             throw std::runtime_error("No spheres added!");
@@ -156,320 +312,1346 @@ namespace lve {
         std::cout << "Building optimized acceleration structures..." << std::endl;
         std::cout << "Sphere count: " << sphereInfos.size() << std::endl;
 
-        // 1. 단위 구 BLAS 하나만 생성 (처음 한 번만)
-        if (!unitSphereCreated) {
+        // 1. BLAS: 단위 구 (처음 한 번만) + 새로 추가된 unique mesh (instance 수와 무관하게 mesh마다 하나)
+        //    요청을 모아 scratch arena 하나, submit 하나로 build
+        std::vector<BlasBuildRequest> blasBuilds;
+        const bool createUnitSphere = !unitSphereCreated;
+        if (createUnitSphere) {
             std::cout << "Creating unit sphere BLAS (single instance)..." << std::endl;
 
-            // 고품질 단위 구 (모든 구가 공유)
-            unitSphereMesh = createSphereMeshData(32, 16);
+            if (geometryMode == SphereGeometryMode::Procedural) {
+                // AABB 하나 + intersection shader (vertex/index buffer 없음)
+                unitSphereMesh = createSphereAabbData();
+                std::cout << "Unit sphere geometry: procedural AABB" << std::endl;
+            }
+            else {
+                // 고품질 단위 구 (모든 구가 공유)
+                unitSphereMesh = createSphereMeshData(32, 16);
 
-            std::cout << "Unit sphere vertices: " << unitSphereMesh.vertices.size() << std::endl;
-            std::cout << "Unit sphere indices: " << unitSphereMesh.indices.size() << std::endl;
+                std::cout << "Unit sphere geometry: triangles" << std::endl;
+                std::cout << "Unit sphere vertices: " << unitSphereMesh.vertices.size() << std::endl;
+                std::cout << "Unit sphere indices: " << unitSphereMesh.indices.size() << std::endl;
+            }
 
             uploadMeshToGPU(unitSphereMesh);
-            createBottomLevelAS(unitSphereMesh);
-            unitSphereCreated = true;
+            blasBuilds.push_back(makeUnitSphereBuild(unitSphereMesh));
+        }
+        const uint32_t firstNewMesh = static_cast<uint32_t>(meshBlases.size());
+        if (meshLibrary && firstNewMesh < meshLibrary->getMeshCount()) {
+            appendMeshBuilds(blasBuilds);
+        }
+
+        // Disk 캐시 (첫 build만): 장면 / device / driver가 같으면 build 대신 deserialize
+        const bool useCache = createUnitSphere && !cachePath.empty();
+        const uint64_t sceneHash = useCache ? computeSceneHash() : 0;
+        const bool fromCache = useCache && readCache(sceneHash, blasBuilds.size());
+        if (fromCache) {
+            deserializeBottomLevelAS(blasBuilds);
+        }
+        else if (hostBuilds) {
+            buildBottomLevelASBatchOnHost(blasBuilds);
+        }
+        else {
+            buildBottomLevelASBatch(blasBuilds);
+        }
 
+        if (createUnitSphere) {
+            finishUnitSphereBlas(blasBuilds.front());
+            unitSphereCreated = true;
             std::cout << "Unit sphere BLAS created!" << std::endl;
         }
+        if (meshBlases.size() > firstNewMesh) {
+            finishMeshBlases(firstNewMesh, blasBuilds.data() + (createUnitSphere ? 1 : 0));
+            createMeshTable();
+        }
+        else if (meshTableBuffer == VK_NULL_HANDLE) {
+            createMeshTable();
+        }
+
+        // 재빌드 시 이전 TLAS / 버퍼 정리
+        destroyInstanceBuffers();
+        destroyTopLevelAS();
 
-        // 2. SphereInfo 버퍼 생성
-        createSphereInfoBuffer();
+        // 2. Frame별 instance / SphereInfo 버퍼 생성 (persistently mapped)
+        createInstanceBuffers(static_cast<uint32_t>(sphereInfos.size()));
 
-        // 3. TLAS 생성 (Transform으로 인스턴싱)
-        createTopLevelAS();
+        // 3. TLAS 생성 (Transform으로 인스턴싱, refit 가능하도록 ALLOW_UPDATE)
+        if (fromCache) {
+            deserializeTopLevelAS();
+        }
+        else {
+            createTopLevelAS();
+            if (useCache) {
+                writeCache(sceneHash, blasBuilds);
+            }
+        }
 
         std::cout << "Acceleration structures built successfully!" << std::endl;
-        std::cout << "BLAS count: 1 (optimized from " << sphereInfos.size() << ")" << std::endl;
-        std::cout << "TLAS instances: " << sphereInfos.size() << std::endl;
+        std::cout << "BLAS count: " << 1 + meshBlases.size() << " (optimized from " << sphereInfos.size() << ")" << std::endl;
+        std::cout << "TLAS instances: " << sphereInfos.size() << " (" << meshTransforms.size() << " meshes)" << std::endl;
+        std::cout << "Emissive spheres (NEE lights): " << lightIndices.size() << std::endl;
+
+        printMemoryReport();
     }
 
     void LveAccelerationStructure::uploadMeshToGPU(MeshData& mesh) {
-        // Vertex Buffer
-        VkDeviceSize vertexBufferSize = sizeof(Vertex) * mesh.vertices.size();
+        // Staging ring에 모아서 한 번에 submit (buffer마다 vkQueueWaitIdle 하지 않음)
+        LveStagingRing& stagingRing = lveDevice.getStagingRing();
+
+        // Procedural: AABB Buffer만
+        if (!mesh.aabbs.empty()) {
+            VkDeviceSize aabbBufferSize = sizeof(VkAabbPositionsKHR) * mesh.aabbs.size();
+
+            lveDevice.createBuffer(
+                aabbBufferSize,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+                VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                mesh.aabbBuffer,
+                mesh.aabbBufferAllocation
+            );
+
+            stagingRing.uploadBuffer(mesh.aabbs.data(), aabbBufferSize, mesh.aabbBuffer);
+        }
+        else {
+            // Vertex Buffer
+            VkDeviceSize vertexBufferSize = sizeof(Vertex) * mesh.vertices.size();
+
+            lveDevice.createBuffer(
+                vertexBufferSize,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+                VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                mesh.vertexBuffer,
+                mesh.vertexBufferAllocation
+            );
+
+            stagingRing.uploadBuffer(mesh.vertices.data(), vertexBufferSize, mesh.vertexBuffer);
+
+            // Index Buffer
+            VkDeviceSize indexBufferSize = sizeof(uint32_t) * mesh.indices.size();
+
+            lveDevice.createBuffer(
+                indexBufferSize,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+                VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                mesh.indexBuffer,
+                mesh.indexBufferAllocation
+            );
+
+            stagingRing.uploadBuffer(mesh.indices.data(), indexBufferSize, mesh.indexBuffer);
+        }
 
-        VkBuffer stagingBuffer;
-        VkDeviceMemory stagingMemory;
+        // BLAS build는 같은 queue의 이후 submit이라 ticket을 기다릴 필요 없음 (flush 끝의 barrier)
+        stagingRing.flush();
+    }
 
-        lveDevice.createBuffer(
-            vertexBufferSize,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            stagingBuffer,
-            stagingMemory
-        );
+    LveAccelerationStructure::BlasBuildRequest LveAccelerationStructure::makeUnitSphereBuild(MeshData& mesh) {
+        VkBufferDeviceAddressInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
 
-        void* data;
-        vkMapMemory(lveDevice.device(), stagingMemory, 0, vertexBufferSize, 0, &data);
-        memcpy(data, mesh.vertices.data(), vertexBufferSize);
-        vkUnmapMemory(lveDevice.device(), stagingMemory);
+        // Geometry description
+        BlasBuildRequest request{};
+        request.name = "unit sphere BLAS";
+        request.accelerationStructure = &mesh.bottomLevelAS;
+        request.buffer = &mesh.bottomLevelASBuffer;
+        request.allocation = &mesh.bottomLevelASAllocation;
 
+        VkAccelerationStructureGeometryKHR& geometry = request.geometry;
+        geometry.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+        geometry.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
+
+        if (!mesh.aabbs.empty()) {
+            bufferInfo.buffer = mesh.aabbBuffer;
+            VkDeviceAddress aabbAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+
+            geometry.geometryType = VK_GEOMETRY_TYPE_AABBS_KHR;
+            geometry.geometry.aabbs.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_AABBS_DATA_KHR;
+            geometry.geometry.aabbs.data.deviceAddress = aabbAddress;
+            geometry.geometry.aabbs.stride = sizeof(VkAabbPositionsKHR);
+
+            request.primitiveCount = static_cast<uint32_t>(mesh.aabbs.size());
+            request.hostVertexData = mesh.aabbs.data();
+        }
+        else {
+            // Get buffer addresses
+            bufferInfo.buffer = mesh.vertexBuffer;
+            VkDeviceAddress vertexAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+
+            bufferInfo.buffer = mesh.indexBuffer;
+            VkDeviceAddress indexAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+
+            geometry.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+            geometry.geometry.triangles.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
+            geometry.geometry.triangles.vertexFormat = VK_FORMAT_R32G32B32_SFLOAT;
+            geometry.geometry.triangles.vertexData.deviceAddress = vertexAddress;
+            geometry.geometry.triangles.vertexStride = sizeof(Vertex);
+            geometry.geometry.triangles.maxVertex = static_cast<uint32_t>(mesh.vertices.size() - 1);
+            geometry.geometry.triangles.indexType = VK_INDEX_TYPE_UINT32;
+            geometry.geometry.triangles.indexData.deviceAddress = indexAddress;
+
+            request.primitiveCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+            request.hostVertexData = mesh.vertices.data();
+            request.hostIndexData = mesh.indices.data();
+        }
+
+        return request;
+    }
+
+    void LveAccelerationStructure::finishUnitSphereBlas(const BlasBuildRequest& build) {
+        VkAccelerationStructureDeviceAddressInfoKHR addressInfo{};
+        addressInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+        addressInfo.accelerationStructure = unitSphereMesh.bottomLevelAS;
+        unitSphereBlasAddress = vkGetAccelerationStructureDeviceAddressKHR(lveDevice.device(), &addressInfo);
+
+        // 모드별 메모리 비교용
+        VkDeviceSize geometryBytes = unitSphereMesh.aabbs.empty()
+            ? sizeof(Vertex) * unitSphereMesh.vertices.size() + sizeof(uint32_t) * unitSphereMesh.indices.size()
+            : sizeof(VkAabbPositionsKHR) * unitSphereMesh.aabbs.size();
+        std::cout << "BLAS memory: " << build.finalSize << " bytes (AS) + "
+            << geometryBytes << " bytes (geometry), scratch " << build.sizeInfo.buildScratchSize << " bytes" << std::endl;
+    }
+
+    void LveAccelerationStructure::buildBottomLevelASBatch(std::vector<BlasBuildRequest>& requests) {
+        if (requests.empty()) return;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        const uint32_t count = static_cast<uint32_t>(requests.size());
+        const VkDeviceSize alignment = scratchOffsetAlignment;
+        auto alignUp = [alignment](VkDeviceSize value) { return (value + alignment - 1) / alignment * alignment; };
+
+        std::vector<VkAccelerationStructureBuildGeometryInfoKHR> buildInfos(count);
+        std::vector<VkAccelerationStructureBuildRangeInfoKHR> rangeInfos(count);
+        std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> rangeInfoPointers(count);
+        std::vector<VkDeviceSize> scratchOffsets(count);
+        std::vector<VkAccelerationStructureKHR> structures(count);
+
+        // 1. 크기 조회 + AS 생성, chunk 나누기
+        //    chunk 안의 build는 arena에서 겹치지 않는 scratch 영역 (합이 budget 이하),
+        //    다음 chunk는 arena를 처음부터 다시 사용 → arena 크기 = 가장 큰 chunk의 합
+        std::vector<uint32_t> chunkBegins;  // chunk c = [chunkBegins[c], chunkBegins[c + 1])
+        VkDeviceSize chunkScratch = 0;
+        VkDeviceSize arenaSize = 0;
+        VkDeviceSize separateScratch = 0;  // build마다 scratch buffer를 따로 만들었다면
+        for (uint32_t i = 0; i < count; i++) {
+            BlasBuildRequest& request = requests[i];
+
+            VkAccelerationStructureBuildGeometryInfoKHR& buildInfo = buildInfos[i];
+            buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+            buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+            buildInfo.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
+                VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+            buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+            buildInfo.geometryCount = 1;
+            buildInfo.pGeometries = &request.geometry;
+
+            request.sizeInfo = VkAccelerationStructureBuildSizesInfoKHR{};
+            request.sizeInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+            vkGetAccelerationStructureBuildSizesKHR(
+                lveDevice.device(),
+                VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
+                &buildInfo,
+                &request.primitiveCount,
+                &request.sizeInfo
+            );
+
+            // AS Buffer creation
+            lveDevice.createBuffer(
+                request.sizeInfo.accelerationStructureSize,
+                VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                *request.buffer,
+                *request.allocation
+            );
+
+            // Acceleration Structure creation
+            VkAccelerationStructureCreateInfoKHR createInfo{};
+            createInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+            createInfo.buffer = *request.buffer;
+            createInfo.size = request.sizeInfo.accelerationStructureSize;
+            createInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+
+            vkCreateAccelerationStructureKHR(lveDevice.device(), &createInfo, nullptr, request.accelerationStructure);
+            buildInfo.dstAccelerationStructure = *request.accelerationStructure;
+            structures[i] = *request.accelerationStructure;
+
+            rangeInfos[i].primitiveCount = request.primitiveCount;
+            rangeInfoPointers[i] = &rangeInfos[i];
+
+            const VkDeviceSize scratchSize = alignUp(request.sizeInfo.buildScratchSize);
+            if (chunkBegins.empty() || (chunkScratch > 0 && chunkScratch + scratchSize > blasBatchSettings.scratchBudget)) {
+                chunkBegins.push_back(i);
+                chunkScratch = 0;
+            }
+            scratchOffsets[i] = chunkScratch;
+            chunkScratch += scratchSize;
+            arenaSize = std::max(arenaSize, chunkScratch);
+            separateScratch += request.sizeInfo.buildScratchSize;
+        }
+        const uint32_t chunkCount = static_cast<uint32_t>(chunkBegins.size());
+        chunkBegins.push_back(count);
+
+        // 2. Scratch arena 하나 (시작 주소도 minAccelerationStructureScratchOffsetAlignment에 맞춤)
+        VkBuffer scratchBuffer;
+        LveAllocation scratchAllocation;
         lveDevice.createBuffer(
-            vertexBufferSize,
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
-            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
-            VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+            arenaSize + alignment,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            mesh.vertexBuffer,
-            mesh.vertexBufferMemory
+            scratchBuffer,
+            scratchAllocation,
+            LveMemoryUsage::Transient
         );
+        const VkDeviceAddress scratchBase = alignUp(getBufferAddress(scratchBuffer));
+        for (uint32_t i = 0; i < count; i++) {
+            buildInfos[i].scratchData.deviceAddress = scratchBase + scratchOffsets[i];
+        }
 
-        lveDevice.copyBuffer(stagingBuffer, mesh.vertexBuffer, vertexBufferSize);
+        // 3. 한 command buffer: chunk마다 build 한 번, chunk 사이 scratch 재사용 barrier, 끝에 size query 전부
+        ensureCompactionQueries(count);
 
-        vkDestroyBuffer(lveDevice.device(), stagingBuffer, nullptr);
-        vkFreeMemory(lveDevice.device(), stagingMemory, nullptr);
+        VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+        if (profiler) profiler->beginImmediate(commandBuffer);
+        vkCmdResetQueryPool(commandBuffer, compactionQueryPool, 0, count);
+        {
+            LveGpuProfiler::Scope scope{ profiler, commandBuffer, "blas build" };
+            for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+                const uint32_t begin = chunkBegins[chunk];
+                const uint32_t end = chunkBegins[chunk + 1];
+
+                if (chunk > 0) {
+                    // 이전 chunk의 build가 scratch를 다 쓴 뒤에 덮어씀
+                    VkMemoryBarrier barrier{};
+                    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                    barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+                    barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR |
+                        VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+
+                    vkCmdPipelineBarrier(commandBuffer,
+                        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+                }
+
+                vkCmdBuildAccelerationStructuresKHR(
+                    commandBuffer, end - begin, buildInfos.data() + begin, rangeInfoPointers.data() + begin);
+            }
+        }
+        recordCompactedSizeQuery(commandBuffer, structures.data(), count);
+        lveDevice.endSingleTimeCommands(commandBuffer);
+        if (profiler) profiler->resolveImmediate();
+
+        lveDevice.destroyBuffer(scratchBuffer, scratchAllocation);
+
+        // 4. Compaction도 copy 전부를 submit 하나로
+        if (compactionSettings.bottomLevel) {
+            std::vector<CompactionTarget> targets(count);
+            for (uint32_t i = 0; i < count; i++) {
+                targets[i].name = requests[i].name;
+                targets[i].type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+                targets[i].originalSize = requests[i].sizeInfo.accelerationStructureSize;
+                targets[i].accelerationStructure = requests[i].accelerationStructure;
+                targets[i].buffer = requests[i].buffer;
+                targets[i].allocation = requests[i].allocation;
+            }
+            std::vector<VkDeviceSize> compactedSizes = compactAccelerationStructures(targets);
+            for (uint32_t i = 0; i < count; i++) {
+                requests[i].finalSize = compactedSizes[i];
+            }
+        }
+        else {
+            for (BlasBuildRequest& request : requests) {
+                request.finalSize = request.sizeInfo.accelerationStructureSize;
+            }
+        }
 
-        // Index Buffer
-        VkDeviceSize indexBufferSize = sizeof(uint32_t) * mesh.indices.size();
+        float buildMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "BLAS batch: " << count << " builds in " << chunkCount << " chunk(s), 1 submit"
+            << (compactionSettings.bottomLevel ? " + 1 compaction submit" : "") << ", scratch arena "
+            << arenaSize << " bytes (" << separateScratch << " bytes as separate buffers), "
+            << buildMs << " ms total" << std::endl;
+    }
 
-        lveDevice.createBuffer(
-            indexBufferSize,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            stagingBuffer,
-            stagingMemory
-        );
+    void LveAccelerationStructure::setHostBuilds(bool enabled) {
+        if (enabled && !lveDevice.supportsAccelerationStructureHostCommands()) {
+            std::cout << "accelerationStructureHostCommands not supported, building BLAS on the device" << std::endl;
+            enabled = false;
+        }
+        hostBuilds = enabled;
+        if (hostBuilds && !hostBuildThreads) {
+            hostBuildThreads = std::make_unique<LveThreadPool>();
+        }
+    }
 
-        vkMapMemory(lveDevice.device(), stagingMemory, 0, indexBufferSize, 0, &data);
-        memcpy(data, mesh.indices.data(), indexBufferSize);
-        vkUnmapMemory(lveDevice.device(), stagingMemory);
+    void LveAccelerationStructure::buildBottomLevelASBatchOnHost(std::vector<BlasBuildRequest>& requests) {
+        if (requests.empty()) return;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        const uint32_t count = static_cast<uint32_t>(requests.size());
+        const VkDeviceSize alignment = scratchOffsetAlignment;
+        auto alignUp = [alignment](VkDeviceSize value) { return (value + alignment - 1) / alignment * alignment; };
+
+        // geometry는 host 주소로 바꾼 복사본 (request.geometry는 device 주소 그대로 둠)
+        std::vector<VkAccelerationStructureGeometryKHR> geometries(count);
+        std::vector<VkAccelerationStructureBuildGeometryInfoKHR> buildInfos(count);
+        std::vector<VkAccelerationStructureBuildRangeInfoKHR> rangeInfos(count);
+        std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> rangeInfoPointers(count);
+        std::vector<VkDeviceSize> scratchOffsets(count);
+        std::vector<VkAccelerationStructureKHR> structures(count);
+
+        // 1. 크기 조회 (host build 기준) + host visible 메모리에 AS 생성
+        //    build 호출이 하나라 chunk 없이 scratch 영역을 모두 겹치지 않게 배치
+        VkDeviceSize scratchSize = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            BlasBuildRequest& request = requests[i];
+
+            VkAccelerationStructureGeometryKHR& geometry = geometries[i];
+            geometry = request.geometry;
+            if (geometry.geometryType == VK_GEOMETRY_TYPE_AABBS_KHR) {
+                geometry.geometry.aabbs.data.hostAddress = request.hostVertexData;
+            }
+            else {
+                geometry.geometry.triangles.vertexData.hostAddress = request.hostVertexData;
+                geometry.geometry.triangles.indexData.hostAddress = request.hostIndexData;
+            }
 
-        lveDevice.createBuffer(
-            indexBufferSize,
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-            VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+            VkAccelerationStructureBuildGeometryInfoKHR& buildInfo = buildInfos[i];
+            buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+            buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+            buildInfo.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
+                VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+            buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+            buildInfo.geometryCount = 1;
+            buildInfo.pGeometries = &geometry;
+
+            request.sizeInfo = VkAccelerationStructureBuildSizesInfoKHR{};
+            request.sizeInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+            vkGetAccelerationStructureBuildSizesKHR(
+                lveDevice.device(),
+                VK_ACCELERATION_STRUCTURE_BUILD_TYPE_HOST_KHR,
+                &buildInfo,
+                &request.primitiveCount,
+                &request.sizeInfo
+            );
+
+            // Host command는 host visible 메모리의 AS만 쓸 수 있음 (compaction copy가 device local로 옮김)
+            lveDevice.createBuffer(
+                request.sizeInfo.accelerationStructureSize,
+                VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                *request.buffer,
+                *request.allocation
+            );
+
+            VkAccelerationStructureCreateInfoKHR createInfo{};
+            createInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+            createInfo.buffer = *request.buffer;
+            createInfo.size = request.sizeInfo.accelerationStructureSize;
+            createInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+
+            if (vkCreateAccelerationStructureKHR(
+                lveDevice.device(), &createInfo, nullptr, request.accelerationStructure) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create bottom level acceleration structure for host build!");
+            }
+            buildInfo.dstAccelerationStructure = *request.accelerationStructure;
+            structures[i] = *request.accelerationStructure;
+
+            rangeInfos[i].primitiveCount = request.primitiveCount;
+            rangeInfoPointers[i] = &rangeInfos[i];
+
+            scratchOffsets[i] = scratchSize;
+            scratchSize += alignUp(request.sizeInfo.buildScratchSize);
+        }
+
+        // 2. Scratch는 일반 host 메모리
+        std::vector<uint8_t> scratch(static_cast<size_t>(scratchSize + alignment));
+        const uintptr_t scratchBase = static_cast<uintptr_t>(alignUp(reinterpret_cast<uintptr_t>(scratch.data())));
+        for (uint32_t i = 0; i < count; i++) {
+            buildInfos[i].scratchData.hostAddress = reinterpret_cast<void*>(scratchBase + scratchOffsets[i]);
+        }
+
+        // 3. Build 하나를 deferred operation으로 → pool thread + 호출 thread가 join해서 나눠 실행
+        VkDeferredOperationKHR deferredOperation;
+        if (vkCreateDeferredOperationKHR(lveDevice.device(), nullptr, &deferredOperation) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create deferred operation!");
+        }
+
+        uint32_t joinThreads = 1;
+        VkResult result = vkBuildAccelerationStructuresKHR(
+            lveDevice.device(), deferredOperation, count, buildInfos.data(), rangeInfoPointers.data());
+        if (result == VK_OPERATION_DEFERRED_KHR) {
+            // driver가 더 나눌 수 없으면 THREAD_DONE, 남은 일을 다른 thread가 하는 중이면 THREAD_IDLE (잠시 뒤 다시 join)
+            joinThreads = std::max(1u, std::min(
+                vkGetDeferredOperationMaxConcurrencyKHR(lveDevice.device(), deferredOperation),
+                hostBuildThreads->getThreadCount()));
+            hostBuildThreads->run(joinThreads, [this, deferredOperation] {
+                for (;;) {
+                    VkResult joinResult = vkDeferredOperationJoinKHR(lveDevice.device(), deferredOperation);
+                    if (joinResult != VK_THREAD_IDLE_KHR) return;  // SUCCESS / THREAD_DONE / 오류
+                    std::this_thread::yield();
+                }
+            });
+            result = vkGetDeferredOperationResultKHR(lveDevice.device(), deferredOperation);
+        }
+        else if (result == VK_OPERATION_NOT_DEFERRED_KHR) {
+            result = VK_SUCCESS;  // 호출 안에서 이미 끝남
+        }
+        vkDestroyDeferredOperationKHR(lveDevice.device(), deferredOperation, nullptr);
+
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error("failed to build bottom level acceleration structures on host!");
+        }
+        float hostMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+
+        // 4. Compacted size도 host에서 바로 읽고 copy 전부를 submit 하나로
+        //    (compaction을 끄면 BLAS가 host visible 메모리에 그대로 남음)
+        if (compactionSettings.bottomLevel) {
+            std::vector<VkDeviceSize> compactedSizes(count);
+            if (vkWriteAccelerationStructuresPropertiesKHR(
+                lveDevice.device(),
+                count,
+                structures.data(),
+                VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+                sizeof(VkDeviceSize) * count,
+                compactedSizes.data(),
+                sizeof(VkDeviceSize)) != VK_SUCCESS) {
+                throw std::runtime_error("failed to get compacted acceleration structure size!");
+            }
+
+            std::vector<CompactionTarget> targets(count);
+            for (uint32_t i = 0; i < count; i++) {
+                targets[i].name = requests[i].name;
+                targets[i].type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+                targets[i].originalSize = requests[i].sizeInfo.accelerationStructureSize;
+                targets[i].accelerationStructure = requests[i].accelerationStructure;
+                targets[i].buffer = requests[i].buffer;
+                targets[i].allocation = requests[i].allocation;
+            }
+            compactAccelerationStructures(targets, compactedSizes);
+            for (uint32_t i = 0; i < count; i++) {
+                requests[i].finalSize = compactedSizes[i];
+            }
+        }
+        else {
+            for (BlasBuildRequest& request : requests) {
+                request.finalSize = request.sizeInfo.accelerationStructureSize;
+            }
+        }
+
+        float buildMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "BLAS host batch: " << count << " builds, 1 deferred operation joined by " << joinThreads
+            << " thread(s), scratch " << scratchSize << " bytes (host), " << hostMs << " ms build, "
+            << buildMs << " ms total" << (compactionSettings.bottomLevel ? " (with device compaction)" : "") << std::endl;
+    }
+
+    void LveAccelerationStructure::appendMeshBuilds(std::vector<BlasBuildRequest>& requests) {
+        LveStagingRing& stagingRing = lveDevice.getStagingRing();
+        const uint32_t firstMesh = static_cast<uint32_t>(meshBlases.size());
+        const uint32_t meshCount = meshLibrary->getMeshCount();
+        meshBlases.resize(meshCount);  // 요청이 MeshBlas 멤버를 가리키므로 이후 resize 금지
+
+        // 새 mesh의 vertex / index를 모두 staging ring에 모아 한 번에 upload
+        // (BLAS build input + closest hit의 buffer reference 읽기)
+        const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
             VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
-            VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            mesh.indexBuffer,
-            mesh.indexBufferMemory
-        );
+            VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
+
+        for (uint32_t i = firstMesh; i < meshCount; i++) {
+            const LveMesh& mesh = meshLibrary->getMesh(i + 1);
+            MeshBlas& blas = meshBlases[i];
+
+            VkDeviceSize vertexBufferSize = sizeof(LveMeshVertex) * mesh.vertices.size();
+            lveDevice.createBuffer(vertexBufferSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                blas.vertexBuffer, blas.vertexBufferAllocation);
+            stagingRing.uploadBuffer(mesh.vertices.data(), vertexBufferSize, blas.vertexBuffer);
+
+            VkDeviceSize indexBufferSize = sizeof(uint32_t) * mesh.indices.size();
+            lveDevice.createBuffer(indexBufferSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                blas.indexBuffer, blas.indexBufferAllocation);
+            stagingRing.uploadBuffer(mesh.indices.data(), indexBufferSize, blas.indexBuffer);
+        }
+        stagingRing.flush();
+
+        for (uint32_t i = firstMesh; i < meshCount; i++) {
+            const LveMesh& mesh = meshLibrary->getMesh(i + 1);
+            MeshBlas& blas = meshBlases[i];
+
+            BlasBuildRequest request{};
+            request.name = "mesh BLAS " + mesh.name;
+            request.primitiveCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+            request.accelerationStructure = &blas.bottomLevelAS;
+            request.buffer = &blas.bottomLevelASBuffer;
+            request.allocation = &blas.bottomLevelASAllocation;
+            request.hostVertexData = mesh.vertices.data();
+            request.hostIndexData = mesh.indices.data();
+
+            VkAccelerationStructureGeometryKHR& geometry = request.geometry;
+            geometry.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+            geometry.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
+            geometry.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+            geometry.geometry.triangles.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
+            geometry.geometry.triangles.vertexFormat = VK_FORMAT_R32G32B32_SFLOAT;
+            geometry.geometry.triangles.vertexData.deviceAddress = getBufferAddress(blas.vertexBuffer);
+            geometry.geometry.triangles.vertexStride = sizeof(LveMeshVertex);  // position만 읽음
+            geometry.geometry.triangles.maxVertex = static_cast<uint32_t>(mesh.vertices.size() - 1);
+            geometry.geometry.triangles.indexType = VK_INDEX_TYPE_UINT32;
+            geometry.geometry.triangles.indexData.deviceAddress = getBufferAddress(blas.indexBuffer);
+
+            requests.push_back(request);
+        }
+    }
 
-        lveDevice.copyBuffer(stagingBuffer, mesh.indexBuffer, indexBufferSize);
+    void LveAccelerationStructure::finishMeshBlases(uint32_t firstMesh, const BlasBuildRequest* builds) {
+        VkDeviceSize totalBlasSize = 0;
+        VkDeviceSize totalGeometrySize = 0;
+        const uint32_t meshCount = static_cast<uint32_t>(meshBlases.size());
+        for (uint32_t i = firstMesh; i < meshCount; i++) {
+            const LveMesh& mesh = meshLibrary->getMesh(i + 1);
+            MeshBlas& blas = meshBlases[i];
+
+            VkAccelerationStructureDeviceAddressInfoKHR addressInfo{};
+            addressInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+            addressInfo.accelerationStructure = blas.bottomLevelAS;
+            blas.blasAddress = vkGetAccelerationStructureDeviceAddressKHR(lveDevice.device(), &addressInfo);
+
+            totalBlasSize += builds[i - firstMesh].finalSize;
+            totalGeometrySize += sizeof(LveMeshVertex) * mesh.vertices.size() + sizeof(uint32_t) * mesh.indices.size();
+        }
 
-        vkDestroyBuffer(lveDevice.device(), stagingBuffer, nullptr);
-        vkFreeMemory(lveDevice.device(), stagingMemory, nullptr);
+        std::cout << "Mesh BLAS created: " << meshCount - firstMesh << " unique meshes ("
+            << meshLibrary->getDuplicateCount() << " duplicates shared), " << totalBlasSize << " bytes (AS) + "
+            << totalGeometrySize << " bytes (geometry)" << std::endl;
     }
 
-    void LveAccelerationStructure::createSphereInfoBuffer() {
-        VkDeviceSize bufferSize = sizeof(SphereInfo) * sphereInfos.size();
+    void LveAccelerationStructure::createMeshTable() {
+        lveDevice.destroyBuffer(meshTableBuffer, meshTableAllocation);
 
+        // 항목 0은 mesh id 1 (mesh가 없어도 descriptor가 가리킬 buffer는 필요)
+        std::vector<MeshTableEntry> entries(std::max<size_t>(meshBlases.size(), 1), MeshTableEntry{ 0, 0 });
+        for (size_t i = 0; i < meshBlases.size(); i++) {
+            entries[i].vertexAddress = getBufferAddress(meshBlases[i].vertexBuffer);
+            entries[i].indexAddress = getBufferAddress(meshBlases[i].indexBuffer);
+        }
+
+        const VkDeviceSize tableSize = sizeof(MeshTableEntry) * entries.size();
         lveDevice.createBuffer(
-            bufferSize,
-            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            sphereInfoBuffer,
-            sphereInfoMemory
+            tableSize,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            meshTableBuffer,
+            meshTableAllocation
         );
 
-        void* data;
-        vkMapMemory(lveDevice.device(), sphereInfoMemory, 0, bufferSize, 0, &data);
-        memcpy(data, sphereInfos.data(), bufferSize);
-        vkUnmapMemory(lveDevice.device(), sphereInfoMemory);
+        LveStagingRing& stagingRing = lveDevice.getStagingRing();
+        stagingRing.uploadBuffer(entries.data(), tableSize, meshTableBuffer);
+        stagingRing.flush();
+    }
+
+    void LveAccelerationStructure::ensureCompactionQueries(uint32_t count) {
+        if (count <= compactionQueryCapacity) return;
+
+        // 이전 query는 모두 완료된 single-time submit에서만 썼으므로 바로 교체 가능
+        vkDestroyQueryPool(lveDevice.device(), compactionQueryPool, nullptr);
+        compactionQueryPool = VK_NULL_HANDLE;
+
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+        queryPoolInfo.queryCount = count;
+
+        if (vkCreateQueryPool(lveDevice.device(), &queryPoolInfo, nullptr, &compactionQueryPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compaction query pool!");
+        }
+        compactionQueryCapacity = count;
+    }
+
+    void LveAccelerationStructure::recordCompactedSizeQuery(
+        VkCommandBuffer commandBuffer, const VkAccelerationStructureKHR* structures, uint32_t count) {
+        // Build 완료 후에 size 기록
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        vkCmdWriteAccelerationStructuresPropertiesKHR(
+            commandBuffer,
+            count,
+            structures,
+            VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+            compactionQueryPool,
+            0
+        );
+    }
+
+    void LveAccelerationStructure::compactAccelerationStructure(
+        const std::string& name,
+        VkAccelerationStructureTypeKHR type,
+        VkDeviceSize originalSize,
+        VkAccelerationStructureKHR& accelerationStructure,
+        VkBuffer& buffer,
+        LveAllocation& allocation
+    ) {
+        CompactionTarget target{};
+        target.name = name;
+        target.type = type;
+        target.originalSize = originalSize;
+        target.accelerationStructure = &accelerationStructure;
+        target.buffer = &buffer;
+        target.allocation = &allocation;
+        compactAccelerationStructures({ target });
+    }
+
+    std::vector<VkDeviceSize> LveAccelerationStructure::compactAccelerationStructures(
+        const std::vector<CompactionTarget>& targets) {
+        const uint32_t count = static_cast<uint32_t>(targets.size());
+
+        // build 제출이 끝난 뒤라 결과가 바로 준비됨 (query i = targets[i])
+        std::vector<VkDeviceSize> compactedSizes(count);
+        if (vkGetQueryPoolResults(
+            lveDevice.device(),
+            compactionQueryPool,
+            0,
+            count,
+            sizeof(VkDeviceSize) * count,
+            compactedSizes.data(),
+            sizeof(VkDeviceSize),
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) != VK_SUCCESS) {
+            throw std::runtime_error("failed to get compacted acceleration structure size!");
+        }
+
+        compactAccelerationStructures(targets, compactedSizes);
+        return compactedSizes;
+    }
+
+    void LveAccelerationStructure::compactAccelerationStructures(
+        const std::vector<CompactionTarget>& targets, const std::vector<VkDeviceSize>& compactedSizes) {
+        const uint32_t count = static_cast<uint32_t>(targets.size());
+
+        struct CompactCopy {
+            VkAccelerationStructureKHR accelerationStructure;
+            VkBuffer buffer;
+            LveAllocation allocation;
+        };
+        std::vector<CompactCopy> copies(count);
+
+        VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+        if (profiler) profiler->beginImmediate(commandBuffer);
+        {
+            LveGpuProfiler::Scope scope{ profiler, commandBuffer,
+                count == 1 ? targets[0].name + " compaction" : "blas batch compaction" };
+            for (uint32_t i = 0; i < count; i++) {
+                // Compacted AS Buffer creation
+                lveDevice.createBuffer(
+                    compactedSizes[i],
+                    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    copies[i].buffer,
+                    copies[i].allocation
+                );
+
+                VkAccelerationStructureCreateInfoKHR createInfo{};
+                createInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+                createInfo.buffer = copies[i].buffer;
+                createInfo.size = compactedSizes[i];
+                createInfo.type = targets[i].type;
+
+                vkCreateAccelerationStructureKHR(lveDevice.device(), &createInfo, nullptr, &copies[i].accelerationStructure);
+
+                VkCopyAccelerationStructureInfoKHR copyInfo{};
+                copyInfo.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+                copyInfo.src = *targets[i].accelerationStructure;
+                copyInfo.dst = copies[i].accelerationStructure;
+                copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+                vkCmdCopyAccelerationStructureKHR(commandBuffer, &copyInfo);
+            }
+        }
+        lveDevice.endSingleTimeCommands(commandBuffer);
+        if (profiler) profiler->resolveImmediate();
+
+        for (uint32_t i = 0; i < count; i++) {
+            const CompactionTarget& target = targets[i];
+
+            // 원본 해제하고 compacted로 교체
+            vkDestroyAccelerationStructureKHR(lveDevice.device(), *target.accelerationStructure, nullptr);
+            lveDevice.destroyBuffer(*target.buffer, *target.allocation);
+
+            *target.accelerationStructure = copies[i].accelerationStructure;
+            *target.buffer = copies[i].buffer;
+            *target.allocation = copies[i].allocation;
+
+            AccelerationStructureMemoryInfo info{};
+            info.name = target.name;
+            info.originalSize = target.originalSize;
+            info.compactedSize = compactedSizes[i];
+            memoryReport.push_back(info);
+
+            std::cout << "Compacted " << target.name << ": " << target.originalSize << " -> " << compactedSizes[i] << " bytes" << std::endl;
+        }
+    }
+
+    void LveAccelerationStructure::printMemoryReport() const {
+        VkDeviceSize totalOriginal = 0;
+        VkDeviceSize totalCompacted = 0;
+
+        std::cout << "Acceleration structure memory (before -> after compaction):" << std::endl;
+        for (const auto& info : memoryReport) {
+            std::cout << "  " << info.name << ": " << info.originalSize << " -> " << info.compactedSize
+                << " bytes (" << (info.originalSize > 0 ? 100.0 * info.compactedSize / info.originalSize : 0.0)
+                << "%)" << std::endl;
+            totalOriginal += info.originalSize;
+            totalCompacted += info.compactedSize;
+        }
+        std::cout << "  total: " << totalOriginal << " -> " << totalCompacted << " bytes" << std::endl;
+    }
+
+    namespace {
+        // build와 update가 같은 flag를 써야 refit 가능
+        const VkBuildAccelerationStructureFlagsKHR TLAS_BUILD_FLAGS =
+            VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR |
+            VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR |
+            VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+
+        VkAccelerationStructureGeometryKHR makeInstanceGeometry(VkDeviceAddress instanceAddress) {
+            VkAccelerationStructureGeometryKHR geometry{};
+            geometry.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+            geometry.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+            geometry.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
+            geometry.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+            geometry.geometry.instances.arrayOfPointers = VK_FALSE;
+            geometry.geometry.instances.data.deviceAddress = instanceAddress;
+            return geometry;
+        }
+
+        // Serialize / deserialize copy의 메모리 주소 정렬 (spec: 256 bytes)
+        constexpr VkDeviceSize SERIALIZED_ALIGNMENT = 256;
 
-        std::cout << "Sphere info buffer created: " << sphereInfos.size() << " spheres" << std::endl;
+        VkDeviceSize alignSerialized(VkDeviceSize value) {
+            return (value + SERIALIZED_ALIGNMENT - 1) & ~(SERIALIZED_ALIGNMENT - 1);
+        }
     }
 
-    void LveAccelerationStructure::createBottomLevelAS(MeshData& mesh) {
-        // Get buffer addresses
+    VkDeviceAddress LveAccelerationStructure::getBufferAddress(VkBuffer buffer) {
         VkBufferDeviceAddressInfo bufferInfo{};
         bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
-        bufferInfo.buffer = mesh.vertexBuffer;
-        VkDeviceAddress vertexAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+        bufferInfo.buffer = buffer;
+        return vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+    }
 
-        bufferInfo.buffer = mesh.indexBuffer;
-        VkDeviceAddress indexAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+    uint64_t LveAccelerationStructure::computeSceneHash() const {
+        // BLAS / TLAS build 결과를 바꾸는 입력 전부. BLAS 주소는 실행마다 다르므로 instance에는 BLAS 번호를 넣음
+        const uint32_t config[4] = {
+            static_cast<uint32_t>(geometryMode),
+            hitGroupCount,
+            compactionSettings.bottomLevel ? 1u : 0u,
+            compactionSettings.topLevel ? 1u : 0u
+        };
+        uint64_t hash = hashBytes(config, sizeof(config));
+
+        // 단위 구 geometry (Vertex 중 build에 쓰이는 position / index만)
+        if (!unitSphereMesh.aabbs.empty()) {
+            hash = hashBytes(
+                unitSphereMesh.aabbs.data(), sizeof(VkAabbPositionsKHR) * unitSphereMesh.aabbs.size(), hash);
+        }
+        for (const Vertex& vertex : unitSphereMesh.vertices) {
+            hash = hashBytes(&vertex.pos, sizeof(vertex.pos), hash);
+        }
+        hash = hashBytes(
+            unitSphereMesh.indices.data(), sizeof(uint32_t) * unitSphereMesh.indices.size(), hash);
+
+        // Mesh는 library의 내용 해시 (vertex + index)
+        const uint32_t meshCount = meshLibrary ? meshLibrary->getMeshCount() : 0;
+        for (uint32_t i = 0; i < meshCount; i++) {
+            const LveMesh& mesh = meshLibrary->getMesh(i + 1);
+            const uint64_t meshKey[3] = { mesh.hash, mesh.vertices.size(), mesh.indices.size() };
+            hash = hashBytes(meshKey, sizeof(meshKey), hash);
+        }
 
-        // Geometry description
-        VkAccelerationStructureGeometryKHR geometry{};
-        geometry.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
-        geometry.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
-        geometry.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
-        geometry.geometry.triangles.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
-        geometry.geometry.triangles.vertexFormat = VK_FORMAT_R32G32B32_SFLOAT;
-        geometry.geometry.triangles.vertexData.deviceAddress = vertexAddress;
-        geometry.geometry.triangles.vertexStride = sizeof(Vertex);
-        geometry.geometry.triangles.maxVertex = static_cast<uint32_t>(mesh.vertices.size() - 1);
-        geometry.geometry.triangles.indexType = VK_INDEX_TYPE_UINT32;
-        geometry.geometry.triangles.indexData.deviceAddress = indexAddress;
-
-        // Build info
-        VkAccelerationStructureBuildGeometryInfoKHR buildInfo{};
-        buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
-        buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-        buildInfo.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
-        buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
-        buildInfo.geometryCount = 1;
-        buildInfo.pGeometries = &geometry;
+        // TLAS instance record 그대로 (transform, custom index, SBT offset, flag)
+        for (uint32_t i = 0; i < static_cast<uint32_t>(sphereInfos.size()); i++) {
+            VkAccelerationStructureInstanceKHR instance = makeInstance(i);
+            instance.accelerationStructureReference = sphereInfos[i].meshId;
+            hash = hashBytes(&instance, sizeof(instance), hash);
+        }
+        return hash;
+    }
 
-        uint32_t primitiveCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+    bool LveAccelerationStructure::readCache(uint64_t sceneHash, size_t blasCount) {
+        cacheKey.sceneHash = sceneHash;
+        if (!LveAccelerationStructureCache{ cachePath }.load(cacheKey, cachedStructures)) {
+            return false;
+        }
 
-        VkAccelerationStructureBuildSizesInfoKHR sizeInfo{};
-        sizeInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
-        vkGetAccelerationStructureBuildSizesKHR(
-            lveDevice.device(),
-            VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
-            &buildInfo,
-            &primitiveCount,
-            &sizeInfo
-        );
+        auto reject = [this](const char* reason) {
+            std::cout << "Acceleration structure cache " << cachePath << " " << reason << ", rebuilding" << std::endl;
+            cachedStructures.clear();
+            cachedHandleTargets.clear();
+            return false;
+        };
 
-        // AS Buffer creation
-        lveDevice.createBuffer(
-            sizeInfo.accelerationStructureSize,
-            VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            mesh.bottomLevelASBuffer,
-            mesh.bottomLevelASMemory
-        );
+        // 순서: 요청된 BLAS 순서 그대로 (단위 구, mesh...) + 마지막이 TLAS
+        if (cachedStructures.size() != blasCount + 1) {
+            return reject("has a different structure count");
+        }
 
-        // Acceleration Structure creation
-        VkAccelerationStructureCreateInfoKHR createInfo{};
-        createInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
-        createInfo.buffer = mesh.bottomLevelASBuffer;
-        createInfo.size = sizeInfo.accelerationStructureSize;
-        createInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+        // Blob 앞의 version data (driver / compatibility UUID)로 이 device가 읽을 수 있는지 확인
+        for (const LveSerializedAccelerationStructure& entry : cachedStructures) {
+            if (entry.data.size() < LveAccelerationStructureCache::BLOB_HEADER_SIZE ||
+                LveAccelerationStructureCache::deserializedSize(entry) == 0) {
+                return reject("has a corrupt entry");
+            }
 
-        vkCreateAccelerationStructureKHR(lveDevice.device(), &createInfo, nullptr, &mesh.bottomLevelAS);
+            VkAccelerationStructureVersionInfoKHR versionInfo{};
+            versionInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_VERSION_INFO_KHR;
+            versionInfo.pVersionData = entry.data.data();
 
-        // Scratch Buffer
-        VkBuffer scratchBuffer;
-        VkDeviceMemory scratchMemory;
+            VkAccelerationStructureCompatibilityKHR compatibility = VK_ACCELERATION_STRUCTURE_COMPATIBILITY_INCOMPATIBLE_KHR;
+            vkGetDeviceAccelerationStructureCompatibilityKHR(lveDevice.device(), &versionInfo, &compatibility);
+            if (compatibility != VK_ACCELERATION_STRUCTURE_COMPATIBILITY_COMPATIBLE_KHR) {
+                return reject("is not compatible with this driver");
+            }
+        }
+
+        // TLAS가 참조하는 handle (저장 시점 BLAS 주소) → 몇 번째 BLAS인지 (deserialize 때 새 주소로 교체)
+        std::unordered_map<uint64_t, uint32_t> blasByAddress;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(blasCount); i++) {
+            blasByAddress[cachedStructures[i].originalAddress] = i;
+        }
+
+        const LveSerializedAccelerationStructure& tlas = cachedStructures.back();
+        const uint64_t handleCount = LveAccelerationStructureCache::handleCount(tlas);
+        if (handleCount > (tlas.data.size() - LveAccelerationStructureCache::BLOB_HEADER_SIZE) / sizeof(uint64_t)) {
+            return reject("has a corrupt TLAS entry");
+        }
+
+        cachedHandleTargets.resize(static_cast<size_t>(handleCount));
+        for (size_t i = 0; i < cachedHandleTargets.size(); i++) {
+            uint64_t handle = 0;
+            memcpy(&handle, tlas.data.data() + LveAccelerationStructureCache::BLOB_HEADER_SIZE + i * sizeof(uint64_t),
+                sizeof(handle));
+
+            auto it = blasByAddress.find(handle);
+            if (it == blasByAddress.end()) {
+                return reject("has a TLAS that references an unknown BLAS");
+            }
+            cachedHandleTargets[i] = it->second;
+        }
+
+        return true;
+    }
+
+    void LveAccelerationStructure::deserializeAccelerationStructures(
+        const std::vector<DeserializeTarget>& targets, const std::string& scopeName) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // Blob 전부를 host visible buffer 하나에 (copy 원본 주소는 256 bytes 정렬)
+        const uint32_t count = static_cast<uint32_t>(targets.size());
+        std::vector<VkDeviceSize> offsets(count);
+        VkDeviceSize totalSize = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            offsets[i] = totalSize;
+            totalSize = alignSerialized(totalSize + targets[i].entry->data.size());
+        }
+
+        VkBuffer uploadBuffer;
+        LveAllocation uploadAllocation;
         lveDevice.createBuffer(
-            sizeInfo.buildScratchSize,
+            totalSize + SERIALIZED_ALIGNMENT,
             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            scratchBuffer,
-            scratchMemory
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            uploadBuffer,
+            uploadAllocation
         );
+        const VkDeviceAddress uploadAddress = getBufferAddress(uploadBuffer);
+        const VkDeviceAddress uploadBase = alignSerialized(uploadAddress);
+        char* mapped = static_cast<char*>(uploadAllocation.mapped) + (uploadBase - uploadAddress);
+        for (uint32_t i = 0; i < count; i++) {
+            memcpy(mapped + offsets[i], targets[i].entry->data.data(), targets[i].entry->data.size());
+        }
 
-        bufferInfo.buffer = scratchBuffer;
-        VkDeviceAddress scratchAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+        VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+        if (profiler) profiler->beginImmediate(commandBuffer);
+        {
+            LveGpuProfiler::Scope scope{ profiler, commandBuffer, scopeName };
+            for (uint32_t i = 0; i < count; i++) {
+                const DeserializeTarget& target = targets[i];
+                const VkDeviceSize size = LveAccelerationStructureCache::deserializedSize(*target.entry);
+
+                lveDevice.createBuffer(
+                    size,
+                    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    *target.buffer,
+                    *target.allocation
+                );
 
-        // Build
-        buildInfo.dstAccelerationStructure = mesh.bottomLevelAS;
-        buildInfo.scratchData.deviceAddress = scratchAddress;
+                VkAccelerationStructureCreateInfoKHR createInfo{};
+                createInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+                createInfo.buffer = *target.buffer;
+                createInfo.size = size;
+                createInfo.type = target.type;
 
-        VkAccelerationStructureBuildRangeInfoKHR rangeInfo{};
-        rangeInfo.primitiveCount = primitiveCount;
-        rangeInfo.primitiveOffset = 0;
-        rangeInfo.firstVertex = 0;
-        rangeInfo.transformOffset = 0;
+                vkCreateAccelerationStructureKHR(lveDevice.device(), &createInfo, nullptr, target.accelerationStructure);
 
-        const VkAccelerationStructureBuildRangeInfoKHR* pRangeInfo = &rangeInfo;
-
-        VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
-        vkCmdBuildAccelerationStructuresKHR(commandBuffer, 1, &buildInfo, &pRangeInfo);
+                VkCopyMemoryToAccelerationStructureInfoKHR copyInfo{};
+                copyInfo.sType = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_ACCELERATION_STRUCTURE_INFO_KHR;
+                copyInfo.src.deviceAddress = uploadBase + offsets[i];
+                copyInfo.dst = *target.accelerationStructure;
+                copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_DESERIALIZE_KHR;
+                vkCmdCopyMemoryToAccelerationStructureKHR(commandBuffer, &copyInfo);
+            }
+        }
         lveDevice.endSingleTimeCommands(commandBuffer);
+        if (profiler) profiler->resolveImmediate();
 
-        vkDestroyBuffer(lveDevice.device(), scratchBuffer, nullptr);
-        vkFreeMemory(lveDevice.device(), scratchMemory, nullptr);
+        lveDevice.destroyBuffer(uploadBuffer, uploadAllocation);
+
+        float loadMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "Deserialized " << count << " acceleration structure(s) from " << cachePath << ": "
+            << totalSize << " bytes in " << loadMs << " ms" << std::endl;
     }
 
-    void LveAccelerationStructure::createTopLevelAS() {
-        if (sphereInfos.empty()) {
-            throw std::runtime_error("No spheres to build TLAS!");
+    void LveAccelerationStructure::deserializeBottomLevelAS(std::vector<BlasBuildRequest>& requests) {
+        std::vector<DeserializeTarget> targets(requests.size());
+        for (size_t i = 0; i < requests.size(); i++) {
+            targets[i].entry = &cachedStructures[i];
+            targets[i].type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+            targets[i].accelerationStructure = requests[i].accelerationStructure;
+            targets[i].buffer = requests[i].buffer;
+            targets[i].allocation = requests[i].allocation;
         }
+        deserializeAccelerationStructures(targets, "blas deserialize");
+
+        // 저장된 AS는 이미 compact된 크기, scratch 없음
+        for (size_t i = 0; i < requests.size(); i++) {
+            requests[i].sizeInfo = VkAccelerationStructureBuildSizesInfoKHR{};
+            requests[i].sizeInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+            requests[i].sizeInfo.accelerationStructureSize = LveAccelerationStructureCache::deserializedSize(cachedStructures[i]);
+            requests[i].finalSize = requests[i].sizeInfo.accelerationStructureSize;
+        }
+    }
 
-        // 단위 구 BLAS의 주소 (하나뿐!)
-        VkAccelerationStructureDeviceAddressInfoKHR addressInfo{};
-        addressInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
-        addressInfo.accelerationStructure = unitSphereMesh.bottomLevelAS;
-        VkDeviceAddress blasAddress = vkGetAccelerationStructureDeviceAddressKHR(
-            lveDevice.device(), &addressInfo);
-
-        std::vector<VkAccelerationStructureInstanceKHR> instances;
-        instances.reserve(sphereInfos.size());
+    void LveAccelerationStructure::deserializeTopLevelAS() {
+        // 저장 시점 BLAS 주소 → 이번에 만든 BLAS 주소 (요청 순서: 단위 구, mesh...)
+        LveSerializedAccelerationStructure& tlas = cachedStructures.back();
+        for (size_t i = 0; i < cachedHandleTargets.size(); i++) {
+            const uint32_t blas = cachedHandleTargets[i];
+            const uint64_t address = blas == 0 ? unitSphereBlasAddress : meshBlases[blas - 1].blasAddress;
+            memcpy(tlas.data.data() + LveAccelerationStructureCache::BLOB_HEADER_SIZE + i * sizeof(uint64_t),
+                &address, sizeof(address));
+        }
 
-        // 각 구마다 Transform으로 위치/크기 적용!
-        for (size_t i = 0; i < sphereInfos.size(); ++i) {
-            const SphereInfo& sphere = sphereInfos[i];
+        DeserializeTarget target{};
+        target.entry = &tlas;
+        target.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
+        target.accelerationStructure = &topLevelAS;
+        target.buffer = &topLevelASBuffer;
+        target.allocation = &topLevelASAllocation;
+        deserializeAccelerationStructures({ target }, "tlas deserialize");
 
-            VkAccelerationStructureInstanceKHR instance{};
+        // Compacted TLAS처럼 refit 공간 / scratch가 없음 → 첫 변경 때 full size로 재할당
+        topLevelCompacted = true;
+        builtInstanceCount = static_cast<uint32_t>(sphereInfos.size());
+        builtVersion = instanceVersion;
+        resetRefitTracking();
 
-            // Transform Matrix 설정 (3x4 row-major)
-            // VkTransformMatrixKHR는 [3][4] 배열
-            // | m[0][0]  m[0][1]  m[0][2]  m[0][3] |   | sx  0   0   tx |
-            // | m[1][0]  m[1][1]  m[1][2]  m[1][3] | = | 0   sy  0   ty |
-            // | m[2][0]  m[2][1]  m[2][2]  m[2][3] |   | 0   0   sz  tz |
+        cachedStructures.clear();
+        cachedHandleTargets.clear();
 
-            float r = sphere.radius;
-            glm::vec3 c = sphere.center;
+        std::cout << "TLAS loaded from cache with " << builtInstanceCount << " instances" << std::endl;
+    }
 
-            // 초기화 (0으로)
-            memset(&instance.transform, 0, sizeof(instance.transform));
+    void LveAccelerationStructure::writeCache(uint64_t sceneHash, const std::vector<BlasBuildRequest>& requests) {
+        auto startTime = std::chrono::high_resolution_clock::now();
 
-            // Scale (대각선)
-            instance.transform.matrix[0][0] = r;    // scale X
-            instance.transform.matrix[1][1] = r;    // scale Y
-            instance.transform.matrix[2][2] = r;    // scale Z
+        // 요청 순서의 BLAS + 마지막 TLAS
+        std::vector<VkAccelerationStructureKHR> structures;
+        std::vector<LveSerializedAccelerationStructure> entries(requests.size() + 1);
+        for (size_t i = 0; i < requests.size(); i++) {
+            structures.push_back(*requests[i].accelerationStructure);
 
-            // Translation (마지막 열)
-            instance.transform.matrix[0][3] = c.x;  // translate X
-            instance.transform.matrix[1][3] = c.y;  // translate Y
-            instance.transform.matrix[2][3] = c.z;  // translate Z
+            VkAccelerationStructureDeviceAddressInfoKHR addressInfo{};
+            addressInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+            addressInfo.accelerationStructure = structures.back();
+            entries[i].originalAddress = vkGetAccelerationStructureDeviceAddressKHR(lveDevice.device(), &addressInfo);
+        }
+        structures.push_back(topLevelAS);
+        const uint32_t count = static_cast<uint32_t>(structures.size());
+
+        // 1. Serialize 크기 query
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR;
+        queryPoolInfo.queryCount = count;
+
+        VkQueryPool queryPool;
+        if (vkCreateQueryPool(lveDevice.device(), &queryPoolInfo, nullptr, &queryPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create serialization query pool!");
+        }
 
-            instance.instanceCustomIndex = static_cast<uint32_t>(i);
-            instance.mask = 0xFF;
-            instance.instanceShaderBindingTableRecordOffset = 0;
-            instance.flags = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
-            instance.accelerationStructureReference = blasAddress;  // 모두 같은 BLAS!
+        VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+        vkCmdResetQueryPool(commandBuffer, queryPool, 0, count);
+        vkCmdWriteAccelerationStructuresPropertiesKHR(commandBuffer, count, structures.data(),
+            VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR, queryPool, 0);
+        lveDevice.endSingleTimeCommands(commandBuffer);
 
-            instances.push_back(instance);
+        std::vector<VkDeviceSize> sizes(count);
+        VkResult result = vkGetQueryPoolResults(lveDevice.device(), queryPool, 0, count,
+            sizeof(VkDeviceSize) * count, sizes.data(), sizeof(VkDeviceSize),
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        vkDestroyQueryPool(lveDevice.device(), queryPool, nullptr);
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error("failed to get acceleration structure serialization size!");
         }
 
-        // Instance Buffer creation
-        VkBuffer instanceBuffer;
-        VkDeviceMemory instanceMemory;
-        VkDeviceSize instanceBufferSize = sizeof(VkAccelerationStructureInstanceKHR) * instances.size();
+        // 2. Host visible buffer 하나에 전부 serialize (copy 대상 주소는 256 bytes 정렬)
+        std::vector<VkDeviceSize> offsets(count);
+        VkDeviceSize totalSize = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            offsets[i] = totalSize;
+            totalSize = alignSerialized(totalSize + sizes[i]);
+        }
 
+        VkBuffer readbackBuffer;
+        LveAllocation readbackAllocation;
         lveDevice.createBuffer(
-            instanceBufferSize,
-            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
-            VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+            totalSize + SERIALIZED_ALIGNMENT,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            instanceBuffer,
-            instanceMemory
+            readbackBuffer,
+            readbackAllocation
         );
+        const VkDeviceAddress readbackAddress = getBufferAddress(readbackBuffer);
+        const VkDeviceAddress readbackBase = alignSerialized(readbackAddress);
+
+        commandBuffer = lveDevice.beginSingleTimeCommands();
+        if (profiler) profiler->beginImmediate(commandBuffer);
+        {
+            LveGpuProfiler::Scope scope{ profiler, commandBuffer, "as serialize" };
+            for (uint32_t i = 0; i < count; i++) {
+                VkCopyAccelerationStructureToMemoryInfoKHR copyInfo{};
+                copyInfo.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_TO_MEMORY_INFO_KHR;
+                copyInfo.src = structures[i];
+                copyInfo.dst.deviceAddress = readbackBase + offsets[i];
+                copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_SERIALIZE_KHR;
+                vkCmdCopyAccelerationStructureToMemoryKHR(commandBuffer, &copyInfo);
+            }
+        }
 
-        void* data;
-        vkMapMemory(lveDevice.device(), instanceMemory, 0, instanceBufferSize, 0, &data);
-        memcpy(data, instances.data(), instanceBufferSize);
-        vkUnmapMemory(lveDevice.device(), instanceMemory);
+        // Serialize 결과 → host 읽기
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
 
-        VkBufferDeviceAddressInfo bufferInfo{};
-        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
-        bufferInfo.buffer = instanceBuffer;
-        VkDeviceAddress instanceAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        lveDevice.endSingleTimeCommands(commandBuffer);
+        if (profiler) profiler->resolveImmediate();
 
-        // Setting Geometry
-        VkAccelerationStructureGeometryKHR geometry{};
-        geometry.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
-        geometry.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
-        geometry.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
-        geometry.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
-        geometry.geometry.instances.arrayOfPointers = VK_FALSE;
-        geometry.geometry.instances.data.deviceAddress = instanceAddress;
+        const char* mapped = static_cast<const char*>(readbackAllocation.mapped) + (readbackBase - readbackAddress);
+        for (uint32_t i = 0; i < count; i++) {
+            entries[i].data.assign(mapped + offsets[i], mapped + offsets[i] + sizes[i]);
+        }
+        lveDevice.destroyBuffer(readbackBuffer, readbackAllocation);
+
+        // 3. 파일 (driver / device UUID + scene hash가 key)
+        cacheKey.sceneHash = sceneHash;
+        LveAccelerationStructureCache{ cachePath }.save(cacheKey, entries);
+
+        float saveMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "Saved " << count << " acceleration structures to " << cachePath << ": "
+            << totalSize << " bytes in " << saveMs << " ms" << std::endl;
+    }
+
+    VkAccelerationStructureInstanceKHR LveAccelerationStructure::makeInstance(uint32_t index) const {
+        const SphereInfo& sphere = sphereInfos[index];
+
+        VkAccelerationStructureInstanceKHR instance{};
+
+        // Transform Matrix 설정 (3x4 row-major)
+        // VkTransformMatrixKHR는 [3][4] 배열
+        // | m[0][0]  m[0][1]  m[0][2]  m[0][3] |   | sx  0   0   tx |
+        // | m[1][0]  m[1][1]  m[1][2]  m[1][3] | = | 0   sy  0   ty |
+        // | m[2][0]  m[2][1]  m[2][2]  m[2][3] |   | 0   0   sz  tz |
+
+        float r = sphere.radius;
+        glm::vec3 c = sphere.center;
+
+        // 초기화 (0으로)
+        memset(&instance.transform, 0, sizeof(instance.transform));
+
+        // Scale (대각선)
+        instance.transform.matrix[0][0] = r;    // scale X
+        instance.transform.matrix[1][1] = r;    // scale Y
+        instance.transform.matrix[2][2] = r;    // scale Z
+
+        // Translation (마지막 열)
+        instance.transform.matrix[0][3] = c.x;  // translate X
+        instance.transform.matrix[1][3] = c.y;  // translate Y
+        instance.transform.matrix[2][3] = c.z;  // translate Z
+
+        instance.instanceCustomIndex = index;
+        instance.mask = 0xFF;
+        instance.instanceShaderBindingTableRecordOffset = hitGroupOffset(sphere);  // material별 hit group
+        instance.flags = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
+        instance.accelerationStructureReference = unitSphereBlasAddress;  // 모두 같은 BLAS!
+
+        // Mesh instance: 임의 transform (glm column-major → row-major 3x4) + mesh의 BLAS
+        if (sphere.meshId != 0) {
+            const glm::mat4& transform = meshTransforms.at(index);
+            for (int row = 0; row < 3; row++) {
+                for (int column = 0; column < 4; column++) {
+                    instance.transform.matrix[row][column] = transform[column][row];
+                }
+            }
+            assert(sphere.meshId <= meshBlases.size());
+            instance.accelerationStructureReference = meshBlases[sphere.meshId - 1].blasAddress;
+        }
+
+        return instance;
+    }
+
+    uint32_t LveAccelerationStructure::hitGroupOffset(const SphereInfo& sphere) const {
+        // traceRayEXT의 sbtRecordStride가 0이므로 hit record = instance offset 그대로
+        uint32_t material = static_cast<uint32_t>(std::max(sphere.materialType, 0.0f) + 0.5f);
+        material = material < hitGroupCount ? material : 0;
+
+        // Procedural 모드: AABB hit group에는 triangle이 안 맞으므로 mesh는 뒤쪽 triangle hit group
+        if (sphere.meshId != 0 && geometryMode == SphereGeometryMode::Procedural) {
+            return hitGroupCount + material;
+        }
+        return material;
+    }
+
+    void LveAccelerationStructure::writeInstance(uint32_t frameIndex, uint32_t index) {
+        FrameInstanceResources& frame = frameResources[frameIndex];
+        frame.mappedInstances[index] = makeInstance(index);
+        frame.mappedSphereInfos[index] = sphereInfos[index];
+    }
+
+    void LveAccelerationStructure::writeLights(uint32_t frameIndex) {
+        FrameInstanceResources& frame = frameResources[frameIndex];
+        const uint32_t lightCount = static_cast<uint32_t>(lightIndices.size());
+
+        frame.mappedLights[0] = lightCount;
+        frame.mappedLights[1] = 0;
+        frame.mappedLights[2] = 0;
+        frame.mappedLights[3] = 0;
+        if (lightCount > 0) {
+            memcpy(frame.mappedLights + LIGHT_BUFFER_HEADER_UINTS, lightIndices.data(), sizeof(uint32_t) * lightCount);
+        }
+        frame.writtenLightCount = lightCount;
+    }
+
+    void LveAccelerationStructure::createInstanceBuffers(uint32_t capacity) {
+        const uint32_t count = static_cast<uint32_t>(sphereInfos.size());
+        VkDeviceSize instanceBufferSize = sizeof(VkAccelerationStructureInstanceKHR) * capacity;
+        VkDeviceSize sphereInfoBufferSize = sizeof(SphereInfo) * capacity;
+
+        frameResources.resize(framesInFlight);
+
+        for (uint32_t f = 0; f < framesInFlight; f++) {
+            FrameInstanceResources& frame = frameResources[f];
+
+            // Instance Buffer (매 프레임 CPU가 dirty 항목만 덮어씀)
+            lveDevice.createBuffer(
+                instanceBufferSize,
+                VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+                VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                frame.instanceBuffer,
+                frame.instanceAllocation
+            );
+
+            frame.mappedInstances = static_cast<VkAccelerationStructureInstanceKHR*>(frame.instanceAllocation.mapped);
+            frame.instanceAddress = getBufferAddress(frame.instanceBuffer);
+
+            // Sphere Info Buffer
+            lveDevice.createBuffer(
+                sphereInfoBufferSize,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                frame.sphereInfoBuffer,
+                frame.sphereInfoAllocation
+            );
+
+            frame.mappedSphereInfos = static_cast<SphereInfo*>(frame.sphereInfoAllocation.mapped);
+
+            // Light Buffer (header + 구 index, 모든 구가 발광해도 들어가도록 capacity 기준)
+            lveDevice.createBuffer(
+                sizeof(uint32_t) * (LIGHT_BUFFER_HEADER_UINTS + static_cast<VkDeviceSize>(capacity)),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                frame.lightBuffer,
+                frame.lightAllocation
+            );
+
+            frame.mappedLights = static_cast<uint32_t*>(frame.lightAllocation.mapped);
+
+            // Sphere info는 GPU layout 그대로라 한 번에 복사, instance만 하나씩 변환
+            if (count > 0) {
+                memcpy(frame.mappedSphereInfos, sphereInfos.data(), sizeof(SphereInfo) * count);
+            }
+            for (uint32_t i = 0; i < count; i++) {
+                frame.mappedInstances[i] = makeInstance(i);
+            }
+            writeLights(f);
+            frame.pendingDirty.clear();
+        }
+
+        dirtyFrameMask.assign(count, 0);
+        instanceCapacity = capacity;
+
+        std::cout << "Instance buffers created: " << count << " / " << capacity
+            << " instances x " << framesInFlight << " frames" << std::endl;
+    }
+
+    void LveAccelerationStructure::destroyInstanceBuffers() {
+        for (FrameInstanceResources& frame : frameResources) {
+            lveDevice.destroyBuffer(frame.instanceBuffer, frame.instanceAllocation);
+            lveDevice.destroyBuffer(frame.sphereInfoBuffer, frame.sphereInfoAllocation);
+            lveDevice.destroyBuffer(frame.lightBuffer, frame.lightAllocation);
+        }
+        frameResources.clear();
+        dirtyFrameMask.clear();
+        instanceCapacity = 0;
+    }
+
+    VkDeviceSize LveAccelerationStructure::allocateTopLevelAS(uint32_t capacity) {
+        VkAccelerationStructureGeometryKHR geometry = makeInstanceGeometry(0);
 
-        // Build Info
         VkAccelerationStructureBuildGeometryInfoKHR buildInfo{};
         buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
         buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
-        buildInfo.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+        buildInfo.flags = TLAS_BUILD_FLAGS;
         buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
         buildInfo.geometryCount = 1;
         buildInfo.pGeometries = &geometry;
 
-        uint32_t primitiveCount = static_cast<uint32_t>(instances.size());
-
+        // capacity 기준 크기 - 개수가 줄거나 capacity 안에서 늘면 같은 TLAS에 다시 build
         VkAccelerationStructureBuildSizesInfoKHR sizeInfo{};
         sizeInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
         vkGetAccelerationStructureBuildSizesKHR(
             lveDevice.device(),
             VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
             &buildInfo,
-            &primitiveCount,
+            &capacity,
             &sizeInfo
         );
 
@@ -479,7 +1661,7 @@ namespace lve {
             VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
             topLevelASBuffer,
-            topLevelASMemory
+            topLevelASAllocation
         );
 
         VkAccelerationStructureCreateInfoKHR createInfo{};
@@ -490,38 +1672,196 @@ namespace lve {
 
         vkCreateAccelerationStructureKHR(lveDevice.device(), &createInfo, nullptr, &topLevelAS);
 
-        // Scratch Buffer
-        VkBuffer scratchBuffer;
-        VkDeviceMemory scratchMemory;
+        // Scratch Buffer (build/update 공용, TLAS와 함께 유지)
+        // sub-allocation은 buffer alignment만 보장 → BLAS arena처럼 여유를 두고 시작 주소를 정렬
+        const VkDeviceSize alignment = scratchOffsetAlignment;
         lveDevice.createBuffer(
-            sizeInfo.buildScratchSize,
+            std::max(sizeInfo.buildScratchSize, sizeInfo.updateScratchSize) + alignment,
             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            scratchBuffer,
-            scratchMemory
+            tlasScratchBuffer,
+            tlasScratchAllocation
         );
+        tlasScratchAddress = (getBufferAddress(tlasScratchBuffer) + alignment - 1) / alignment * alignment;
+        topLevelCompacted = false;
+
+        return sizeInfo.accelerationStructureSize;
+    }
+
+    void LveAccelerationStructure::destroyTopLevelAS() {
+        if (topLevelAS != VK_NULL_HANDLE) {
+            vkDestroyAccelerationStructureKHR(lveDevice.device(), topLevelAS, nullptr);
+            topLevelAS = VK_NULL_HANDLE;
+        }
+        lveDevice.destroyBuffer(topLevelASBuffer, topLevelASAllocation);
+        lveDevice.destroyBuffer(tlasScratchBuffer, tlasScratchAllocation);
+        tlasScratchAddress = 0;
+    }
 
-        bufferInfo.buffer = scratchBuffer;
-        VkDeviceAddress scratchAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+    void LveAccelerationStructure::recordTopLevelBuild(VkCommandBuffer commandBuffer, uint32_t frameIndex, bool update) {
+        VkAccelerationStructureGeometryKHR geometry =
+            makeInstanceGeometry(frameResources[frameIndex].instanceAddress);
 
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo{};
+        buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+        buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
+        buildInfo.flags = TLAS_BUILD_FLAGS;
+        buildInfo.mode = update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR
+            : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        buildInfo.srcAccelerationStructure = update ? topLevelAS : VK_NULL_HANDLE;
         buildInfo.dstAccelerationStructure = topLevelAS;
-        buildInfo.scratchData.deviceAddress = scratchAddress;
+        buildInfo.geometryCount = 1;
+        buildInfo.pGeometries = &geometry;
+        buildInfo.scratchData.deviceAddress = tlasScratchAddress;
 
         VkAccelerationStructureBuildRangeInfoKHR rangeInfo{};
-        rangeInfo.primitiveCount = primitiveCount;
+        rangeInfo.primitiveCount = static_cast<uint32_t>(sphereInfos.size());
 
         const VkAccelerationStructureBuildRangeInfoKHR* pRangeInfo = &rangeInfo;
+        vkCmdBuildAccelerationStructuresKHR(commandBuffer, 1, &buildInfo, &pRangeInfo);
+    }
+
+    void LveAccelerationStructure::resetRefitTracking() {
+        buildCenters.resize(sphereInfos.size());
+        for (size_t i = 0; i < sphereInfos.size(); i++) {
+            buildCenters[i] = sphereInfos[i].center;
+        }
+        displacementRatios.assign(sphereInfos.size(), 0.0f);
+        displacementSum = 0.0f;
+        refitsSinceBuild = 0;
+    }
+
+    void LveAccelerationStructure::createTopLevelAS() {
+        if (sphereInfos.empty()) {
+            throw std::runtime_error("No spheres to build TLAS!");
+        }
+
+        VkDeviceSize tlasSize = allocateTopLevelAS(instanceCapacity);
 
         VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
-        vkCmdBuildAccelerationStructuresKHR(commandBuffer, 1, &buildInfo, &pRangeInfo);
+        if (profiler) profiler->beginImmediate(commandBuffer);
+        vkCmdResetQueryPool(commandBuffer, compactionQueryPool, 0, 1);
+        {
+            LveGpuProfiler::Scope scope{ profiler, commandBuffer, "tlas build" };
+            recordTopLevelBuild(commandBuffer, 0, false);
+        }
+        recordCompactedSizeQuery(commandBuffer, &topLevelAS, 1);
         lveDevice.endSingleTimeCommands(commandBuffer);
+        if (profiler) profiler->resolveImmediate();
+
+        // 정적 씬이면 compact 상태로 유지 (첫 refit/rebuild 때 full size로 재할당)
+        if (compactionSettings.topLevel) {
+            compactAccelerationStructure(
+                "TLAS",
+                VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR,
+                tlasSize,
+                topLevelAS,
+                topLevelASBuffer,
+                topLevelASAllocation
+            );
+            topLevelCompacted = true;
+        }
+
+        builtInstanceCount = static_cast<uint32_t>(sphereInfos.size());
+        builtVersion = instanceVersion;
+        resetRefitTracking();
+
+        std::cout << "TLAS created with " << builtInstanceCount << " instances (all sharing 1 BLAS)" << std::endl;
+    }
 
-        vkDestroyBuffer(lveDevice.device(), scratchBuffer, nullptr);
-        vkFreeMemory(lveDevice.device(), scratchMemory, nullptr);
-        vkDestroyBuffer(lveDevice.device(), instanceBuffer, nullptr);
-        vkFreeMemory(lveDevice.device(), instanceMemory, nullptr);
+    bool LveAccelerationStructure::updateInstances(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+        const uint32_t count = static_cast<uint32_t>(sphereInfos.size());
+        const bool countChanged = count != builtInstanceCount;
+        bool resourcesRecreated = false;
+
+        if (count > instanceCapacity) {
+            // capacity 초과: 사용 중인 TLAS/버퍼를 바꿔야 하므로 GPU idle 후 재할당
+            vkDeviceWaitIdle(lveDevice.device());
+            uint32_t newCapacity = std::max(count, instanceCapacity * 2);
+
+            destroyInstanceBuffers();
+            destroyTopLevelAS();
+            createInstanceBuffers(newCapacity);
+            allocateTopLevelAS(newCapacity);
+            resourcesRecreated = true;
+        }
+        else {
+            if (countChanged) {
+                // capacity 안에서 개수만 변경: 새 인스턴스를 모든 frame 버퍼에 기록 예약
+                uint32_t previousCount = static_cast<uint32_t>(dirtyFrameMask.size());
+                dirtyFrameMask.resize(count, 0);
+                for (uint32_t i = previousCount; i < count; i++) {
+                    markDirty(i);
+                }
+            }
+
+            if (topLevelCompacted && builtVersion != instanceVersion) {
+                // Compacted TLAS는 refit/재빌드 공간이 없음: 한 번만 full size로 재할당
+                vkDeviceWaitIdle(lveDevice.device());
+                destroyTopLevelAS();
+                allocateTopLevelAS(instanceCapacity);
+                resourcesRecreated = true;
+            }
+        }
+
+        // 이 frame 버퍼에 밀린 dirty 인스턴스만 기록
+        FrameInstanceResources& frame = frameResources[frameIndex];
+        for (uint32_t index : frame.pendingDirty) {
+            if (index < count) {
+                writeInstance(frameIndex, index);
+            }
+            dirtyFrameMask[index] &= ~(1u << frameIndex);
+        }
+        frame.pendingDirty.clear();
+
+        // 발광 구는 추가만 되므로 개수로 비교
+        if (frame.writtenLightCount != lightIndices.size()) {
+            writeLights(frameIndex);
+        }
+
+        if (builtVersion == instanceVersion && !resourcesRecreated) {
+            return false;
+        }
+
+        const float meanDisplacement = count > 0 ? displacementSum / static_cast<float>(count) : 0.0f;
+        const bool fullRebuild = countChanged || resourcesRecreated ||
+            refitsSinceBuild >= tlasUpdateSettings.maxRefitsBeforeRebuild ||
+            meanDisplacement > tlasUpdateSettings.maxDisplacementRatio;
+
+        // 이전 프레임의 trace / build가 TLAS를 다 쓴 뒤에 수정
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        {
+            LveGpuProfiler::Scope scope{ profiler, commandBuffer, fullRebuild ? "tlas rebuild" : "tlas refit" };
+            recordTopLevelBuild(commandBuffer, frameIndex, !fullRebuild);
+        }
+
+        // Build 결과 → trace에서 읽기
+        barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        builtVersion = instanceVersion;
+        builtInstanceCount = count;
+
+        if (fullRebuild) {
+            resetRefitTracking();
+        }
+        else {
+            refitsSinceBuild++;
+        }
 
-        std::cout << "TLAS created with " << instances.size() << " instances (all sharing 1 BLAS)" << std::endl;
+        return resourcesRecreated;
     }
 
 } // namespace lve
\ No newline at end of file
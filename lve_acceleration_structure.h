@@ -1,6 +1,13 @@
 ﻿#pragma once
 
 #include "lve_device.h"
+#include "lve_acceleration_structure_cache.h"
+#include "lve_gpu_profiler.h"
+#include "lve_mesh_library.h"
+#include "lve_thread_pool.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -18,14 +25,59 @@ namespace lve {
         float padding[2];    // Alignment to 16 bytes
     };
 
+    // SphereInfo::materialType (= LveMaterialRegistry 기본 material id)
+    constexpr float MATERIAL_LAMBERTIAN = 0.0f;
+    constexpr float MATERIAL_METAL = 1.0f;
+    constexpr float MATERIAL_DIELECTRIC = 2.0f;
+    constexpr float MATERIAL_EMISSIVE = 3.0f;   // 구 area light: radiance = color * materialParam
+
     // Sphere info for shader (std430 layout compatible)
     struct SphereInfo {
         glm::vec3 center;
         float radius;
         glm::vec3 color;
         float materialType;
-        float materialParam;
-        float padding[3];  // Align to 16 bytes (48 bytes total)
+        float materialParam;  // Metal: fuzz, Dielectric: refraction index, Emissive: intensity
+        uint32_t meshId;      // 0 = 구, 그 외 LveMeshHandle (center / radius는 mesh bounding sphere)
+        float padding[2];  // Align to 16 bytes (48 bytes total)
+    };
+
+    // Light buffer (binding 9, std430): uint count, 3 × padding, uint sphereIndices[]
+    constexpr uint32_t LIGHT_BUFFER_HEADER_UINTS = 4;
+
+    // TLAS refit/rebuild 정책 (애니메이션 인스턴스용)
+    struct TlasUpdateSettings {
+        // 연속 refit 허용 횟수 - 넘으면 full rebuild
+        uint32_t maxRefitsBeforeRebuild = 240;
+        // 마지막 build 이후 평균 이동량 / 반지름 - BVH 품질 저하 추정치, 넘으면 full rebuild
+        float maxDisplacementRatio = 4.0f;
+    };
+
+    // Compaction 설정 (build 후 compacted size로 복사하고 원본 해제)
+    struct CompactionSettings {
+        bool bottomLevel = true;
+        // TLAS는 정적 씬에서만 이득 - refit/rebuild가 필요해지면 full size로 한 번 재할당
+        bool topLevel = true;
+    };
+
+    // BLAS batch build 설정 (build 요청을 모아 command buffer 하나, submit 하나로)
+    struct BlasBatchSettings {
+        // chunk 하나의 scratch 합 상한: chunk 안의 build는 vkCmdBuildAccelerationStructuresKHR 한 번,
+        // chunk 사이에 barrier를 두고 arena를 재사용 (arena 크기 = 가장 큰 chunk)
+        VkDeviceSize scratchBudget = 256ull * 1024 * 1024;
+    };
+
+    // AS별 compaction 전/후 크기
+    struct AccelerationStructureMemoryInfo {
+        std::string name;
+        VkDeviceSize originalSize = 0;
+        VkDeviceSize compactedSize = 0;
+    };
+
+    // 구 BLAS geometry 방식
+    enum class SphereGeometryMode {
+        Triangles,   // 테셀레이션된 단위 구 (vertex/index buffer)
+        Procedural   // AABB + intersection shader (정확한 실루엣)
     };
 
     // Structure storing mesh data (단위 구 하나만 사용)
@@ -33,19 +85,44 @@ namespace lve {
         std::vector<Vertex> vertices;
         std::vector<uint32_t> indices;
 
+        // Procedural geometry (비어있지 않으면 vertices/indices 대신 AABB로 BLAS 생성)
+        std::vector<VkAabbPositionsKHR> aabbs;
+
         VkBuffer vertexBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory vertexBufferMemory = VK_NULL_HANDLE;
+        LveAllocation vertexBufferAllocation{};
+        VkBuffer indexBuffer = VK_NULL_HANDLE;
+        LveAllocation indexBufferAllocation{};
+        VkBuffer aabbBuffer = VK_NULL_HANDLE;
+        LveAllocation aabbBufferAllocation{};
+
+        VkAccelerationStructureKHR bottomLevelAS = VK_NULL_HANDLE;
+        VkBuffer bottomLevelASBuffer = VK_NULL_HANDLE;
+        LveAllocation bottomLevelASAllocation{};
+    };
+
+    // LveMeshLibrary mesh 하나의 GPU 자원 (handle마다 하나, 같은 mesh의 instance가 모두 공유)
+    struct MeshBlas {
+        VkBuffer vertexBuffer = VK_NULL_HANDLE;  // LveMeshVertex (closest hit이 device address로 읽음)
+        LveAllocation vertexBufferAllocation{};
         VkBuffer indexBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory indexBufferMemory = VK_NULL_HANDLE;
+        LveAllocation indexBufferAllocation{};
 
         VkAccelerationStructureKHR bottomLevelAS = VK_NULL_HANDLE;
         VkBuffer bottomLevelASBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory bottomLevelASMemory = VK_NULL_HANDLE;
+        LveAllocation bottomLevelASAllocation{};
+        VkDeviceAddress blasAddress = 0;
+    };
+
+    // Mesh table (binding 13, std430): mesh id - 1 → vertex / index buffer device address
+    struct MeshTableEntry {
+        VkDeviceAddress vertexAddress;
+        VkDeviceAddress indexAddress;
     };
 
     class LveAccelerationStructure {
     public:
-        LveAccelerationStructure(LveDevice& device);
+        LveAccelerationStructure(LveDevice& device, uint32_t framesInFlight = 1,
+            SphereGeometryMode geometryMode = SphereGeometryMode::Triangles);
         ~LveAccelerationStructure();
 
         LveAccelerationStructure(const LveAccelerationStructure&) = delete;
@@ -56,48 +133,259 @@ namespace lve {
             float materialType = 0.0f, float materialParam = 0.0f,
             int segments = 32, int rings = 16);
 
+        // 발광 구 (NEE light list에 등록, 다른 구를 비추는 area light)
+        void addEmissiveSphere(const glm::vec3& center, const glm::vec3& color, float radius, float intensity);
+
+        // SphereInfo table 통째로 추가 (scene 파일 mmap 그대로, 요소별 변환 없음)
+        // lightIndices는 spheres 안의 index (발광 구 목록을 다시 찾지 않음)
+        void addSpheres(const SphereInfo* spheres, uint32_t count, const uint32_t* lightIndices, uint32_t lightCount);
+
+        // Triangle mesh instance: library의 mesh를 임의 transform으로 배치, 반환값은 instance index
+        // - library는 build 전에 설정, AS보다 오래 살아야 함 (unique mesh마다 BLAS 하나)
+        // - 발광 mesh는 NEE light 목록에 넣지 않음 (BSDF sampling으로만 맞음)
+        void setMeshLibrary(const LveMeshLibrary* library) { meshLibrary = library; }
+        uint32_t addMeshInstance(LveMeshHandle mesh, const glm::mat4& transform, const glm::vec3& color,
+            float materialType = 0.0f, float materialParam = 0.0f);
+        uint32_t getMeshInstanceCount() const { return static_cast<uint32_t>(meshTransforms.size()); }
+
         // Acceleration Structure build
         void buildAccelerationStructures();
 
+        // 구 위치/크기 변경 (dirty 표시만, GPU 반영은 updateInstances에서)
+        // mesh instance는 center로 이동, radius 비율로 transform 전체를 scale
+        void setSphereTransform(uint32_t index, const glm::vec3& center, float radius);
+        const SphereInfo& getSphereInfo(uint32_t index) const { return sphereInfos[index]; }
+        const std::vector<SphereInfo>& getSphereInfos() const { return sphereInfos; }
+        const std::vector<uint32_t>& getLightIndices() const { return lightIndices; }
+
+        // dirty 인스턴스를 frame 버퍼에 반영하고 TLAS refit/rebuild를 frame command buffer에 기록
+        // 반환값: TLAS 또는 SphereInfo 버퍼가 재생성됨 (descriptor 갱신 필요)
+        bool updateInstances(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+        void setTlasUpdateSettings(const TlasUpdateSettings& settings) { tlasUpdateSettings = settings; }
+        void setCompactionSettings(const CompactionSettings& settings) { compactionSettings = settings; }
+        void setBlasBatchSettings(const BlasBatchSettings& settings) { blasBatchSettings = settings; }
+
+        // Disk 캐시 파일 (비어있으면 사용 안 함). 첫 build 전에 설정
+        // 장면 / GPU / 드라이버가 같으면 BLAS / TLAS를 build 대신 deserialize, 아니면 build 후 serialize해서 저장
+        void setCachePath(const std::string& path) { cachePath = path; }
+
+        // BLAS를 CPU에서 build (vkBuildAccelerationStructuresKHR + deferred operation을 thread pool이 join)
+        // accelerationStructureHostCommands 미지원이면 device build 유지. TLAS는 매 frame refit하므로 항상 device
+        void setHostBuilds(bool enabled);
+
+        // build / refit / compaction 구간 GPU 시간 측정 (nullptr이면 측정 안 함)
+        void setProfiler(LveGpuProfiler* gpuProfiler) { profiler = gpuProfiler; }
+
+        // SBT hit record 수 (= LveMaterialRegistry material 수). build 전에 설정
+        // instance마다 instanceShaderBindingTableRecordOffset = materialType (범위 밖이면 0)
+        // procedural 모드의 mesh instance는 그 뒤의 triangle hit group (count + materialType)
+        void setHitGroupCount(uint32_t count) { hitGroupCount = count > 0 ? count : 1; }
+
+        // Compaction 메모리 리포트
+        const std::vector<AccelerationStructureMemoryInfo>& getMemoryReport() const { return memoryReport; }
+        void printMemoryReport() const;
+
         VkAccelerationStructureKHR getTLAS() const { return topLevelAS; }
+        SphereGeometryMode getGeometryMode() const { return geometryMode; }
 
-        // Sphere info buffer for shader access
-        VkBuffer getSphereInfoBuffer() const { return sphereInfoBuffer; }
+        // Sphere info buffer for shader access (frame in flight별)
+        VkBuffer getSphereInfoBuffer(uint32_t frameIndex) const { return frameResources[frameIndex].sphereInfoBuffer; }
         uint32_t getSphereCount() const { return static_cast<uint32_t>(sphereInfos.size()); }
 
+        // 발광 구 index 목록 (frame in flight별, closest-hit의 NEE용)
+        VkBuffer getLightBuffer(uint32_t frameIndex) const { return frameResources[frameIndex].lightBuffer; }
+        uint32_t getLightCount() const { return static_cast<uint32_t>(lightIndices.size()); }
+
+        // Mesh table (모든 frame 공유, mesh가 없어도 항목 하나로 생성)
+        VkBuffer getMeshTableBuffer() const { return meshTableBuffer; }
+
     private:
         // Helper function for sphere mesh (단위 구 생성용)
         MeshData createSphereMeshData(int segments, int rings);
 
+        // 단위 구를 감싸는 AABB 하나 (procedural 모드)
+        MeshData createSphereAabbData();
+
         // Upload mesh to GPU buffer
         void uploadMeshToGPU(MeshData& mesh);
 
-        // Create BLAS for unit sphere (하나만!)
-        void createBottomLevelAS(MeshData& mesh);
+        // BLAS 하나의 build 요청 (결과 AS / buffer는 pointer가 가리키는 곳에 생성)
+        struct BlasBuildRequest {
+            std::string name;
+            VkAccelerationStructureGeometryKHR geometry{};
+            uint32_t primitiveCount = 0;
+            VkAccelerationStructureKHR* accelerationStructure = nullptr;
+            VkBuffer* buffer = nullptr;
+            LveAllocation* allocation = nullptr;
+
+            // Host build 입력 (geometry의 device address와 같은 데이터, AABB면 hostVertexData만)
+            const void* hostVertexData = nullptr;
+            const void* hostIndexData = nullptr;
+
+            // buildBottomLevelASBatch가 채움
+            VkAccelerationStructureBuildSizesInfoKHR sizeInfo{};
+            VkDeviceSize finalSize = 0;  // compaction 후 크기 (안 하면 accelerationStructureSize)
+        };
+
+        // Build requests for unit sphere BLAS (하나만!)
+        BlasBuildRequest makeUnitSphereBuild(MeshData& mesh);
+        void finishUnitSphereBlas(const BlasBuildRequest& build);  // BLAS 주소 + 메모리 로그
+
+        // 요청 전부를 scratch arena 하나로 한 번에 build (+ batch compaction), 총 시간 출력
+        void buildBottomLevelASBatch(std::vector<BlasBuildRequest>& requests);
+
+        // 같은 batch를 host에서: build 하나를 worker thread가 나눠 실행, compaction은 device copy (device local로 이동)
+        void buildBottomLevelASBatchOnHost(std::vector<BlasBuildRequest>& requests);
+
+        // 아직 BLAS가 없는 library mesh 업로드 + build 요청 추가, build 후 주소 / 통계, mesh table 재생성
+        void appendMeshBuilds(std::vector<BlasBuildRequest>& requests);
+        void finishMeshBlases(uint32_t firstMesh, const BlasBuildRequest* builds);
+        void createMeshTable();
+
+        // Disk 캐시: 장면 해시 → 파일 / blob 호환성 / TLAS handle 검증 (cachedStructures 채움) → deserialize
+        // 검증이 하나라도 실패하면 false (평소대로 build 후 writeCache)
+        struct DeserializeTarget {
+            const LveSerializedAccelerationStructure* entry = nullptr;
+            VkAccelerationStructureTypeKHR type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+            VkAccelerationStructureKHR* accelerationStructure = nullptr;
+            VkBuffer* buffer = nullptr;
+            LveAllocation* allocation = nullptr;
+        };
+        uint64_t computeSceneHash() const;
+        bool readCache(uint64_t sceneHash, size_t blasCount);
+        void deserializeAccelerationStructures(const std::vector<DeserializeTarget>& targets, const std::string& scopeName);
+        void deserializeBottomLevelAS(std::vector<BlasBuildRequest>& requests);
+        void deserializeTopLevelAS();  // BLAS 주소가 정해진 뒤 (TLAS의 BLAS handle을 새 주소로 교체)
+        void writeCache(uint64_t sceneHash, const std::vector<BlasBuildRequest>& requests);
 
-        // Create TLAS with instancing
+        // Create TLAS with instancing (persistent, ALLOW_UPDATE)
         void createTopLevelAS();
+        VkDeviceSize allocateTopLevelAS(uint32_t capacity);  // 반환: full TLAS 크기
 
-        // Create sphere info buffer for shader
-        void createSphereInfoBuffer();
+        // Create per-frame instance / sphere info buffers (persistently mapped)
+        void createInstanceBuffers(uint32_t capacity);
+        void destroyInstanceBuffers();
+        void destroyTopLevelAS();
+
+        VkAccelerationStructureInstanceKHR makeInstance(uint32_t index) const;
+        uint32_t hitGroupOffset(const SphereInfo& sphere) const;
+        void writeInstance(uint32_t frameIndex, uint32_t index);
+        void writeLights(uint32_t frameIndex);
+        void markDirty(uint32_t index);
+
+        // TLAS build/refit 기록 (frameIndex의 instance buffer 사용)
+        void recordTopLevelBuild(VkCommandBuffer commandBuffer, uint32_t frameIndex, bool update);
+        void resetRefitTracking();
+
+        VkDeviceAddress getBufferAddress(VkBuffer buffer);
+
+        // Compaction: build command buffer에 size query 기록 (query i = structures[i]) → 결과 읽고 compact copy
+        struct CompactionTarget {
+            std::string name;
+            VkAccelerationStructureTypeKHR type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+            VkDeviceSize originalSize = 0;
+            VkAccelerationStructureKHR* accelerationStructure = nullptr;
+            VkBuffer* buffer = nullptr;
+            LveAllocation* allocation = nullptr;
+        };
+        void ensureCompactionQueries(uint32_t count);
+        void recordCompactedSizeQuery(VkCommandBuffer commandBuffer, const VkAccelerationStructureKHR* structures, uint32_t count);
+        std::vector<VkDeviceSize> compactAccelerationStructures(const std::vector<CompactionTarget>& targets);  // copy는 submit 하나
+        void compactAccelerationStructures(
+            const std::vector<CompactionTarget>& targets, const std::vector<VkDeviceSize>& compactedSizes);  // size를 이미 앎
+        void compactAccelerationStructure(
+            const std::string& name,
+            VkAccelerationStructureTypeKHR type,
+            VkDeviceSize originalSize,
+            VkAccelerationStructureKHR& accelerationStructure,
+            VkBuffer& buffer,
+            LveAllocation& allocation);
 
         LveDevice& lveDevice;
+        uint32_t framesInFlight;
+        SphereGeometryMode geometryMode;
+        LveGpuProfiler* profiler = nullptr;
+        uint32_t hitGroupCount = 1;
 
         // 단위 구 BLAS (원점, 반지름 1) - 하나만!
         MeshData unitSphereMesh;
         bool unitSphereCreated = false;
+        VkDeviceAddress unitSphereBlasAddress = 0;
+
+        // Triangle mesh (unique mesh마다 BLAS 하나, index = handle - 1)
+        const LveMeshLibrary* meshLibrary = nullptr;
+        std::vector<MeshBlas> meshBlases;
+        std::unordered_map<uint32_t, glm::mat4> meshTransforms;  // mesh instance index → object-to-world
+        VkBuffer meshTableBuffer = VK_NULL_HANDLE;
+        LveAllocation meshTableAllocation{};
 
         // 모든 구의 정보 (위치, 크기, 재질 등)
         std::vector<SphereInfo> sphereInfos;
+        std::vector<uint32_t> lightIndices;  // materialType == MATERIAL_EMISSIVE인 구
 
-        // Top-Level Acceleration Structure
+        // Top-Level Acceleration Structure (capacity 기준으로 할당, 재사용)
         VkAccelerationStructureKHR topLevelAS = VK_NULL_HANDLE;
         VkBuffer topLevelASBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory topLevelASMemory = VK_NULL_HANDLE;
+        LveAllocation topLevelASAllocation{};
+        VkBuffer tlasScratchBuffer = VK_NULL_HANDLE;
+        LveAllocation tlasScratchAllocation{};
+        VkDeviceAddress tlasScratchAddress = 0;
+
+        // Frame in flight별 instance / sphere info 버퍼 (GPU가 이전 프레임을 읽는 동안 덮어쓰지 않도록)
+        struct FrameInstanceResources {
+            VkBuffer instanceBuffer = VK_NULL_HANDLE;
+            LveAllocation instanceAllocation{};
+            VkAccelerationStructureInstanceKHR* mappedInstances = nullptr;
+            VkDeviceAddress instanceAddress = 0;
+
+            VkBuffer sphereInfoBuffer = VK_NULL_HANDLE;
+            LveAllocation sphereInfoAllocation{};
+            SphereInfo* mappedSphereInfos = nullptr;
+
+            // Light buffer (capacity 기준, 구가 추가될 때만 다시 씀)
+            VkBuffer lightBuffer = VK_NULL_HANDLE;
+            LveAllocation lightAllocation{};
+            uint32_t* mappedLights = nullptr;
+            uint32_t writtenLightCount = 0;
+
+            std::vector<uint32_t> pendingDirty;  // 이 frame 버퍼에 아직 안 쓴 인스턴스
+        };
+        std::vector<FrameInstanceResources> frameResources;
+        std::vector<uint32_t> dirtyFrameMask;    // 인스턴스별: 아직 갱신 안 된 frame 비트
+
+        uint32_t instanceCapacity = 0;
+        uint32_t builtInstanceCount = 0;
+
+        // BLAS batch build
+        BlasBatchSettings blasBatchSettings{};
+        VkDeviceSize scratchOffsetAlignment = 1;  // minAccelerationStructureScratchOffsetAlignment
+
+        // Host build
+        bool hostBuilds = false;
+        std::unique_ptr<LveThreadPool> hostBuildThreads;  // setHostBuilds(true)에서 생성, build마다 재사용
+
+        // Disk 캐시
+        std::string cachePath;
+        LveAccelerationStructureCacheKey cacheKey{};                       // UUID는 생성자, sceneHash는 첫 build
+        std::vector<LveSerializedAccelerationStructure> cachedStructures;  // BLAS (요청 순서) + 마지막 TLAS
+        std::vector<uint32_t> cachedHandleTargets;                         // TLAS blob의 handle i → BLAS 번호
+
+        // Compaction
+        CompactionSettings compactionSettings{};
+        VkQueryPool compactionQueryPool = VK_NULL_HANDLE;
+        uint32_t compactionQueryCapacity = 1;
+        bool topLevelCompacted = false;
+        std::vector<AccelerationStructureMemoryInfo> memoryReport;
 
-        // Sphere info buffer
-        VkBuffer sphereInfoBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory sphereInfoMemory = VK_NULL_HANDLE;
+        // Refit 추적
+        TlasUpdateSettings tlasUpdateSettings{};
+        uint64_t instanceVersion = 0;            // CPU 상태 버전 (setSphereTransform마다 증가)
+        uint64_t builtVersion = 0;               // TLAS에 반영된 버전
+        uint32_t refitsSinceBuild = 0;
+        std::vector<glm::vec3> buildCenters;     // 마지막 full build 시점의 중심
+        std::vector<float> displacementRatios;   // |center - buildCenter| / radius
+        float displacementSum = 0.0f;
 
         // Ray Tracing function pointers
         PFN_vkGetBufferDeviceAddressKHR vkGetBufferDeviceAddressKHR;
@@ -106,6 +394,18 @@ namespace lve {
         PFN_vkGetAccelerationStructureBuildSizesKHR vkGetAccelerationStructureBuildSizesKHR;
         PFN_vkCmdBuildAccelerationStructuresKHR vkCmdBuildAccelerationStructuresKHR;
         PFN_vkGetAccelerationStructureDeviceAddressKHR vkGetAccelerationStructureDeviceAddressKHR;
+        PFN_vkCmdWriteAccelerationStructuresPropertiesKHR vkCmdWriteAccelerationStructuresPropertiesKHR;
+        PFN_vkCmdCopyAccelerationStructureKHR vkCmdCopyAccelerationStructureKHR;
+        PFN_vkCmdCopyAccelerationStructureToMemoryKHR vkCmdCopyAccelerationStructureToMemoryKHR;
+        PFN_vkCmdCopyMemoryToAccelerationStructureKHR vkCmdCopyMemoryToAccelerationStructureKHR;
+        PFN_vkGetDeviceAccelerationStructureCompatibilityKHR vkGetDeviceAccelerationStructureCompatibilityKHR;
+        PFN_vkBuildAccelerationStructuresKHR vkBuildAccelerationStructuresKHR;
+        PFN_vkWriteAccelerationStructuresPropertiesKHR vkWriteAccelerationStructuresPropertiesKHR;
+        PFN_vkCreateDeferredOperationKHR vkCreateDeferredOperationKHR;
+        PFN_vkDestroyDeferredOperationKHR vkDestroyDeferredOperationKHR;
+        PFN_vkGetDeferredOperationMaxConcurrencyKHR vkGetDeferredOperationMaxConcurrencyKHR;
+        PFN_vkDeferredOperationJoinKHR vkDeferredOperationJoinKHR;
+        PFN_vkGetDeferredOperationResultKHR vkGetDeferredOperationResultKHR;
     };
 
 } // namespace lve
\ No newline at end of file
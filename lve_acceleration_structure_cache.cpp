@@ -0,0 +1,154 @@
+#include "lve_acceleration_structure_cache.h"
+
+// std
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace lve {
+
+    namespace {
+        constexpr char CACHE_MAGIC[4] = { 'L', 'V', 'A', 'C' };
+
+        struct CacheFileHeader {
+            char magic[4];
+            uint32_t version;
+            uint8_t driverUUID[VK_UUID_SIZE];
+            uint8_t deviceUUID[VK_UUID_SIZE];
+            uint64_t sceneHash;
+            uint32_t entryCount;
+            uint32_t reserved[3];
+        };
+        static_assert(sizeof(CacheFileHeader) == 64, "cache file header must stay 64 bytes");
+
+        struct CacheFileEntry {
+            uint64_t originalAddress;
+            uint64_t size;
+        };
+
+        uint64_t readBlobWord(const LveSerializedAccelerationStructure& entry, size_t offset) {
+            if (entry.data.size() < offset + sizeof(uint64_t)) return 0;
+            uint64_t value = 0;
+            memcpy(&value, entry.data.data() + offset, sizeof(value));
+            return value;
+        }
+    }
+
+    bool LveAccelerationStructureCache::load(
+        const LveAccelerationStructureCacheKey& key, std::vector<LveSerializedAccelerationStructure>& entries) const {
+        entries.clear();
+
+        std::ifstream file{ path, std::ios::ate | std::ios::binary };
+        if (!file.is_open()) {
+            std::cout << "Acceleration structure cache " << path << " not found, building" << std::endl;
+            return false;
+        }
+        const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+
+        CacheFileHeader header{};
+        if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != VERSION) {
+            std::cout << "Acceleration structure cache " << path << " has an unknown format, rebuilding" << std::endl;
+            return false;
+        }
+        if (memcmp(header.driverUUID, key.driverUUID, VK_UUID_SIZE) != 0 ||
+            memcmp(header.deviceUUID, key.deviceUUID, VK_UUID_SIZE) != 0) {
+            std::cout << "Acceleration structure cache " << path << " is from another device or driver, rebuilding" << std::endl;
+            return false;
+        }
+        if (header.sceneHash != key.sceneHash) {
+            std::cout << "Acceleration structure cache " << path << " is for another scene, rebuilding" << std::endl;
+            return false;
+        }
+
+        // entry table + blob 크기가 파일 안에 들어가는지 먼저 확인 (잘린 파일에 거대한 할당 방지)
+        uint64_t expectedSize = sizeof(header) + sizeof(CacheFileEntry) * static_cast<uint64_t>(header.entryCount);
+        std::vector<CacheFileEntry> table;
+        if (fileSize >= expectedSize) {
+            table.resize(header.entryCount);
+        }
+        if (fileSize < expectedSize ||
+            !file.read(reinterpret_cast<char*>(table.data()), sizeof(CacheFileEntry) * table.size())) {
+            std::cout << "Acceleration structure cache " << path << " is truncated, rebuilding" << std::endl;
+            return false;
+        }
+        // 합이 overflow해서 fileSize로 되돌아오지 않도록 entry마다 남은 크기와 비교
+        bool entriesFit = true;
+        for (const CacheFileEntry& entry : table) {
+            if (entry.size > fileSize - expectedSize) {
+                entriesFit = false;
+                break;
+            }
+            expectedSize += entry.size;
+        }
+        if (!entriesFit || fileSize != expectedSize) {
+            std::cout << "Acceleration structure cache " << path << " is truncated, rebuilding" << std::endl;
+            return false;
+        }
+
+        entries.resize(table.size());
+        for (size_t i = 0; i < table.size(); i++) {
+            entries[i].originalAddress = table[i].originalAddress;
+            entries[i].data.resize(static_cast<size_t>(table[i].size));
+            if (!file.read(reinterpret_cast<char*>(entries[i].data.data()), entries[i].data.size())) {
+                std::cout << "Acceleration structure cache " << path << " could not be read, rebuilding" << std::endl;
+                entries.clear();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void LveAccelerationStructureCache::save(
+        const LveAccelerationStructureCacheKey& key, const std::vector<LveSerializedAccelerationStructure>& entries) const {
+        CacheFileHeader header{};
+        memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = VERSION;
+        memcpy(header.driverUUID, key.driverUUID, VK_UUID_SIZE);
+        memcpy(header.deviceUUID, key.deviceUUID, VK_UUID_SIZE);
+        header.sceneHash = key.sceneHash;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+
+        std::vector<CacheFileEntry> table(entries.size());
+        for (size_t i = 0; i < entries.size(); i++) {
+            table[i].originalAddress = entries[i].originalAddress;
+            table[i].size = entries[i].data.size();
+        }
+
+        // 쓰다가 죽어도 기존 파일이 깨지지 않도록 임시 파일 → rename
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file{ tempPath, std::ios::binary | std::ios::trunc };
+            if (!file) {
+                std::cerr << "failed to write acceleration structure cache: " << tempPath << std::endl;
+                return;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(table.data()), sizeof(CacheFileEntry) * table.size());
+            for (const LveSerializedAccelerationStructure& entry : entries) {
+                file.write(reinterpret_cast<const char*>(entry.data.data()), entry.data.size());
+            }
+            if (!file) {
+                std::cerr << "failed to write acceleration structure cache: " << tempPath << std::endl;
+                return;
+            }
+        }
+
+        std::remove(path.c_str());
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            std::cerr << "failed to write acceleration structure cache: " << path << std::endl;
+        }
+    }
+
+    uint64_t LveAccelerationStructureCache::deserializedSize(const LveSerializedAccelerationStructure& entry) {
+        return readBlobWord(entry, 2 * VK_UUID_SIZE + sizeof(uint64_t));
+    }
+
+    uint64_t LveAccelerationStructureCache::handleCount(const LveSerializedAccelerationStructure& entry) {
+        return readBlobWord(entry, 2 * VK_UUID_SIZE + 2 * sizeof(uint64_t));
+    }
+
+}  // namespace lve
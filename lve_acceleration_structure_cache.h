@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+// std lib headers
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+    // 캐시 파일이 유효한 조건: 같은 드라이버 / 같은 GPU / 같은 장면 (build 입력 전체의 해시)
+    struct LveAccelerationStructureCacheKey {
+        uint8_t driverUUID[VK_UUID_SIZE];  // VkPhysicalDeviceIDProperties
+        uint8_t deviceUUID[VK_UUID_SIZE];
+        uint64_t sceneHash = 0;
+    };
+
+    // Serialize된 AS 하나 (VK_COPY_ACCELERATION_STRUCTURE_MODE_SERIALIZE_KHR 결과 그대로)
+    struct LveSerializedAccelerationStructure {
+        uint64_t originalAddress = 0;  // 저장 시점 BLAS 주소 (TLAS가 참조하는 handle을 새 주소로 바꿀 때 사용, TLAS는 0)
+        std::vector<uint8_t> data;
+    };
+
+    // Disk에 저장되는 acceleration structure 캐시 (파일 하나 = 장면 하나, 다른 장면이면 덮어씀)
+    // [header 64 bytes][{originalAddress, size} × entryCount][blob × entryCount]
+    // - header의 UUID / scene hash가 다르면 읽지 않음 → 호출 쪽이 새로 build 후 save
+    // - blob 안의 호환성 (driver가 정의한 version data)은 vkGetDeviceAccelerationStructureCompatibilityKHR로 따로 확인
+    class LveAccelerationStructureCache {
+    public:
+        static constexpr const char* DEFAULT_PATH = "accel_cache.bin";
+        static constexpr uint32_t VERSION = 1;
+
+        // Serialized data header (Vulkan spec): driver UUID, compatibility UUID, serialized size,
+        // deserialized size, BLAS handle 개수, 그 뒤에 handle (uint64) 배열
+        static constexpr size_t BLOB_HEADER_SIZE = 2 * VK_UUID_SIZE + 3 * sizeof(uint64_t);
+
+        explicit LveAccelerationStructureCache(const std::string& path = DEFAULT_PATH) : path{ path } {}
+
+        // key가 맞으면 entries를 채우고 true (없거나 다르거나 깨졌으면 이유를 출력하고 false)
+        bool load(const LveAccelerationStructureCacheKey& key, std::vector<LveSerializedAccelerationStructure>& entries) const;
+        void save(const LveAccelerationStructureCacheKey& key, const std::vector<LveSerializedAccelerationStructure>& entries) const;
+
+        const std::string& getPath() const { return path; }
+
+        // Blob header 읽기 (크기가 모자라면 0)
+        static uint64_t deserializedSize(const LveSerializedAccelerationStructure& entry);
+        static uint64_t handleCount(const LveSerializedAccelerationStructure& entry);
+
+    private:
+        std::string path;
+    };
+
+}  // namespace lve
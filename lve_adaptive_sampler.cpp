@@ -0,0 +1,296 @@
+#include "lve_adaptive_sampler.h"
+
+// std
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace lve {
+
+    namespace {
+        constexpr uint32_t WORKGROUP_SIZE = 16;
+
+        // shaders/adaptive_*.comp push_constant block과 같은 layout
+        struct WeightPushConstants {
+            uint32_t reset;
+            uint32_t minSamples;
+            float errorThreshold;
+            uint32_t width;
+            uint32_t height;
+        };
+
+        struct BudgetPushConstants {
+            uint32_t samplesPerPixel;
+            uint32_t maxSamples;
+            uint32_t frameSeed;
+            uint32_t width;
+            uint32_t height;
+        };
+
+        // shaders/adaptive_weight.comp BudgetBuffer
+        struct BudgetCounters {
+            uint32_t weightSum;     // WEIGHT_SCALE fixed point
+            uint32_t warmupPixels;
+        };
+    }
+
+    LveAdaptiveSampler::LveAdaptiveSampler(LveDevice& device, VkExtent2D extent, const LveAdaptiveSettings& settings)
+        : lveDevice{ device }, extent{ extent }, settings{ settings } {
+        this->settings.minSamples = std::max(this->settings.minSamples, 2u);
+        this->settings.maxSamplesPerFrame = std::max(this->settings.maxSamplesPerFrame, 1u);
+
+        createImages();
+        createBudgetBuffer();
+        createDescriptorPool();
+
+        createPass(weightPass, "shaders/adaptive_weight.comp.spv", 2, sizeof(WeightPushConstants));
+        createPass(budgetPass, "shaders/adaptive_budget.comp.spv", 2, sizeof(BudgetPushConstants));
+
+        writePassDescriptors(weightPass, { moments.view, weight.view });
+        writePassDescriptors(budgetPass, { weight.view, sampleCount.view });
+    }
+
+    LveAdaptiveSampler::~LveAdaptiveSampler() {
+        destroyPass(weightPass);
+        destroyPass(budgetPass);
+        vkDestroyDescriptorPool(lveDevice.device(), descriptorPool, nullptr);
+        lveDevice.destroyBuffer(budgetBuffer, budgetAllocation);
+
+        for (Image* image : { &moments, &sampleCount, &weight }) {
+            destroyImage(*image);
+        }
+    }
+
+    void LveAdaptiveSampler::createImages() {
+        createImage(moments, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(sampleCount, VK_FORMAT_R32_UINT);
+        createImage(weight, VK_FORMAT_R32_SFLOAT);
+
+        // 전부 GENERAL (raygen / compute 둘 다 storage image로 접근)
+        VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+
+        std::vector<VkImageMemoryBarrier> barriers;
+        for (Image* image : { &moments, &sampleCount, &weight }) {
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = image->image;
+            barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            barriers.push_back(barrier);
+        }
+
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            0, nullptr,
+            0, nullptr,
+            static_cast<uint32_t>(barriers.size()), barriers.data()
+        );
+
+        lveDevice.endSingleTimeCommands(commandBuffer);
+    }
+
+    void LveAdaptiveSampler::createImage(Image& target, VkFormat format) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = extent.width;
+        imageInfo.extent.height = extent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        lveDevice.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, target.image, target.allocation);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = target.image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+        if (vkCreateImageView(lveDevice.device(), &viewInfo, nullptr, &target.view) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create adaptive sampling image view!");
+        }
+    }
+
+    void LveAdaptiveSampler::destroyImage(Image& target) {
+        vkDestroyImageView(lveDevice.device(), target.view, nullptr);
+        lveDevice.destroyImage(target.image, target.allocation);
+        target.view = VK_NULL_HANDLE;
+    }
+
+    void LveAdaptiveSampler::createBudgetBuffer() {
+        lveDevice.createBuffer(
+            sizeof(BudgetCounters),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            budgetBuffer,
+            budgetAllocation
+        );
+    }
+
+    void LveAdaptiveSampler::createDescriptorPool() {
+        // weight / budget pass 각각 image 2개 + budget buffer
+        VkDescriptorPoolSize poolSizes[] = {
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 4 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 },
+        };
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes = poolSizes;
+        poolInfo.maxSets = 2;
+
+        if (vkCreateDescriptorPool(lveDevice.device(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create adaptive sampling descriptor pool!");
+        }
+    }
+
+    void LveAdaptiveSampler::createPass(ComputePass& pass, const std::string& shaderPath,
+        uint32_t imageCount, uint32_t pushConstantSize) {
+        // binding 0..imageCount-1: storage image, binding imageCount: budget buffer
+        std::vector<VkDescriptorSetLayoutBinding> bindings(imageCount + 1);
+        for (uint32_t i = 0; i <= imageCount; i++) {
+            bindings[i] = {};
+            bindings[i].binding = i;
+            bindings[i].descriptorType = i < imageCount ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(lveDevice.device(), &layoutInfo, nullptr, &pass.setLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create adaptive sampling descriptor set layout!");
+        }
+
+        lveDevice.createComputePipeline(shaderPath, pass.setLayout, pushConstantSize, pass.pipelineLayout, pass.pipeline);
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &pass.setLayout;
+
+        if (vkAllocateDescriptorSets(lveDevice.device(), &allocInfo, &pass.descriptorSet) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate adaptive sampling descriptor set!");
+        }
+    }
+
+    void LveAdaptiveSampler::destroyPass(ComputePass& pass) {
+        vkDestroyPipeline(lveDevice.device(), pass.pipeline, nullptr);
+        vkDestroyPipelineLayout(lveDevice.device(), pass.pipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(lveDevice.device(), pass.setLayout, nullptr);
+    }
+
+    void LveAdaptiveSampler::writePassDescriptors(const ComputePass& pass, const std::vector<VkImageView>& views) {
+        std::vector<VkDescriptorImageInfo> imageInfos(views.size());
+        std::vector<VkWriteDescriptorSet> writes(views.size() + 1);
+
+        for (size_t i = 0; i < views.size(); i++) {
+            imageInfos[i].imageView = views[i];
+            imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+            writes[i] = {};
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = pass.descriptorSet;
+            writes[i].dstBinding = static_cast<uint32_t>(i);
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[i].pImageInfo = &imageInfos[i];
+        }
+
+        VkDescriptorBufferInfo bufferInfo{};
+        bufferInfo.buffer = budgetBuffer;
+        bufferInfo.offset = 0;
+        bufferInfo.range = VK_WHOLE_SIZE;
+
+        VkWriteDescriptorSet& bufferWrite = writes.back();
+        bufferWrite = {};
+        bufferWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        bufferWrite.dstSet = pass.descriptorSet;
+        bufferWrite.dstBinding = static_cast<uint32_t>(views.size());
+        bufferWrite.descriptorCount = 1;
+        bufferWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bufferWrite.pBufferInfo = &bufferInfo;
+
+        vkUpdateDescriptorSets(lveDevice.device(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void LveAdaptiveSampler::dispatch(VkCommandBuffer commandBuffer, const ComputePass& pass, VkExtent2D activeExtent,
+        const void* pushConstants, uint32_t pushConstantSize) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pass.pipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pass.pipelineLayout,
+            0, 1, &pass.descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pass.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, pushConstantSize, pushConstants);
+
+        vkCmdDispatch(commandBuffer,
+            (activeExtent.width + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+            (activeExtent.height + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+            1);
+    }
+
+    void LveAdaptiveSampler::computeBarrier(VkCommandBuffer commandBuffer) {
+        // raygen ↔ compute ↔ fill 사이, 모든 image가 GENERAL이므로 global memory barrier로 충분
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void LveAdaptiveSampler::record(VkCommandBuffer commandBuffer, bool reset, uint32_t samplesPerPixel, VkExtent2D activeExtent) {
+        LveGpuProfiler::Scope scope{ profiler, commandBuffer, "adaptive budget" };
+
+        // 이전 프레임 raygen의 moments 쓰기 / budget pass의 counter 읽기 완료 대기
+        computeBarrier(commandBuffer);
+        vkCmdFillBuffer(commandBuffer, budgetBuffer, 0, VK_WHOLE_SIZE, 0);
+        computeBarrier(commandBuffer);
+
+        // 1. pixel별 weight (표준오차) + workgroup 합을 counter에 atomic add
+        WeightPushConstants weightParams{};
+        weightParams.reset = reset ? 1u : 0u;
+        weightParams.minSamples = settings.minSamples;
+        weightParams.errorThreshold = settings.errorThreshold;
+        weightParams.width = activeExtent.width;
+        weightParams.height = activeExtent.height;
+        dispatch(commandBuffer, weightPass, activeExtent, &weightParams, sizeof(weightParams));
+        computeBarrier(commandBuffer);
+
+        // 2. 남은 budget을 weight 비례로 나눠 sample 수 map 작성
+        BudgetPushConstants budgetParams{};
+        budgetParams.samplesPerPixel = samplesPerPixel;
+        budgetParams.maxSamples = settings.maxSamplesPerFrame;
+        budgetParams.frameSeed = frameCounter++;
+        budgetParams.width = activeExtent.width;
+        budgetParams.height = activeExtent.height;
+        dispatch(commandBuffer, budgetPass, activeExtent, &budgetParams, sizeof(budgetParams));
+
+        // raygen이 map을 읽기 전에 완료 대기
+        computeBarrier(commandBuffer);
+    }
+
+}  // namespace lve
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "lve_device.h"
+#include "lve_gpu_profiler.h"
+
+// std lib headers
+#include <string>
+#include <vector>
+
+namespace lve {
+
+    struct LveAdaptiveSettings {
+        uint32_t minSamples = 16;              // 이만큼 쌓이기 전까지는 preset spp 그대로 (variance 추정 warm-up)
+        uint32_t maxSamplesPerFrame = 64;      // 한 pixel이 한 frame에 받을 수 있는 최대 sample 수
+        float errorThreshold = 1.0f / 512.0f;  // 표시 값 (gamma 후) 표준오차가 이보다 작으면 수렴
+    };
+
+    // Variance 기반 adaptive sampling
+    // - raygen (CAMERA_FLAG_ADAPTIVE)이 pixel별 luminance moments / sample 수를 moments image에 누적
+    // - record()에서 weight → budget compute pass로 moments를 frame당 sample 수 map으로 바꿈
+    //   (총량 = width × height × preset spp, 수렴 / 하늘만 보이는 pixel은 0)
+    // - raygen은 map에서 자기 sample 수를 읽어 그만큼만 trace
+    class LveAdaptiveSampler {
+    public:
+        LveAdaptiveSampler(LveDevice& device, VkExtent2D extent, const LveAdaptiveSettings& settings = LveAdaptiveSettings{});
+        ~LveAdaptiveSampler();
+
+        LveAdaptiveSampler(const LveAdaptiveSampler&) = delete;
+        LveAdaptiveSampler& operator=(const LveAdaptiveSampler&) = delete;
+
+        // raygen이 쓰는 image (GENERAL layout, ray tracing set binding 11 / 12)
+        VkImageView getMomentsView() const { return moments.view; }         // RGBA32F 평균 L, 평균 L², sample 수, primary hit 수
+        VkImageView getSampleCountView() const { return sampleCount.view; }  // R32UI 이번 frame sample 수
+
+        const LveAdaptiveSettings& getSettings() const { return settings; }
+
+        void setProfiler(LveGpuProfiler* gpuProfiler) { profiler = gpuProfiler; }
+
+        // vkCmdTraceRaysKHR 전에 호출
+        // reset: 누적이 방금 reset됨 (frameIndex 0) → 모든 pixel warm-up
+        // activeExtent: 이번 프레임 trace 해상도 (dynamic resolution, image 크기 이하)
+        void record(VkCommandBuffer commandBuffer, bool reset, uint32_t samplesPerPixel, VkExtent2D activeExtent);
+
+    private:
+        struct Image {
+            VkImage image = VK_NULL_HANDLE;
+            LveAllocation allocation{};
+            VkImageView view = VK_NULL_HANDLE;
+        };
+
+        struct ComputePass {
+            VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+            VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        };
+
+        void createImages();
+        void createImage(Image& target, VkFormat format);
+        void destroyImage(Image& target);
+        void createBudgetBuffer();
+        void createDescriptorPool();
+        void createPass(ComputePass& pass, const std::string& shaderPath, uint32_t imageCount, uint32_t pushConstantSize);
+        void destroyPass(ComputePass& pass);
+        void writePassDescriptors(const ComputePass& pass, const std::vector<VkImageView>& views);
+
+        void dispatch(VkCommandBuffer commandBuffer, const ComputePass& pass, VkExtent2D activeExtent,
+            const void* pushConstants, uint32_t pushConstantSize);
+        void computeBarrier(VkCommandBuffer commandBuffer);
+
+        LveDevice& lveDevice;
+        VkExtent2D extent;
+        LveAdaptiveSettings settings;
+        LveGpuProfiler* profiler = nullptr;
+        uint32_t frameCounter = 0;  // budget 반올림 dither seed
+
+        Image moments;      // raygen이 누적
+        Image sampleCount;  // budget pass 출력, raygen 입력
+        Image weight;       // weight pass → budget pass (-1 = warm-up)
+
+        // 이번 frame의 weight 합 (fixed point) + warm-up pixel 수, 매 frame 0으로 채움
+        VkBuffer budgetBuffer = VK_NULL_HANDLE;
+        LveAllocation budgetAllocation{};
+
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        ComputePass weightPass;
+        ComputePass budgetPass;
+    };
+
+}  // namespace lve
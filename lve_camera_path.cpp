@@ -0,0 +1,163 @@
+#include "lve_camera_path.h"
+
+#include <gtc/constants.hpp>
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace lve {
+
+    namespace {
+        // Hermite 보간: p0 → p1, 양 끝 기울기 m0 / m1 (시간당 변화량), dt = 구간 길이
+        template <typename T>
+        T hermite(const T& p0, const T& m0, const T& p1, const T& m1, float dt, float u) {
+            const float u2 = u * u;
+            const float u3 = u2 * u;
+            return (2.0f * u3 - 3.0f * u2 + 1.0f) * p0 + (u3 - 2.0f * u2 + u) * dt * m0 +
+                (-2.0f * u3 + 3.0f * u2) * p1 + (u3 - u2) * dt * m1;
+        }
+
+        // Catmull-Rom 기울기 (key 간격이 달라도 되도록 시간으로 나눔), 양 끝은 한쪽 차분
+        template <typename T>
+        T tangent(const std::vector<LveCameraKey>& keys, size_t i, T (*get)(const LveCameraKey&)) {
+            const size_t prev = i > 0 ? i - 1 : i;
+            const size_t next = i + 1 < keys.size() ? i + 1 : i;
+            const float dt = keys[next].time - keys[prev].time;
+            if (dt <= 0.0f) {
+                return get(keys[i]) * 0.0f;
+            }
+            return (get(keys[next]) - get(keys[prev])) / dt;
+        }
+
+        glm::vec3 keyPosition(const LveCameraKey& key) { return key.position; }
+        float keyYaw(const LveCameraKey& key) { return key.yaw; }
+        float keyPitch(const LveCameraKey& key) { return key.pitch; }
+    }
+
+    LveCameraPath LveCameraPath::load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("failed to open camera path: " + path);
+        }
+
+        LveCameraPath cameraPath{};
+        std::string line;
+        uint32_t lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+            line = line.substr(0, line.find('#'));
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+            std::istringstream stream(line);
+            LveCameraKey key{};
+            if (!(stream >> key.time >> key.position.x >> key.position.y >> key.position.z >> key.yaw >> key.pitch)) {
+                throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": expected \"time x y z yaw pitch\"");
+            }
+            if (!cameraPath.keys.empty() && key.time <= cameraPath.keys.back().time) {
+                throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": key times must increase");
+            }
+            cameraPath.keys.push_back(key);
+        }
+
+        if (cameraPath.keys.empty()) {
+            throw std::runtime_error("camera path has no keys: " + path);
+        }
+
+        std::cout << "Loaded camera path " << path << " (" << cameraPath.keys.size() << " keys, "
+            << cameraPath.getDuration() << " s)" << std::endl;
+        return cameraPath;
+    }
+
+    LveCameraPath LveCameraPath::orbit(const glm::vec3& start, const glm::vec3& target, float duration, uint32_t keyCount) {
+        keyCount = std::max(keyCount, 2u);
+
+        const glm::vec3 offset = start - target;
+        const float radius = std::sqrt(offset.x * offset.x + offset.z * offset.z);
+        const float startAngle = std::atan2(offset.z, offset.x);
+
+        LveCameraPath cameraPath{};
+        for (uint32_t i = 0; i <= keyCount; i++) {
+            const float fraction = static_cast<float>(i) / static_cast<float>(keyCount);
+            const float angle = startAngle + fraction * 2.0f * glm::pi<float>();
+
+            LveCameraKey key{};
+            key.time = fraction * duration;
+            key.position = target + glm::vec3(radius * std::cos(angle), offset.y, radius * std::sin(angle));
+
+            // initCamera와 같은 방식으로 target을 바라보는 yaw / pitch
+            const glm::vec3 direction = glm::normalize(target - key.position);
+            key.yaw = glm::degrees(std::atan2(direction.z, direction.x));
+            key.pitch = glm::degrees(std::asin(direction.y));
+
+            // atan2의 ±180 경계에서 한 바퀴 돌지 않도록 이전 key 기준으로 이어 붙임
+            if (!cameraPath.keys.empty()) {
+                const float previousYaw = cameraPath.keys.back().yaw;
+                while (key.yaw - previousYaw > 180.0f) key.yaw -= 360.0f;
+                while (key.yaw - previousYaw < -180.0f) key.yaw += 360.0f;
+            }
+            cameraPath.keys.push_back(key);
+        }
+        return cameraPath;
+    }
+
+    void LveCameraPath::save(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("failed to open camera path output: " + path);
+        }
+
+        // float를 그대로 복원할 수 있는 자릿수 (기본 6자리면 재생 카메라가 달라지고 긴 기록의 시각이 겹침)
+        file << std::setprecision(std::numeric_limits<float>::max_digits10);
+        file << "# time x y z yaw pitch\n";
+        for (const LveCameraKey& key : keys) {
+            file << key.time << ' ' << key.position.x << ' ' << key.position.y << ' ' << key.position.z << ' '
+                << key.yaw << ' ' << key.pitch << '\n';
+        }
+
+        std::cout << "Wrote camera path " << path << " (" << keys.size() << " keys)" << std::endl;
+    }
+
+    void LveCameraPath::addKey(const LveCameraKey& key) {
+        if (!keys.empty() && key.time <= keys.back().time) {
+            return;  // 같은 시각 (frame time 0) key는 보간에 쓸 수 없음
+        }
+        keys.push_back(key);
+    }
+
+    LveCameraKey LveCameraPath::sample(float time) const {
+        if (keys.empty()) {
+            return LveCameraKey{};
+        }
+
+        // 경로 시작 기준 시각 → key 시각
+        time += keys.front().time;
+        if (time <= keys.front().time) return keys.front();
+        if (time >= keys.back().time) return keys.back();
+
+        // time이 들어있는 구간 [i, i + 1]
+        auto upper = std::upper_bound(keys.begin(), keys.end(), time,
+            [](float t, const LveCameraKey& key) { return t < key.time; });
+        const size_t i = static_cast<size_t>(upper - keys.begin()) - 1;
+
+        const LveCameraKey& k0 = keys[i];
+        const LveCameraKey& k1 = keys[i + 1];
+        const float dt = k1.time - k0.time;
+        const float u = (time - k0.time) / dt;
+
+        LveCameraKey result{};
+        result.time = time - keys.front().time;
+        result.position = hermite(k0.position, tangent(keys, i, keyPosition), k1.position, tangent(keys, i + 1, keyPosition), dt, u);
+        result.yaw = hermite(k0.yaw, tangent(keys, i, keyYaw), k1.yaw, tangent(keys, i + 1, keyYaw), dt, u);
+        result.pitch = hermite(k0.pitch, tangent(keys, i, keyPitch), k1.pitch, tangent(keys, i + 1, keyPitch), dt, u);
+        result.pitch = std::clamp(result.pitch, -89.0f, 89.0f);
+        return result;
+    }
+
+}  // namespace lve
@@ -0,0 +1,45 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm.hpp>
+
+// std lib headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+    // 카메라 상태 하나 (first_app_raytracing의 cameraPos / yaw / pitch와 같은 의미, 각도는 degree)
+    struct LveCameraKey {
+        float time = 0.0f;  // 초
+        glm::vec3 position{ 0.0f };
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+    };
+
+    // Benchmark용 카메라 경로: key 사이를 Catmull-Rom spline으로 보간
+    // - 파일: 한 줄에 "time x y z yaw pitch", '#'부터 줄 끝은 주석
+    // - 창 모드에서 매 프레임 카메라를 기록해 저장하면 그대로 다시 재생 가능 (입력 / frame time과 무관)
+    class LveCameraPath {
+    public:
+        static LveCameraPath load(const std::string& path);
+
+        // start에서 target을 바라보며 target 둘레를 한 바퀴 (높이 / 반지름 유지)
+        static LveCameraPath orbit(const glm::vec3& start, const glm::vec3& target, float duration, uint32_t keyCount = 16);
+
+        void save(const std::string& path) const;
+
+        void addKey(const LveCameraKey& key);  // time은 이전 key 이후여야 함
+        LveCameraKey sample(float time) const;  // [0, duration] 밖은 양 끝 key
+
+        bool empty() const { return keys.empty(); }
+        size_t getKeyCount() const { return keys.size(); }
+        float getDuration() const { return keys.empty() ? 0.0f : keys.back().time - keys.front().time; }
+
+    private:
+        std::vector<LveCameraKey> keys;
+    };
+
+}  // namespace lve
@@ -1,7 +1,9 @@
 ﻿#include "lve_device.h"
+#include "lve_staging_ring.h"
 
 // std headers
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <set>
 #include <unordered_set>
@@ -48,24 +50,34 @@ namespace lve {
     }
 
     // class member functions
-    LveDevice::LveDevice(LveWindow& window) : window{ window } {
+    LveDevice::LveDevice(LveWindow& window) : LveDevice{ &window } {}
+
+    LveDevice::LveDevice(LveWindow* window) : window{ window } {
         createInstance();
         setupDebugMessenger();
         createSurface();
         pickPhysicalDevice();
         createLogicalDevice();
+        allocator = std::make_unique<LveMemoryAllocator>(device_, physicalDevice, true);
         createCommandPool();
+        stagingRing = std::make_unique<LveStagingRing>(*this);
+        pipelineCache = std::make_unique<LvePipelineCache>(device_, properties);
     }
 
     LveDevice::~LveDevice() {
+        pipelineCache.reset();
+        stagingRing.reset();
         vkDestroyCommandPool(device_, commandPool, nullptr);
+        allocator.reset();
         vkDestroyDevice(device_, nullptr);
 
         if (enableValidationLayers) {
             DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
         }
 
-        vkDestroySurfaceKHR(instance, surface_, nullptr);
+        if (surface_ != VK_NULL_HANDLE) {
+            vkDestroySurfaceKHR(instance, surface_, nullptr);
+        }
         vkDestroyInstance(instance, nullptr);
     }
 
@@ -199,14 +211,33 @@ namespace lve {
         bufferDeviceAddressFeatures.bufferDeviceAddress = VK_TRUE;
         bufferDeviceAddressFeatures.pNext = nullptr;
 
+        // vkCmdTraceRaysIndirectKHR는 선택 기능 (wavefront 모드가 GPU ray 수로 launch, 없으면 전체 크기 + early-out)
+        // accelerationStructureHostCommands도 선택 기능 (vkBuildAccelerationStructuresKHR로 CPU에서 BLAS build)
+        VkPhysicalDeviceRayTracingPipelineFeaturesKHR supportedRtFeatures{};
+        supportedRtFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR;
+
+        VkPhysicalDeviceAccelerationStructureFeaturesKHR supportedAsFeatures{};
+        supportedAsFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+        supportedAsFeatures.pNext = &supportedRtFeatures;
+
+        VkPhysicalDeviceFeatures2 supportedFeatures2{};
+        supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures2.pNext = &supportedAsFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures2);
+        traceRaysIndirectSupported = supportedRtFeatures.rayTracingPipelineTraceRaysIndirect == VK_TRUE;
+        accelerationStructureHostCommandsSupported = supportedAsFeatures.accelerationStructureHostCommands == VK_TRUE;
+
         VkPhysicalDeviceRayTracingPipelineFeaturesKHR rayTracingPipelineFeatures{};
         rayTracingPipelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR;
         rayTracingPipelineFeatures.rayTracingPipeline = VK_TRUE;
+        rayTracingPipelineFeatures.rayTracingPipelineTraceRaysIndirect = traceRaysIndirectSupported ? VK_TRUE : VK_FALSE;
         rayTracingPipelineFeatures.pNext = &bufferDeviceAddressFeatures;
 
         VkPhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures{};
         accelerationStructureFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
         accelerationStructureFeatures.accelerationStructure = VK_TRUE;
+        accelerationStructureFeatures.accelerationStructureHostCommands =
+            accelerationStructureHostCommandsSupported ? VK_TRUE : VK_FALSE;
         accelerationStructureFeatures.pNext = &rayTracingPipelineFeatures;
 
         VkPhysicalDeviceFeatures2 deviceFeatures2{};
@@ -222,8 +253,9 @@ namespace lve {
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
 
         createInfo.pEnabledFeatures = nullptr;
-        createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-        createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+        std::vector<const char*> extensions = getRequiredDeviceExtensions();
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.ppEnabledExtensionNames = extensions.data();
 
         if (enableValidationLayers) {
             createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
@@ -255,14 +287,18 @@ namespace lve {
         }
     }
 
-    void LveDevice::createSurface() { window.createWindowSurface(instance, &surface_); }
+    void LveDevice::createSurface() {
+        if (isHeadless()) return;
+        window->createWindowSurface(instance, &surface_);
+    }
 
     bool LveDevice::isDeviceSuitable(VkPhysicalDevice device) {
         QueueFamilyIndices indices = findQueueFamilies(device);
         bool extensionsSupported = checkDeviceExtensionSupport(device);
 
-        bool swapChainAdequate = false;
-        if (extensionsSupported) {
+        // headless는 present 안 하므로 surface 검사 생략
+        bool swapChainAdequate = isHeadless();
+        if (extensionsSupported && !isHeadless()) {
             SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
             swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
         }
@@ -339,11 +375,15 @@ namespace lve {
     }
 
     std::vector<const char*> LveDevice::getRequiredExtensions() {
-        uint32_t glfwExtensionCount = 0;
-        const char** glfwExtensions;
-        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        std::vector<const char*> extensions;
 
-        std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        // headless는 glfwInit을 하지 않으므로 surface 확장도 필요 없음
+        if (!isHeadless()) {
+            uint32_t glfwExtensionCount = 0;
+            const char** glfwExtensions;
+            glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+            extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        }
 
         if (enableValidationLayers) {
             extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -375,6 +415,15 @@ namespace lve {
         }
     }
 
+    std::vector<const char*> LveDevice::getRequiredDeviceExtensions() {
+        std::vector<const char*> extensions;
+        for (const char* extension : deviceExtensions) {
+            if (isHeadless() && strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0) continue;
+            extensions.push_back(extension);
+        }
+        return extensions;
+    }
+
     bool LveDevice::checkDeviceExtensionSupport(VkPhysicalDevice device) {
         uint32_t extensionCount;
         vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
@@ -386,7 +435,8 @@ namespace lve {
             &extensionCount,
             availableExtensions.data());
 
-        std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+        std::vector<const char*> extensions = getRequiredDeviceExtensions();
+        std::set<std::string> requiredExtensions(extensions.begin(), extensions.end());
 
         for (const auto& extension : availableExtensions) {
             requiredExtensions.erase(extension.extensionName);
@@ -411,7 +461,13 @@ namespace lve {
                 indices.graphicsFamilyHasValue = true;
             }
             VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface_, &presentSupport);
+            if (isHeadless()) {
+                // present queue는 쓰지 않지만 graphics queue로 채워둠
+                presentSupport = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT ? VK_TRUE : VK_FALSE;
+            }
+            else {
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface_, &presentSupport);
+            }
             if (queueFamily.queueCount > 0 && presentSupport) {
                 indices.presentFamily = i;
                 indices.presentFamilyHasValue = true;
@@ -470,16 +526,7 @@ namespace lve {
     }
 
     uint32_t LveDevice::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-        VkPhysicalDeviceMemoryProperties memProperties;
-        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
-        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-            if ((typeFilter & (1 << i)) &&
-                (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-                return i;
-            }
-        }
-
-        throw std::runtime_error("failed to find suitable memory type!");
+        return allocator->findMemoryType(typeFilter, properties);
     }
 
     void LveDevice::createBuffer(
@@ -487,7 +534,8 @@ namespace lve {
         VkBufferUsageFlags usage,
         VkMemoryPropertyFlags properties,
         VkBuffer& buffer,
-        VkDeviceMemory& bufferMemory) {
+        LveAllocation& bufferAllocation,
+        LveMemoryUsage memoryUsage) {
         VkBufferCreateInfo bufferInfo{};
         bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         bufferInfo.size = size;
@@ -501,23 +549,20 @@ namespace lve {
         VkMemoryRequirements memRequirements;
         vkGetBufferMemoryRequirements(device_, buffer, &memRequirements);
 
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+        // buffer block은 항상 DEVICE_ADDRESS flag로 할당됨
+        bufferAllocation = allocator->allocate(memRequirements, properties, LveResourceKind::Linear, memoryUsage);
 
-        VkMemoryAllocateFlagsInfo allocFlagsInfo{};
-        if (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) {
-            allocFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
-            allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
-            allocInfo.pNext = &allocFlagsInfo;
+        if (vkBindBufferMemory(device_, buffer, bufferAllocation.memory, bufferAllocation.offset) != VK_SUCCESS) {
+            throw std::runtime_error("failed to bind buffer memory!");
         }
+    }
 
-        if (vkAllocateMemory(device_, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-            throw std::runtime_error("failed to allocate vertex buffer memory!");
+    void LveDevice::destroyBuffer(VkBuffer& buffer, LveAllocation& bufferAllocation) {
+        if (buffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(device_, buffer, nullptr);
+            buffer = VK_NULL_HANDLE;
         }
-
-        vkBindBufferMemory(device_, buffer, bufferMemory, 0);
+        allocator->free(bufferAllocation);
     }
 
     VkCommandBuffer LveDevice::beginSingleTimeCommands() {
@@ -546,8 +591,18 @@ namespace lve {
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &commandBuffer;
 
-        vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(graphicsQueue_);
+        // queue 전체를 비우지 않고 이 submit만 기다림
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        VkFence fence;
+        if (vkCreateFence(device_, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+            vkFreeCommandBuffers(device_, commandPool, 1, &commandBuffer);
+            throw std::runtime_error("failed to create single time command fence!");
+        }
+
+        vkQueueSubmit(graphicsQueue_, 1, &submitInfo, fence);
+        vkWaitForFences(device_, 1, &fence, VK_TRUE, UINT64_MAX);
+        vkDestroyFence(device_, fence, nullptr);
 
         vkFreeCommandBuffers(device_, commandPool, 1, &commandBuffer);
     }
@@ -595,7 +650,7 @@ namespace lve {
         const VkImageCreateInfo& imageInfo,
         VkMemoryPropertyFlags properties,
         VkImage& image,
-        VkDeviceMemory& imageMemory) {
+        LveAllocation& imageAllocation) {
         if (vkCreateImage(device_, &imageInfo, nullptr, &image) != VK_SUCCESS) {
             throw std::runtime_error("failed to create image!");
         }
@@ -603,17 +658,90 @@ namespace lve {
         VkMemoryRequirements memRequirements;
         vkGetImageMemoryRequirements(device_, image, &memRequirements);
 
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+        LveResourceKind kind = imageInfo.tiling == VK_IMAGE_TILING_LINEAR
+            ? LveResourceKind::Linear
+            : LveResourceKind::OptimalImage;
+        imageAllocation = allocator->allocate(memRequirements, properties, kind, LveMemoryUsage::Persistent);
+
+        if (vkBindImageMemory(device_, image, imageAllocation.memory, imageAllocation.offset) != VK_SUCCESS) {
+            throw std::runtime_error("failed to bind image memory!");
+        }
+    }
 
-        if (vkAllocateMemory(device_, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-            throw std::runtime_error("failed to allocate image memory!");
+    void LveDevice::destroyImage(VkImage& image, LveAllocation& imageAllocation) {
+        if (image != VK_NULL_HANDLE) {
+            vkDestroyImage(device_, image, nullptr);
+            image = VK_NULL_HANDLE;
         }
+        allocator->free(imageAllocation);
+    }
 
-        if (vkBindImageMemory(device_, image, imageMemory, 0) != VK_SUCCESS) {
-            throw std::runtime_error("failed to bind image memory!");
+    VkShaderModule LveDevice::createShaderModule(const std::string& filepath) {
+        std::ifstream file{ filepath, std::ios::ate | std::ios::binary };
+
+        // SPIR-V는 저장소에 넣지 않음 (shader 소스에서 빌드)
+        if (!file.is_open()) {
+            throw std::runtime_error("failed to open shader file: " + filepath +
+                " (run shaders/compile.sh or shaders/compile.bat to build the SPIR-V)");
+        }
+
+        size_t fileSize = static_cast<size_t>(file.tellg());
+        std::vector<char> code(fileSize);
+
+        file.seekg(0);
+        file.read(code.data(), fileSize);
+
+        VkShaderModuleCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = code.size();
+        createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+        VkShaderModule shaderModule;
+        if (vkCreateShaderModule(device_, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create shader module: " + filepath);
+        }
+
+        return shaderModule;
+    }
+
+    void LveDevice::createComputePipeline(
+        const std::string& shaderPath,
+        VkDescriptorSetLayout setLayout,
+        uint32_t pushConstantSize,
+        VkPipelineLayout& pipelineLayout,
+        VkPipeline& pipeline) {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = pushConstantSize;
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &setLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = pushConstantSize > 0 ? 1 : 0;
+        pipelineLayoutInfo.pPushConstantRanges = pushConstantSize > 0 ? &pushConstantRange : nullptr;
+
+        if (vkCreatePipelineLayout(device_, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compute pipeline layout: " + shaderPath);
+        }
+
+        VkShaderModule shaderModule = createShaderModule(shaderPath);
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = shaderModule;
+        pipelineInfo.stage.pName = "main";
+        pipelineInfo.layout = pipelineLayout;
+
+        VkResult result = vkCreateComputePipelines(
+            device_, pipelineCache->getCache(), 1, &pipelineInfo, nullptr, &pipeline);
+        vkDestroyShaderModule(device_, shaderModule, nullptr);
+
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compute pipeline: " + shaderPath);
         }
     }
 
@@ -1,13 +1,18 @@
 #pragma once
 
 #include "lve_window.h"
+#include "lve_memory_allocator.h"
+#include "lve_pipeline_cache.h"
 
 // std lib headers
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace lve {
 
+    class LveStagingRing;
+
     struct SwapChainSupportDetails {
         VkSurfaceCapabilitiesKHR capabilities;
         std::vector<VkSurfaceFormatKHR> formats;
@@ -31,6 +36,8 @@ namespace lve {
 #endif
 
         LveDevice(LveWindow& window);
+        // window == nullptr: headless (GLFW / surface / swapchain 없이 storage image에만 렌더)
+        explicit LveDevice(LveWindow* window);
         ~LveDevice();
 
         // Not copyable or movable
@@ -42,9 +49,12 @@ namespace lve {
         VkCommandPool getCommandPool() { return commandPool; }
         VkDevice device() { return device_; }
         VkSurfaceKHR surface() { return surface_; }
+        bool isHeadless() const { return window == nullptr; }
         VkQueue graphicsQueue() { return graphicsQueue_; }
         VkQueue presentQueue() { return presentQueue_; }
         VkPhysicalDevice getPhysicalDevice() { return physicalDevice; }
+        bool supportsTraceRaysIndirect() const { return traceRaysIndirectSupported; }
+        bool supportsAccelerationStructureHostCommands() const { return accelerationStructureHostCommandsSupported; }
 
         SwapChainSupportDetails getSwapChainSupport() { return querySwapChainSupport(physicalDevice); }
         uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
@@ -53,15 +63,19 @@ namespace lve {
             const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
 
         // Buffer Helper Functions
+        // 메모리는 allocator에서 sub-allocation (scratch / staging은 Transient)
         void createBuffer(
             VkDeviceSize size,
             VkBufferUsageFlags usage,
             VkMemoryPropertyFlags properties,
             VkBuffer& buffer,
-            VkDeviceMemory& bufferMemory);
+            LveAllocation& bufferAllocation,
+            LveMemoryUsage memoryUsage = LveMemoryUsage::Persistent);
+        void destroyBuffer(VkBuffer& buffer, LveAllocation& bufferAllocation);
         VkCommandBuffer beginSingleTimeCommands();
         void endSingleTimeCommands(VkCommandBuffer commandBuffer);
         void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+        LveStagingRing& getStagingRing() { return *stagingRing; }
         void copyBufferToImage(
             VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount);
 
@@ -69,7 +83,26 @@ namespace lve {
             const VkImageCreateInfo& imageInfo,
             VkMemoryPropertyFlags properties,
             VkImage& image,
-            VkDeviceMemory& imageMemory);
+            LveAllocation& imageAllocation);
+        void destroyImage(VkImage& image, LveAllocation& imageAllocation);
+
+        // pipeline 생성 시 사용 (종료 시 디스크에 저장)
+        LvePipelineCache& getPipelineCache() { return *pipelineCache; }
+
+        // Shader Helper Functions
+        // SPIR-V 파일 → shader module (호출 쪽이 pipeline 생성 후 destroy)
+        VkShaderModule createShaderModule(const std::string& filepath);
+        // compute shader 하나 + descriptor set layout 하나 + push constant (offset 0) → pipeline layout / pipeline
+        void createComputePipeline(
+            const std::string& shaderPath,
+            VkDescriptorSetLayout setLayout,
+            uint32_t pushConstantSize,
+            VkPipelineLayout& pipelineLayout,
+            VkPipeline& pipeline);
+
+        LveMemoryAllocator& getAllocator() { return *allocator; }
+        LveMemoryStatistics getMemoryStatistics() { return allocator->getStatistics(); }
+        void printMemoryStatistics() { allocator->printStatistics(); }
 
         VkPhysicalDeviceProperties properties;
 
@@ -90,19 +123,27 @@ namespace lve {
         void hasGflwRequiredInstanceExtensions();
         bool checkDeviceExtensionSupport(VkPhysicalDevice device);
         SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
+        std::vector<const char*> getRequiredDeviceExtensions();
 
         VkInstance instance;
         VkDebugUtilsMessengerEXT debugMessenger;
         VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
-        LveWindow& window;
+        LveWindow* window;
         VkCommandPool commandPool;
 
         VkDevice device_;
-        VkSurfaceKHR surface_;
+        VkSurfaceKHR surface_ = VK_NULL_HANDLE;
         VkQueue graphicsQueue_;
         VkQueue presentQueue_;
+        bool traceRaysIndirectSupported = false;
+        bool accelerationStructureHostCommandsSupported = false;
+
+        std::unique_ptr<LveMemoryAllocator> allocator;
+        std::unique_ptr<LveStagingRing> stagingRing;
+        std::unique_ptr<LvePipelineCache> pipelineCache;
 
         const std::vector<const char*> validationLayers = { "VK_LAYER_KHRONOS_validation" };
+        // headless에서는 swapchain 확장 제외 (getRequiredDeviceExtensions)
         const std::vector<const char*> deviceExtensions = {
             VK_KHR_SWAPCHAIN_EXTENSION_NAME,
             VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
@@ -0,0 +1,287 @@
+#include "lve_gpu_profiler.h"
+
+// std
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace lve {
+
+    LveGpuProfiler::LveGpuProfiler(LveDevice& device, uint32_t framesInFlight, uint32_t maxScopes)
+        : lveDevice{ device }, maxScopes{ maxScopes } {
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(lveDevice.getPhysicalDevice(), &properties);
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(lveDevice.getPhysicalDevice(), &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(lveDevice.getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+        const uint32_t validBits =
+            queueFamilies[lveDevice.findPhysicalQueueFamilies().graphicsFamily].timestampValidBits;
+        if (validBits == 0 || properties.limits.timestampPeriod == 0.0f) {
+            std::cout << "GPU profiler disabled: graphics queue has no timestamp support" << std::endl;
+            return;
+        }
+
+        enabled = true;
+        timestampPeriod = properties.limits.timestampPeriod;
+        timestampMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+
+        immediateSlot = framesInFlight;
+        slots.resize(framesInFlight + 1);
+
+        for (Slot& slot : slots) {
+            VkQueryPoolCreateInfo queryPoolInfo{};
+            queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            queryPoolInfo.queryCount = maxScopes * 2;
+
+            if (vkCreateQueryPool(lveDevice.device(), &queryPoolInfo, nullptr, &slot.queryPool) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create timestamp query pool!");
+            }
+        }
+    }
+
+    LveGpuProfiler::~LveGpuProfiler() {
+        for (Slot& slot : slots) {
+            vkDestroyQueryPool(lveDevice.device(), slot.queryPool, nullptr);
+        }
+    }
+
+    void LveGpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+        if (!enabled) return;
+
+        activeSlot = frameIndex;
+        collect(slots[frameIndex]);
+        resetSlot(commandBuffer, slots[frameIndex]);
+    }
+
+    void LveGpuProfiler::resolveFrames() {
+        if (!enabled) return;
+
+        // 마지막으로 쓴 slot 다음부터 = 가장 오래된 프레임부터 (sample history가 프레임 순서를 유지)
+        const uint32_t lastFrameSlot = activeSlot == immediateSlot ? previousActiveSlot : activeSlot;
+        for (uint32_t i = 1; i <= immediateSlot; i++) {
+            collect(slots[(lastFrameSlot + i) % immediateSlot]);
+        }
+    }
+
+    void LveGpuProfiler::beginImmediate(VkCommandBuffer commandBuffer) {
+        if (!enabled) return;
+
+        previousActiveSlot = activeSlot;
+        activeSlot = immediateSlot;
+        resetSlot(commandBuffer, slots[immediateSlot]);
+    }
+
+    void LveGpuProfiler::resolveImmediate() {
+        if (!enabled) return;
+
+        collect(slots[immediateSlot]);
+        activeSlot = previousActiveSlot;
+    }
+
+    uint32_t LveGpuProfiler::beginScope(VkCommandBuffer commandBuffer, const std::string& name) {
+        if (!enabled) return INVALID_SCOPE;
+
+        Slot& slot = slots[activeSlot];
+        if (slot.scopes.size() >= maxScopes) {
+            return INVALID_SCOPE;  // 남는 query 없음: 이 구간은 측정 안 함
+        }
+
+        PendingScope pending{};
+        pending.statIndex = findOrAddHistory(name);
+        pending.firstQuery = static_cast<uint32_t>(slot.scopes.size()) * 2;
+        slot.scopes.push_back(pending);
+
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, slot.queryPool, pending.firstQuery);
+        return static_cast<uint32_t>(slot.scopes.size() - 1);
+    }
+
+    void LveGpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t scope) {
+        if (!enabled || scope == INVALID_SCOPE) return;
+
+        Slot& slot = slots[activeSlot];
+        PendingScope& pending = slot.scopes[scope];
+        pending.ended = true;
+
+        // 앞선 명령이 모두 끝난 시점
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, slot.queryPool, pending.firstQuery + 1);
+    }
+
+    void LveGpuProfiler::resetSlot(VkCommandBuffer commandBuffer, Slot& slot) {
+        slot.scopes.clear();
+        vkCmdResetQueryPool(commandBuffer, slot.queryPool, 0, maxScopes * 2);
+    }
+
+    void LveGpuProfiler::collect(Slot& slot) {
+        if (slot.scopes.empty()) return;
+
+        // query마다 (값, availability) 64-bit 두 개. WAIT 없이 준비된 것만 사용
+        const uint32_t queryCount = static_cast<uint32_t>(slot.scopes.size()) * 2;
+        std::vector<uint64_t> results(static_cast<size_t>(queryCount) * 2, 0);
+
+        vkGetQueryPoolResults(
+            lveDevice.device(),
+            slot.queryPool,
+            0,
+            queryCount,
+            results.size() * sizeof(uint64_t),
+            results.data(),
+            sizeof(uint64_t) * 2,
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+        );
+
+        for (const PendingScope& pending : slot.scopes) {
+            if (!pending.ended) continue;
+
+            const size_t begin = static_cast<size_t>(pending.firstQuery) * 2;
+            const size_t end = begin + 2;
+            if (results[begin + 1] == 0 || results[end + 1] == 0) continue;
+
+            const uint64_t ticks = (results[end] - results[begin]) & timestampMask;
+            const float ms = static_cast<float>(static_cast<double>(ticks) * timestampPeriod / 1.0e6);
+
+            ScopeHistory& history = histories[pending.statIndex];
+            if (history.samples.size() < HISTORY_SIZE) {
+                history.samples.push_back(ms);
+            }
+            else {
+                history.samples[history.next] = ms;
+            }
+            history.next = (history.next + 1) % HISTORY_SIZE;
+            history.total++;
+        }
+
+        slot.scopes.clear();
+    }
+
+    uint32_t LveGpuProfiler::findOrAddHistory(const std::string& name) {
+        auto it = historyIndices.find(name);
+        if (it != historyIndices.end()) {
+            return it->second;
+        }
+
+        uint32_t index = static_cast<uint32_t>(histories.size());
+        ScopeHistory history{};
+        history.name = name;
+        history.samples.reserve(HISTORY_SIZE);
+        histories.push_back(history);
+        historyIndices.emplace(name, index);
+        return index;
+    }
+
+    bool LveGpuProfiler::getLatestSample(const std::string& name, float& ms, uint64_t& sampleIndex) const {
+        auto it = historyIndices.find(name);
+        if (it == historyIndices.end()) {
+            return false;
+        }
+
+        const ScopeHistory& history = histories[it->second];
+        if (history.samples.empty()) {
+            return false;
+        }
+
+        ms = history.samples[(history.next + HISTORY_SIZE - 1) % HISTORY_SIZE];
+        sampleIndex = history.total;
+        return true;
+    }
+
+    uint64_t LveGpuProfiler::getSamplesSince(const std::string& name, uint64_t sampleIndex, std::vector<float>& samples) const {
+        auto it = historyIndices.find(name);
+        if (it == historyIndices.end()) {
+            return sampleIndex;
+        }
+
+        const ScopeHistory& history = histories[it->second];
+        if (history.total <= sampleIndex) {
+            return history.total;
+        }
+
+        // ring buffer에서 밀려난 sample은 건너뜀
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(history.total - sampleIndex, history.samples.size()));
+        for (size_t i = count; i > 0; i--) {
+            samples.push_back(history.samples[(history.next + HISTORY_SIZE - i) % HISTORY_SIZE]);
+        }
+        return history.total;
+    }
+
+    std::vector<LveGpuProfiler::ScopeStatistics> LveGpuProfiler::getStatistics() const {
+        std::vector<ScopeStatistics> statistics;
+
+        for (const ScopeHistory& history : histories) {
+            if (history.samples.empty()) continue;
+
+            std::vector<float> sorted = history.samples;
+            std::sort(sorted.begin(), sorted.end());
+
+            double sum = 0.0;
+            for (float sample : sorted) {
+                sum += sample;
+            }
+
+            ScopeStatistics stats{};
+            stats.name = history.name;
+            stats.totalSamples = history.total;
+            stats.windowSamples = sorted.size();
+            stats.minMs = sorted.front();
+            stats.avgMs = static_cast<float>(sum / static_cast<double>(sorted.size()));
+            stats.p99Ms = sorted[std::min(sorted.size() - 1, (sorted.size() * 99) / 100)];
+            statistics.push_back(stats);
+        }
+
+        return statistics;
+    }
+
+    void LveGpuProfiler::printStatistics() const {
+        if (!enabled) return;
+
+        std::cout << "GPU timings (ms, last " << HISTORY_SIZE << " samples per scope):" << std::endl;
+        std::cout << "  " << std::left << std::setw(24) << "scope" << std::right
+            << std::setw(10) << "min" << std::setw(10) << "avg" << std::setw(10) << "p99"
+            << std::setw(10) << "samples" << std::endl;
+
+        std::ios_base::fmtflags flags = std::cout.flags();
+        for (const ScopeStatistics& stats : getStatistics()) {
+            std::cout << "  " << std::left << std::setw(24) << stats.name << std::right
+                << std::fixed << std::setprecision(3)
+                << std::setw(10) << stats.minMs
+                << std::setw(10) << stats.avgMs
+                << std::setw(10) << stats.p99Ms
+                << std::setw(10) << stats.totalSamples << std::endl;
+        }
+        std::cout.flags(flags);
+    }
+
+    void LveGpuProfiler::writeCsv(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("failed to open profiler output: " + path);
+        }
+
+        file << "scope,samples,window,min_ms,avg_ms,p99_ms\n";
+        for (const ScopeStatistics& stats : getStatistics()) {
+            file << stats.name << ',' << stats.totalSamples << ',' << stats.windowSamples << ','
+                << stats.minMs << ',' << stats.avgMs << ',' << stats.p99Ms << '\n';
+        }
+
+        std::cout << "Wrote GPU timings to " << path << std::endl;
+    }
+
+    LveGpuProfiler::Scope::Scope(LveGpuProfiler* profiler, VkCommandBuffer commandBuffer, const std::string& name)
+        : profiler{ profiler }, commandBuffer{ commandBuffer }, scope{ INVALID_SCOPE } {
+        if (profiler) {
+            scope = profiler->beginScope(commandBuffer, name);
+        }
+    }
+
+    LveGpuProfiler::Scope::~Scope() {
+        if (profiler) {
+            profiler->endScope(commandBuffer, scope);
+        }
+    }
+
+}  // namespace lve
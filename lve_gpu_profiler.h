@@ -0,0 +1,117 @@
+#pragma once
+
+#include "lve_device.h"
+
+// std lib headers
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lve {
+
+    // Timestamp query 기반 GPU 구간 측정
+    // - frame in flight마다 query pool 하나 (+ single-time command buffer용 immediate slot)
+    // - 결과는 같은 slot을 다시 쓸 때 (fence 대기 후) WAIT 없이 읽어서 rolling 통계에 추가
+    // - timestamp를 지원하지 않는 queue면 모든 호출이 no-op
+    class LveGpuProfiler {
+    public:
+        static constexpr uint32_t DEFAULT_MAX_SCOPES = 64;   // slot당 구간 수
+        static constexpr size_t HISTORY_SIZE = 512;          // 통계에 쓰는 최근 sample 수
+
+        LveGpuProfiler(LveDevice& device, uint32_t framesInFlight, uint32_t maxScopes = DEFAULT_MAX_SCOPES);
+        ~LveGpuProfiler();
+
+        LveGpuProfiler(const LveGpuProfiler&) = delete;
+        LveGpuProfiler& operator=(const LveGpuProfiler&) = delete;
+
+        bool isEnabled() const { return enabled; }
+
+        // Frame command buffer 시작 시 호출 (이 slot의 fence가 끝난 뒤여야 함)
+        // 지난번 결과 수집 + query reset 기록. 이후 beginScope는 이 slot을 사용
+        void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+        // 모든 frame slot의 남은 결과 수집 (vkDeviceWaitIdle 후, 통계 출력 전에), 제출 순서대로
+        void resolveFrames();
+
+        // beginSingleTimeCommands 직후 / endSingleTimeCommands 직후
+        void beginImmediate(VkCommandBuffer commandBuffer);
+        void resolveImmediate();
+
+        uint32_t beginScope(VkCommandBuffer commandBuffer, const std::string& name);
+        void endScope(VkCommandBuffer commandBuffer, uint32_t scope);
+
+        // RAII 구간 (profiler가 nullptr이면 아무것도 안 함)
+        class Scope {
+        public:
+            Scope(LveGpuProfiler* profiler, VkCommandBuffer commandBuffer, const std::string& name);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            LveGpuProfiler* profiler;
+            VkCommandBuffer commandBuffer;
+            uint32_t scope;
+        };
+
+        struct ScopeStatistics {
+            std::string name;
+            uint64_t totalSamples = 0;
+            size_t windowSamples = 0;
+            float minMs = 0.0f;
+            float avgMs = 0.0f;
+            float p99Ms = 0.0f;
+        };
+
+        std::vector<ScopeStatistics> getStatistics() const;
+
+        // 가장 최근에 수집된 한 구간 (framesInFlight 프레임 늦음). sampleIndex로 새 값인지 구분
+        bool getLatestSample(const std::string& name, float& ms, uint64_t& sampleIndex) const;
+        // sampleIndex 이후에 수집된 sample을 오래된 순으로 samples 뒤에 추가 (history에 남은 만큼), 새 sampleIndex 반환
+        uint64_t getSamplesSince(const std::string& name, uint64_t sampleIndex, std::vector<float>& samples) const;
+        void printStatistics() const;
+        void writeCsv(const std::string& path) const;
+
+    private:
+        static constexpr uint32_t INVALID_SCOPE = UINT32_MAX;
+
+        struct PendingScope {
+            uint32_t statIndex;
+            uint32_t firstQuery;
+            bool ended = false;
+        };
+
+        struct Slot {
+            VkQueryPool queryPool = VK_NULL_HANDLE;
+            std::vector<PendingScope> scopes;
+        };
+
+        struct ScopeHistory {
+            std::string name;
+            std::vector<float> samples;  // ring buffer (HISTORY_SIZE)
+            size_t next = 0;
+            uint64_t total = 0;
+        };
+
+        void collect(Slot& slot);
+        void resetSlot(VkCommandBuffer commandBuffer, Slot& slot);
+        uint32_t findOrAddHistory(const std::string& name);
+
+        LveDevice& lveDevice;
+        uint32_t maxScopes;
+        bool enabled = false;
+        float timestampPeriod = 1.0f;  // ns per tick
+        uint64_t timestampMask = ~0ull;
+
+        std::vector<Slot> slots;  // [0, framesInFlight) + immediate
+        uint32_t immediateSlot = 0;
+        uint32_t activeSlot = 0;
+        uint32_t previousActiveSlot = 0;
+
+        std::vector<ScopeHistory> histories;
+        std::unordered_map<std::string, uint32_t> historyIndices;
+    };
+
+}  // namespace lve
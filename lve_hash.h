@@ -0,0 +1,19 @@
+#pragma once
+
+// std lib headers
+#include <cstddef>
+#include <cstdint>
+
+namespace lve {
+
+    // FNV-1a 64 (이어서 해시할 수 있도록 seed를 받음) - mesh 중복 제거, AS 캐시 scene hash
+    inline uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+}  // namespace lve
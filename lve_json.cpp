@@ -0,0 +1,200 @@
+#include "lve_json.h"
+
+// std
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace lve {
+
+    namespace {
+        class JsonParser {
+        public:
+            JsonParser(const std::string& text, const std::string& source) : text{ text }, source{ source } {}
+
+            LveJsonValue parse() {
+                LveJsonValue value = parseValue();
+                skipWhitespace();
+                if (position != text.size()) {
+                    fail("unexpected trailing characters");
+                }
+                return value;
+            }
+
+        private:
+            [[noreturn]] void fail(const std::string& message) const {
+                size_t line = 1;
+                for (size_t i = 0; i < position && i < text.size(); i++) {
+                    if (text[i] == '\n') line++;
+                }
+                throw std::runtime_error(source + ":" + std::to_string(line) + ": " + message);
+            }
+
+            void skipWhitespace() {
+                while (position < text.size() &&
+                    (text[position] == ' ' || text[position] == '\t' || text[position] == '\n' || text[position] == '\r')) {
+                    position++;
+                }
+            }
+
+            char peek() {
+                skipWhitespace();
+                if (position >= text.size()) fail("unexpected end of file");
+                return text[position];
+            }
+
+            void expect(char c) {
+                if (peek() != c) fail(std::string("expected '") + c + "'");
+                position++;
+            }
+
+            bool consumeLiteral(const char* literal) {
+                const size_t length = std::strlen(literal);
+                if (text.compare(position, length, literal) != 0) return false;
+                position += length;
+                return true;
+            }
+
+            LveJsonValue parseValue() {
+                LveJsonValue value{};
+                const char c = peek();
+
+                if (c == '{') {
+                    value.type = LveJsonValue::Type::Object;
+                    position++;
+                    if (peek() == '}') {
+                        position++;
+                        return value;
+                    }
+                    while (true) {
+                        if (peek() != '"') fail("expected object key");
+                        std::string key = parseString();
+                        expect(':');
+                        value.object.emplace_back(std::move(key), parseValue());
+                        if (peek() == ',') {
+                            position++;
+                            continue;
+                        }
+                        expect('}');
+                        return value;
+                    }
+                }
+
+                if (c == '[') {
+                    value.type = LveJsonValue::Type::Array;
+                    position++;
+                    if (peek() == ']') {
+                        position++;
+                        return value;
+                    }
+                    while (true) {
+                        value.array.push_back(parseValue());
+                        if (peek() == ',') {
+                            position++;
+                            continue;
+                        }
+                        expect(']');
+                        return value;
+                    }
+                }
+
+                if (c == '"') {
+                    value.type = LveJsonValue::Type::String;
+                    value.string = parseString();
+                    return value;
+                }
+
+                if (consumeLiteral("true")) {
+                    value.type = LveJsonValue::Type::Bool;
+                    value.boolean = true;
+                    return value;
+                }
+                if (consumeLiteral("false")) {
+                    value.type = LveJsonValue::Type::Bool;
+                    return value;
+                }
+                if (consumeLiteral("null")) {
+                    return value;
+                }
+
+                // 숫자 (strtod가 JSON보다 느슨하지만 변환기에는 충분)
+                const char* begin = text.c_str() + position;
+                char* end = nullptr;
+                value.number = std::strtod(begin, &end);
+                if (end == begin) fail("unexpected character");
+                value.type = LveJsonValue::Type::Number;
+                position += static_cast<size_t>(end - begin);
+                return value;
+            }
+
+            std::string parseString() {
+                expect('"');
+                std::string result;
+                while (true) {
+                    if (position >= text.size()) fail("unterminated string");
+                    char c = text[position++];
+                    if (c == '"') return result;
+                    if (c != '\\') {
+                        result += c;
+                        continue;
+                    }
+
+                    if (position >= text.size()) fail("unterminated string");
+                    c = text[position++];
+                    switch (c) {
+                    case '"': result += '"'; break;
+                    case '\\': result += '\\'; break;
+                    case '/': result += '/'; break;
+                    case 'b': result += '\b'; break;
+                    case 'f': result += '\f'; break;
+                    case 'n': result += '\n'; break;
+                    case 'r': result += '\r'; break;
+                    case 't': result += '\t'; break;
+                    case 'u': {
+                        if (position + 4 > text.size()) fail("invalid \\u escape");
+                        const unsigned long code = std::strtoul(text.substr(position, 4).c_str(), nullptr, 16);
+                        position += 4;
+                        // BMP만 UTF-8로 (이름 / 주석용이므로 surrogate pair는 지원 안 함)
+                        if (code < 0x80) {
+                            result += static_cast<char>(code);
+                        }
+                        else if (code < 0x800) {
+                            result += static_cast<char>(0xC0 | (code >> 6));
+                            result += static_cast<char>(0x80 | (code & 0x3F));
+                        }
+                        else {
+                            result += static_cast<char>(0xE0 | (code >> 12));
+                            result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                            result += static_cast<char>(0x80 | (code & 0x3F));
+                        }
+                        break;
+                    }
+                    default:
+                        fail("invalid escape");
+                    }
+                }
+            }
+
+            const std::string& text;
+            const std::string& source;
+            size_t position = 0;
+        };
+    }
+
+    LveJsonValue LveJsonValue::parse(const std::string& text, const std::string& source) {
+        return JsonParser{ text, source }.parse();
+    }
+
+    LveJsonValue LveJsonValue::load(const std::string& path) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input) {
+            throw std::runtime_error("failed to open " + path);
+        }
+        std::stringstream buffer;
+        buffer << input.rdbuf();
+        return parse(buffer.str(), path);
+    }
+
+}  // namespace lve
@@ -0,0 +1,33 @@
+#pragma once
+
+// std lib headers
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lve {
+
+    // Scene 변환기 / glTF loader용 최소 JSON (DOM). 입력 파일 크기에서는 재귀 하강으로 충분
+    struct LveJsonValue {
+        enum class Type { Null, Bool, Number, String, Array, Object };
+
+        Type type = Type::Null;
+        bool boolean = false;
+        double number = 0.0;
+        std::string string;
+        std::vector<LveJsonValue> array;
+        std::vector<std::pair<std::string, LveJsonValue>> object;  // 파일 순서 유지
+
+        const LveJsonValue* find(const std::string& key) const {
+            for (const auto& member : object) {
+                if (member.first == key) return &member.second;
+            }
+            return nullptr;
+        }
+
+        // source는 오류 메시지용 이름 ("source:line: message")
+        static LveJsonValue parse(const std::string& text, const std::string& source);
+        static LveJsonValue load(const std::string& path);
+    };
+
+}  // namespace lve
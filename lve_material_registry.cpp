@@ -0,0 +1,45 @@
+#include "lve_material_registry.h"
+
+// std
+#include <stdexcept>
+
+namespace lve {
+
+    LveMaterialRegistry LveMaterialRegistry::createDefault(LveHitGroupMode mode, const std::string& closestHitShader) {
+        const bool specialized = mode == LveHitGroupMode::Specialized;
+
+        // Branching 모드도 record 수는 같게 유지 (instance offset이 두 모드에서 그대로 유효)
+        LveMaterialRegistry registry;
+        registry.registerMaterial("lambertian", closestHitShader, specialized ? 0 : -1);
+        registry.registerMaterial("metal", closestHitShader, specialized ? 1 : -1);
+        registry.registerMaterial("dielectric", closestHitShader, specialized ? 2 : -1);
+        registry.registerMaterial("emissive", closestHitShader, specialized ? 3 : -1);
+        return registry;
+    }
+
+    uint32_t LveMaterialRegistry::registerMaterial(
+        const std::string& name, const std::string& closestHitShader, int32_t specialization) {
+        uint32_t existing = 0;
+        if (findMaterial(name, existing)) {
+            throw std::runtime_error("material already registered: " + name);
+        }
+
+        materials.push_back({ name, closestHitShader, specialization });
+        return static_cast<uint32_t>(materials.size() - 1);
+    }
+
+    bool LveMaterialRegistry::findMaterial(const std::string& name, uint32_t& id) const {
+        for (uint32_t i = 0; i < materials.size(); i++) {
+            if (materials[i].name == name) {
+                id = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* hitGroupModeName(LveHitGroupMode mode) {
+        return mode == LveHitGroupMode::Specialized ? "specialized" : "branching";
+    }
+
+}  // namespace lve
@@ -0,0 +1,47 @@
+#pragma once
+
+// std lib headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+    enum class LveHitGroupMode {
+        Branching,    // 기본 material 모두 closesthit.rchit 하나에서 materialType으로 분기
+        Specialized   // 기본 material마다 MATERIAL_TYPE을 고정한 closest-hit (분기 제거)
+    };
+
+    // SBT hit record 하나 = material 하나
+    struct LveMaterial {
+        std::string name;
+        std::string closestHitShader;   // SPIR-V 경로
+        int32_t specialization = -1;    // closest-hit constant_id 0 (MATERIAL_TYPE), -1이면 설정 안 함
+    };
+
+    // 등록 순서 = material id = SphereInfo::materialType = instanceShaderBindingTableRecordOffset
+    // 새 material은 자기 closest-hit shader와 함께 등록만 하면 hit group / SBT record가 추가됨
+    class LveMaterialRegistry {
+    public:
+        static constexpr const char* DEFAULT_CLOSEST_HIT_SHADER = "shaders/closesthit.rchit.spv";
+
+        // lambertian (0) / metal (1) / dielectric (2) / emissive (3)
+        static LveMaterialRegistry createDefault(
+            LveHitGroupMode mode,
+            const std::string& closestHitShader = DEFAULT_CLOSEST_HIT_SHADER);
+
+        // 반환: material id. 같은 이름이 이미 있으면 예외
+        uint32_t registerMaterial(const std::string& name, const std::string& closestHitShader,
+            int32_t specialization = -1);
+        bool findMaterial(const std::string& name, uint32_t& id) const;
+
+        uint32_t getMaterialCount() const { return static_cast<uint32_t>(materials.size()); }
+        const LveMaterial& getMaterial(uint32_t id) const { return materials[id]; }
+
+    private:
+        std::vector<LveMaterial> materials;
+    };
+
+    const char* hitGroupModeName(LveHitGroupMode mode);
+
+}  // namespace lve
@@ -0,0 +1,379 @@
+#include "lve_memory_allocator.h"
+
+// std
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace lve {
+
+    namespace {
+        constexpr VkDeviceSize MAX_BLOCK_SIZE = 64ull * 1024 * 1024;
+        constexpr VkDeviceSize MIN_BLOCK_SIZE = 1ull * 1024 * 1024;
+
+        VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    LveMemoryAllocator::LveMemoryAllocator(VkDevice device, VkPhysicalDevice physicalDevice, bool bufferDeviceAddress)
+        : device{ device }, bufferDeviceAddress{ bufferDeviceAddress } {
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        bufferImageGranularity = std::max<VkDeviceSize>(properties.limits.bufferImageGranularity, 1);
+
+        // memory type마다 {Linear, OptimalImage} x {Persistent, Transient}
+        pools.resize(memoryProperties.memoryTypeCount * 4);
+        for (uint32_t type = 0; type < memoryProperties.memoryTypeCount; type++) {
+            for (uint32_t kind = 0; kind < 2; kind++) {
+                for (uint32_t usage = 0; usage < 2; usage++) {
+                    MemoryPool& pool = pools[poolIndex(
+                        type, static_cast<LveResourceKind>(kind), static_cast<LveMemoryUsage>(usage))];
+                    pool.memoryTypeIndex = type;
+                    pool.kind = static_cast<LveResourceKind>(kind);
+                    pool.linearArena = static_cast<LveMemoryUsage>(usage) == LveMemoryUsage::Transient;
+                }
+            }
+        }
+    }
+
+    LveMemoryAllocator::~LveMemoryAllocator() {
+        for (MemoryPool& pool : pools) {
+            for (auto& block : pool.blocks) {
+                if (block->liveAllocations > 0) {
+                    std::cerr << "memory allocator: block destroyed with " << block->liveAllocations
+                        << " live allocations" << std::endl;
+                }
+                destroyBlock(*block);
+            }
+            pool.blocks.clear();
+        }
+    }
+
+    uint32_t LveMemoryAllocator::poolIndex(uint32_t memoryTypeIndex, LveResourceKind kind, LveMemoryUsage usage) const {
+        return memoryTypeIndex * 4 + static_cast<uint32_t>(kind) * 2 + static_cast<uint32_t>(usage);
+    }
+
+    uint32_t LveMemoryAllocator::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if ((typeFilter & (1 << i)) &&
+                (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                return i;
+            }
+        }
+
+        throw std::runtime_error("failed to find suitable memory type!");
+    }
+
+    VkDeviceSize LveMemoryAllocator::preferredBlockSize(uint32_t memoryTypeIndex) const {
+        // 작은 heap (예: 256MB BAR)에서는 heap의 1/8까지만
+        uint32_t heapIndex = memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+        VkDeviceSize heapSize = memoryProperties.memoryHeaps[heapIndex].size;
+        return std::max(MIN_BLOCK_SIZE, std::min(MAX_BLOCK_SIZE, heapSize / 8));
+    }
+
+    VkDeviceMemory LveMemoryAllocator::allocateDeviceMemory(
+        VkDeviceSize size, uint32_t memoryTypeIndex, bool deviceAddress, void** mapped) {
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = size;
+        allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+        VkMemoryAllocateFlagsInfo allocFlagsInfo{};
+        if (deviceAddress) {
+            allocFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+            allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+            allocInfo.pNext = &allocFlagsInfo;
+        }
+
+        VkDeviceMemory memory;
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate device memory block!");
+        }
+        stats.allocateCalls++;
+
+        *mapped = nullptr;
+        if (memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+            // host visible block은 통째로 persistent map (sub-allocation마다 map 불가)
+            if (vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, mapped) != VK_SUCCESS) {
+                throw std::runtime_error("failed to map device memory block!");
+            }
+        }
+
+        return memory;
+    }
+
+    LveMemoryBlock* LveMemoryAllocator::createBlock(MemoryPool& pool, VkDeviceSize minSize) {
+        auto block = std::make_unique<LveMemoryBlock>();
+        block->size = std::max(preferredBlockSize(pool.memoryTypeIndex), minSize);
+        block->poolIndex = static_cast<uint32_t>(&pool - pools.data());
+
+        // buffer block은 buffer device address 사용 가능하게
+        bool deviceAddress = bufferDeviceAddress && pool.kind == LveResourceKind::Linear;
+        block->memory = allocateDeviceMemory(block->size, pool.memoryTypeIndex, deviceAddress, &block->mapped);
+
+        if (!pool.linearArena) {
+            block->freeRanges.push_back({ 0, block->size });
+        }
+
+        stats.blockCount++;
+        stats.blockBytes += block->size;
+
+        pool.blocks.push_back(std::move(block));
+        return pool.blocks.back().get();
+    }
+
+    void LveMemoryAllocator::destroyBlock(LveMemoryBlock& block) {
+        if (block.mapped != nullptr) {
+            vkUnmapMemory(device, block.memory);
+        }
+        vkFreeMemory(device, block.memory, nullptr);
+
+        stats.blockCount--;
+        stats.blockBytes -= block.size;
+    }
+
+    bool LveMemoryAllocator::allocateFromFreeList(
+        LveMemoryBlock& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) {
+        // First-fit
+        for (size_t i = 0; i < block.freeRanges.size(); i++) {
+            LveMemoryBlock::FreeRange& range = block.freeRanges[i];
+
+            VkDeviceSize alignedOffset = alignUp(range.offset, alignment);
+            VkDeviceSize padding = alignedOffset - range.offset;
+            if (padding + size > range.size) {
+                continue;
+            }
+
+            VkDeviceSize rangeEnd = range.offset + range.size;
+            VkDeviceSize allocEnd = alignedOffset + size;
+
+            if (padding > 0) {
+                // 앞쪽 padding은 free로 남기고, 뒤쪽 나머지는 새 구간
+                range.size = padding;
+                if (allocEnd < rangeEnd) {
+                    block.freeRanges.insert(block.freeRanges.begin() + i + 1, { allocEnd, rangeEnd - allocEnd });
+                }
+            }
+            else if (allocEnd < rangeEnd) {
+                range.offset = allocEnd;
+                range.size = rangeEnd - allocEnd;
+            }
+            else {
+                block.freeRanges.erase(block.freeRanges.begin() + i);
+            }
+
+            offset = alignedOffset;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool LveMemoryAllocator::allocateFromArena(
+        LveMemoryBlock& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) {
+        VkDeviceSize alignedOffset = alignUp(block.linearHead, alignment);
+        if (alignedOffset + size > block.size) {
+            return false;
+        }
+
+        block.linearHead = alignedOffset + size;
+        offset = alignedOffset;
+        return true;
+    }
+
+    void LveMemoryAllocator::releaseToFreeList(LveMemoryBlock& block, VkDeviceSize offset, VkDeviceSize size) {
+        auto& ranges = block.freeRanges;
+
+        auto it = std::lower_bound(ranges.begin(), ranges.end(), offset,
+            [](const LveMemoryBlock::FreeRange& range, VkDeviceSize value) { return range.offset < value; });
+        it = ranges.insert(it, { offset, size });
+
+        // 뒤 구간과 병합
+        auto next = it + 1;
+        if (next != ranges.end() && it->offset + it->size == next->offset) {
+            it->size += next->size;
+            ranges.erase(next);
+        }
+
+        // 앞 구간과 병합
+        if (it != ranges.begin()) {
+            auto prev = it - 1;
+            if (prev->offset + prev->size == it->offset) {
+                prev->size += it->size;
+                ranges.erase(it);
+            }
+        }
+    }
+
+    void LveMemoryAllocator::releaseEmptyBlocks(MemoryPool& pool) {
+        // 빈 block은 하나만 남겨두고 반환 (alloc/free 반복 시 vkAllocateMemory 재호출 방지)
+        bool keptEmpty = false;
+        for (auto it = pool.blocks.begin(); it != pool.blocks.end();) {
+            if ((*it)->liveAllocations == 0) {
+                if (!keptEmpty) {
+                    keptEmpty = true;
+                    ++it;
+                    continue;
+                }
+                destroyBlock(**it);
+                it = pool.blocks.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    LveAllocation LveMemoryAllocator::allocate(
+        const VkMemoryRequirements& requirements,
+        VkMemoryPropertyFlags properties,
+        LveResourceKind kind,
+        LveMemoryUsage usage
+    ) {
+        std::lock_guard<std::mutex> lock{ mutex };
+
+        uint32_t memoryTypeIndex = findMemoryType(requirements.memoryTypeBits, properties);
+        MemoryPool& pool = pools[poolIndex(memoryTypeIndex, kind, usage)];
+
+        VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+        if (kind == LveResourceKind::OptimalImage) {
+            alignment = std::max(alignment, bufferImageGranularity);
+        }
+
+        LveAllocation allocation{};
+        allocation.size = requirements.size;
+        allocation.memoryTypeIndex = memoryTypeIndex;
+
+        // 큰 리소스는 block을 낭비하지 않도록 전용 할당
+        if (requirements.size > preferredBlockSize(memoryTypeIndex) / 2) {
+            bool deviceAddress = bufferDeviceAddress && kind == LveResourceKind::Linear;
+            allocation.memory = allocateDeviceMemory(requirements.size, memoryTypeIndex, deviceAddress, &allocation.mapped);
+            allocation.dedicated = true;
+
+            stats.dedicatedCount++;
+            stats.dedicatedBytes += requirements.size;
+            return allocation;
+        }
+
+        VkDeviceSize offset = 0;
+        LveMemoryBlock* target = nullptr;
+
+        for (auto& block : pool.blocks) {
+            if (pool.linearArena) {
+                // 비어있는 arena는 처음부터 다시 사용
+                if (block->liveAllocations == 0) {
+                    block->linearHead = 0;
+                }
+                if (allocateFromArena(*block, requirements.size, alignment, offset)) {
+                    target = block.get();
+                    break;
+                }
+            }
+            else if (allocateFromFreeList(*block, requirements.size, alignment, offset)) {
+                target = block.get();
+                break;
+            }
+        }
+
+        if (target == nullptr) {
+            target = createBlock(pool, requirements.size);
+            bool allocated = pool.linearArena
+                ? allocateFromArena(*target, requirements.size, alignment, offset)
+                : allocateFromFreeList(*target, requirements.size, alignment, offset);
+            if (!allocated) {
+                throw std::runtime_error("failed to sub-allocate from new memory block!");
+            }
+        }
+
+        target->liveAllocations++;
+        target->usedBytes += requirements.size;
+
+        stats.allocationCount++;
+        stats.usedBytes += requirements.size;
+        stats.peakUsedBytes = std::max(stats.peakUsedBytes, stats.usedBytes);
+
+        allocation.memory = target->memory;
+        allocation.offset = offset;
+        allocation.block = target;
+        if (target->mapped != nullptr) {
+            allocation.mapped = static_cast<char*>(target->mapped) + offset;
+        }
+
+        return allocation;
+    }
+
+    void LveMemoryAllocator::free(LveAllocation& allocation) {
+        if (allocation.memory == VK_NULL_HANDLE) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock{ mutex };
+
+        if (allocation.dedicated) {
+            if (allocation.mapped != nullptr) {
+                vkUnmapMemory(device, allocation.memory);
+            }
+            vkFreeMemory(device, allocation.memory, nullptr);
+
+            stats.dedicatedCount--;
+            stats.dedicatedBytes -= allocation.size;
+        }
+        else {
+            LveMemoryBlock& block = *allocation.block;
+            MemoryPool& pool = pools[block.poolIndex];
+
+            if (!pool.linearArena) {
+                releaseToFreeList(block, allocation.offset, allocation.size);
+            }
+            block.liveAllocations--;
+            block.usedBytes -= allocation.size;
+
+            stats.allocationCount--;
+            stats.usedBytes -= allocation.size;
+
+            if (block.liveAllocations == 0) {
+                releaseEmptyBlocks(pool);
+            }
+        }
+
+        allocation = LveAllocation{};
+    }
+
+    LveMemoryStatistics LveMemoryAllocator::getStatistics() {
+        std::lock_guard<std::mutex> lock{ mutex };
+        return stats;
+    }
+
+    void LveMemoryAllocator::printStatistics() {
+        std::lock_guard<std::mutex> lock{ mutex };
+
+        const double MB = 1024.0 * 1024.0;
+        std::cout << "Device memory allocator:" << std::endl;
+        std::cout << "  vkAllocateMemory calls: " << stats.allocateCalls << std::endl;
+        std::cout << "  blocks: " << stats.blockCount << " (" << stats.blockBytes / MB << " MB), used "
+            << stats.usedBytes / MB << " MB in " << stats.allocationCount << " allocations" << std::endl;
+        std::cout << "  dedicated: " << stats.dedicatedCount << " (" << stats.dedicatedBytes / MB << " MB)" << std::endl;
+        std::cout << "  peak used: " << stats.peakUsedBytes / MB << " MB" << std::endl;
+
+        for (const MemoryPool& pool : pools) {
+            if (pool.blocks.empty()) continue;
+
+            VkDeviceSize poolBytes = 0;
+            VkDeviceSize poolUsed = 0;
+            for (const auto& block : pool.blocks) {
+                poolBytes += block->size;
+                poolUsed += block->usedBytes;
+            }
+
+            std::cout << "  type " << pool.memoryTypeIndex
+                << (pool.kind == LveResourceKind::OptimalImage ? " image" : " linear")
+                << (pool.linearArena ? " arena" : " free-list")
+                << ": " << pool.blocks.size() << " blocks, "
+                << poolUsed / MB << " / " << poolBytes / MB << " MB" << std::endl;
+        }
+    }
+
+}  // namespace lve
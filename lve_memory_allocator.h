@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+// std lib headers
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace lve {
+
+    // 할당 수명 힌트
+    enum class LveMemoryUsage {
+        Persistent,  // 오래 사는 리소스 (AS, vertex/index, SBT, storage image): free-list block
+        Transient    // scratch / staging: linear arena, block의 live 할당이 0이 되면 통째로 reset
+    };
+
+    // bufferImageGranularity 때문에 linear(buffer, linear image)와 optimal image는 다른 block 사용
+    enum class LveResourceKind {
+        Linear,
+        OptimalImage
+    };
+
+    // Block 하나 (VkDeviceMemory 하나를 여러 리소스가 나눠 씀)
+    struct LveMemoryBlock {
+        struct FreeRange {
+            VkDeviceSize offset;
+            VkDeviceSize size;
+        };
+
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        void* mapped = nullptr;
+        uint32_t poolIndex = 0;
+
+        std::vector<FreeRange> freeRanges;  // free-list (offset 순, 인접 구간은 병합)
+        VkDeviceSize linearHead = 0;        // linear arena bump pointer
+        uint32_t liveAllocations = 0;
+        VkDeviceSize usedBytes = 0;
+    };
+
+    // Sub-allocation 결과 - VkDeviceMemory는 block 소유, offset 위치에 bind
+    struct LveAllocation {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        void* mapped = nullptr;  // HOST_VISIBLE이면 persistent map 주소 (offset 적용됨)
+
+        // allocator 내부용
+        LveMemoryBlock* block = nullptr;
+        uint32_t memoryTypeIndex = 0;
+        bool dedicated = false;
+    };
+
+    struct LveMemoryStatistics {
+        uint32_t allocateCalls = 0;      // 누적 vkAllocateMemory 호출 수
+        uint32_t blockCount = 0;
+        uint32_t dedicatedCount = 0;
+        uint32_t allocationCount = 0;    // 현재 살아있는 sub-allocation 수
+        VkDeviceSize blockBytes = 0;     // block으로 잡아둔 총 메모리
+        VkDeviceSize usedBytes = 0;      // block 안에서 실제 사용 중
+        VkDeviceSize dedicatedBytes = 0;
+        VkDeviceSize peakUsedBytes = 0;
+    };
+
+    class LveMemoryAllocator {
+    public:
+        LveMemoryAllocator(VkDevice device, VkPhysicalDevice physicalDevice, bool bufferDeviceAddress);
+        ~LveMemoryAllocator();
+
+        LveMemoryAllocator(const LveMemoryAllocator&) = delete;
+        LveMemoryAllocator& operator=(const LveMemoryAllocator&) = delete;
+
+        LveAllocation allocate(
+            const VkMemoryRequirements& requirements,
+            VkMemoryPropertyFlags properties,
+            LveResourceKind kind,
+            LveMemoryUsage usage);
+        void free(LveAllocation& allocation);
+
+        uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+
+        LveMemoryStatistics getStatistics();
+        void printStatistics();
+
+    private:
+        // memory type x resource kind x usage 마다 하나
+        struct MemoryPool {
+            uint32_t memoryTypeIndex = 0;
+            LveResourceKind kind = LveResourceKind::Linear;
+            bool linearArena = false;
+            std::vector<std::unique_ptr<LveMemoryBlock>> blocks;
+        };
+
+        uint32_t poolIndex(uint32_t memoryTypeIndex, LveResourceKind kind, LveMemoryUsage usage) const;
+        VkDeviceSize preferredBlockSize(uint32_t memoryTypeIndex) const;
+
+        VkDeviceMemory allocateDeviceMemory(
+            VkDeviceSize size, uint32_t memoryTypeIndex, bool deviceAddress, void** mapped);
+        LveMemoryBlock* createBlock(MemoryPool& pool, VkDeviceSize minSize);
+        void destroyBlock(LveMemoryBlock& block);
+
+        bool allocateFromFreeList(LveMemoryBlock& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+        bool allocateFromArena(LveMemoryBlock& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+        void releaseToFreeList(LveMemoryBlock& block, VkDeviceSize offset, VkDeviceSize size);
+        void releaseEmptyBlocks(MemoryPool& pool);
+
+        VkDevice device;
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        VkDeviceSize bufferImageGranularity = 1;
+        bool bufferDeviceAddress;
+
+        std::vector<MemoryPool> pools;
+        LveMemoryStatistics stats{};
+        std::mutex mutex;
+    };
+
+}  // namespace lve
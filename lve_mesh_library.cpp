@@ -0,0 +1,779 @@
+#include "lve_mesh_library.h"
+#include "lve_hash.h"
+#include "lve_json.h"
+
+// std
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace lve {
+
+    namespace {
+        // 면적 가중 vertex normal (cross product 길이 = 삼각형 면적 × 2)
+        // generate가 비어있으면 모든 vertex, 아니면 generate[i]인 vertex만 (파일에 있던 normal은 유지)
+        void generateNormals(std::vector<LveMeshVertex>& vertices, const std::vector<uint32_t>& indices,
+            const std::vector<bool>& generate = {}) {
+            auto selected = [&](size_t index) { return generate.empty() || generate[index]; };
+
+            std::vector<glm::vec3> sums(vertices.size(), glm::vec3(0.0f));
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                const glm::vec3& a = vertices[indices[i + 0]].position;
+                const glm::vec3& b = vertices[indices[i + 1]].position;
+                const glm::vec3& c = vertices[indices[i + 2]].position;
+                const glm::vec3 faceNormal = glm::cross(b - a, c - a);
+                sums[indices[i + 0]] += faceNormal;
+                sums[indices[i + 1]] += faceNormal;
+                sums[indices[i + 2]] += faceNormal;
+            }
+            for (size_t i = 0; i < vertices.size(); i++) {
+                if (!selected(i)) continue;
+                const float length = glm::length(sums[i]);
+                vertices[i].normal = length > 0.0f ? sums[i] / length : glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        }
+
+        std::string directoryOf(const std::string& path) {
+            const size_t slash = path.find_last_of("/\\");
+            return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+        }
+
+        std::string extensionOf(const std::string& path) {
+            const size_t dot = path.find_last_of('.');
+            if (dot == std::string::npos) return std::string();
+            std::string extension = path.substr(dot + 1);
+            std::transform(extension.begin(), extension.end(), extension.begin(),
+                [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+            return extension;
+        }
+
+        std::vector<uint8_t> readBinaryFile(const std::string& path) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file) {
+                throw std::runtime_error("failed to open " + path);
+            }
+            std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            return bytes;
+        }
+
+        // ===== OBJ =====
+
+        // "v/vt/vn" 하나 (0 = 없음, 파일 안의 1-based index를 0-based + 1로 정규화)
+        struct ObjCorner {
+            int position = 0;
+            int texcoord = 0;
+            int normal = 0;
+
+            bool operator==(const ObjCorner& other) const {
+                return position == other.position && texcoord == other.texcoord && normal == other.normal;
+            }
+        };
+
+        struct ObjCornerHash {
+            size_t operator()(const ObjCorner& corner) const {
+                return static_cast<size_t>(hashBytes(&corner, sizeof(corner)));
+            }
+        };
+
+        // 음수 index는 지금까지 읽은 목록 끝에서부터
+        int resolveObjIndex(int index, size_t count, const std::string& context) {
+            const int resolved = index < 0 ? static_cast<int>(count) + index + 1 : index;
+            if (resolved < 1 || resolved > static_cast<int>(count)) {
+                throw std::runtime_error(context + ": index out of range");
+            }
+            return resolved;
+        }
+
+        ObjCorner parseObjCorner(const std::string& token, size_t positionCount, size_t texcoordCount, size_t normalCount,
+            const std::string& context) {
+            ObjCorner corner{};
+            const size_t firstSlash = token.find('/');
+            corner.position = resolveObjIndex(std::stoi(token.substr(0, firstSlash)), positionCount, context);
+            if (firstSlash == std::string::npos) return corner;
+
+            const size_t secondSlash = token.find('/', firstSlash + 1);
+            const std::string texcoord = token.substr(firstSlash + 1, secondSlash - firstSlash - 1);
+            if (!texcoord.empty()) {
+                corner.texcoord = resolveObjIndex(std::stoi(texcoord), texcoordCount, context);
+            }
+            if (secondSlash != std::string::npos && secondSlash + 1 < token.size()) {
+                corner.normal = resolveObjIndex(std::stoi(token.substr(secondSlash + 1)), normalCount, context);
+            }
+            return corner;
+        }
+
+        // ===== glTF =====
+
+        constexpr uint32_t GLB_MAGIC = 0x46546C67;       // "glTF"
+        constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;  // "JSON"
+        constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;   // "BIN\0"
+
+        constexpr uint32_t GLTF_BYTE = 5120;
+        constexpr uint32_t GLTF_UNSIGNED_BYTE = 5121;
+        constexpr uint32_t GLTF_SHORT = 5122;
+        constexpr uint32_t GLTF_UNSIGNED_SHORT = 5123;
+        constexpr uint32_t GLTF_UNSIGNED_INT = 5125;
+        constexpr uint32_t GLTF_FLOAT = 5126;
+        constexpr uint32_t GLTF_TRIANGLES = 4;
+
+        std::vector<uint8_t> decodeBase64(const std::string& text, const std::string& context) {
+            auto decodeChar = [&](char c) -> uint32_t {
+                if (c >= 'A' && c <= 'Z') return static_cast<uint32_t>(c - 'A');
+                if (c >= 'a' && c <= 'z') return static_cast<uint32_t>(c - 'a' + 26);
+                if (c >= '0' && c <= '9') return static_cast<uint32_t>(c - '0' + 52);
+                if (c == '+') return 62;
+                if (c == '/') return 63;
+                throw std::runtime_error(context + ": invalid base64 data");
+            };
+
+            std::vector<uint8_t> bytes;
+            bytes.reserve(text.size() / 4 * 3);
+            uint32_t accumulator = 0;
+            int bits = 0;
+            for (char c : text) {
+                if (c == '=') break;
+                accumulator = (accumulator << 6) | decodeChar(c);
+                bits += 6;
+                if (bits >= 8) {
+                    bits -= 8;
+                    bytes.push_back(static_cast<uint8_t>((accumulator >> bits) & 0xFF));
+                }
+            }
+            return bytes;
+        }
+
+        // glTF 객체 필드 읽기 (없으면 fallback, 타입이 다르면 오류)
+        int64_t gltfInt(const LveJsonValue& object, const char* key, int64_t fallback, const std::string& context) {
+            const LveJsonValue* value = object.find(key);
+            if (!value) return fallback;
+            if (value->type != LveJsonValue::Type::Number) {
+                throw std::runtime_error(context + ": \"" + key + "\" must be a number");
+            }
+            return static_cast<int64_t>(value->number);
+        }
+
+        const LveJsonValue& gltfElement(const LveJsonValue& root, const char* table, int64_t index, const std::string& context) {
+            const LveJsonValue* array = root.find(table);
+            if (!array || array->type != LveJsonValue::Type::Array || index < 0 ||
+                index >= static_cast<int64_t>(array->array.size())) {
+                throw std::runtime_error(context + ": " + table + "[" + std::to_string(index) + "] does not exist");
+            }
+            return array->array[static_cast<size_t>(index)];
+        }
+
+        // accessor 하나를 buffer 안의 strided view로 (bufferView / offset 범위 검증 포함)
+        struct GltfAccessor {
+            const uint8_t* data = nullptr;
+            uint32_t count = 0;
+            uint32_t componentType = 0;
+            uint32_t components = 0;
+            size_t stride = 0;
+            bool normalized = false;
+
+            float readFloat(uint32_t element, uint32_t component) const {
+                const uint8_t* p = data + element * stride;
+                switch (componentType) {
+                case GLTF_FLOAT: {
+                    float value;
+                    std::memcpy(&value, p + component * 4, 4);
+                    return value;
+                }
+                case GLTF_UNSIGNED_BYTE: {
+                    const float value = static_cast<float>(p[component]);
+                    return normalized ? value / 255.0f : value;
+                }
+                case GLTF_UNSIGNED_SHORT: {
+                    uint16_t value;
+                    std::memcpy(&value, p + component * 2, 2);
+                    return normalized ? static_cast<float>(value) / 65535.0f : static_cast<float>(value);
+                }
+                case GLTF_BYTE: {
+                    const float value = static_cast<float>(static_cast<int8_t>(p[component]));
+                    return normalized ? std::max(value / 127.0f, -1.0f) : value;
+                }
+                case GLTF_SHORT: {
+                    int16_t value;
+                    std::memcpy(&value, p + component * 2, 2);
+                    return normalized ? std::max(static_cast<float>(value) / 32767.0f, -1.0f) : static_cast<float>(value);
+                }
+                default:
+                    return 0.0f;
+                }
+            }
+
+            uint32_t readIndex(uint32_t element) const {
+                const uint8_t* p = data + element * stride;
+                if (componentType == GLTF_UNSIGNED_BYTE) return p[0];
+                if (componentType == GLTF_UNSIGNED_SHORT) {
+                    uint16_t value;
+                    std::memcpy(&value, p, 2);
+                    return value;
+                }
+                uint32_t value;
+                std::memcpy(&value, p, 4);
+                return value;
+            }
+        };
+
+        uint32_t gltfComponentSize(uint32_t componentType) {
+            switch (componentType) {
+            case GLTF_BYTE:
+            case GLTF_UNSIGNED_BYTE: return 1;
+            case GLTF_SHORT:
+            case GLTF_UNSIGNED_SHORT: return 2;
+            case GLTF_UNSIGNED_INT:
+            case GLTF_FLOAT: return 4;
+            default: return 0;
+            }
+        }
+
+        uint32_t gltfComponentCount(const std::string& type) {
+            if (type == "SCALAR") return 1;
+            if (type == "VEC2") return 2;
+            if (type == "VEC3") return 3;
+            if (type == "VEC4") return 4;
+            return 0;
+        }
+
+        GltfAccessor gltfAccessor(const LveJsonValue& root, const std::vector<std::vector<uint8_t>>& buffers,
+            int64_t index, const std::string& context) {
+            const std::string accessorContext = context + ": accessors[" + std::to_string(index) + "]";
+            const LveJsonValue& accessor = gltfElement(root, "accessors", index, context);
+            if (accessor.find("sparse")) {
+                throw std::runtime_error(accessorContext + ": sparse accessors are not supported");
+            }
+
+            // 음수를 size_t로 바꾸면 거대한 값이 되어 범위 검사를 우회하므로 먼저 거부
+            auto readSize = [&](const LveJsonValue& object, const char* key) {
+                const int64_t value = gltfInt(object, key, 0, accessorContext);
+                if (value < 0) {
+                    throw std::runtime_error(accessorContext + ": negative \"" + key + "\"");
+                }
+                return static_cast<uint64_t>(value);
+            };
+
+            GltfAccessor view{};
+            const uint64_t count = readSize(accessor, "count");
+            if (count > UINT32_MAX) {
+                throw std::runtime_error(accessorContext + ": count too large");
+            }
+            view.count = static_cast<uint32_t>(count);
+            view.componentType = static_cast<uint32_t>(gltfInt(accessor, "componentType", 0, accessorContext));
+            const LveJsonValue* type = accessor.find("type");
+            view.components = type && type->type == LveJsonValue::Type::String ? gltfComponentCount(type->string) : 0;
+            const LveJsonValue* normalized = accessor.find("normalized");
+            view.normalized = normalized && normalized->type == LveJsonValue::Type::Bool && normalized->boolean;
+
+            const uint32_t componentSize = gltfComponentSize(view.componentType);
+            if (componentSize == 0 || view.components == 0) {
+                throw std::runtime_error(accessorContext + ": unsupported component type");
+            }
+
+            const int64_t bufferViewIndex = gltfInt(accessor, "bufferView", -1, accessorContext);
+            if (bufferViewIndex < 0) {
+                throw std::runtime_error(accessorContext + ": accessors without a bufferView are not supported");
+            }
+            const LveJsonValue& bufferView = gltfElement(root, "bufferViews", bufferViewIndex, context);
+            const int64_t bufferIndex = gltfInt(bufferView, "buffer", -1, accessorContext);
+            if (bufferIndex < 0 || bufferIndex >= static_cast<int64_t>(buffers.size())) {
+                throw std::runtime_error(accessorContext + ": invalid buffer");
+            }
+            const std::vector<uint8_t>& buffer = buffers[static_cast<size_t>(bufferIndex)];
+
+            const uint64_t elementSize = static_cast<uint64_t>(componentSize) * view.components;
+            const uint64_t viewOffset = readSize(bufferView, "byteOffset");
+            const uint64_t viewLength = readSize(bufferView, "byteLength");
+            const uint64_t accessorOffset = readSize(accessor, "byteOffset");
+            uint64_t stride = readSize(bufferView, "byteStride");
+            if (stride == 0) stride = elementSize;
+
+            // 덧셈 / 곱셈 대신 남은 크기와 비교 (overflow로 검사를 통과하지 않도록)
+            const uint64_t bufferSize = buffer.size();
+            bool inRange = viewOffset <= bufferSize && viewLength <= bufferSize - viewOffset;
+            if (inRange && view.count > 0) {
+                inRange = accessorOffset <= viewLength && elementSize <= viewLength - accessorOffset &&
+                    view.count - 1 <= (viewLength - accessorOffset - elementSize) / stride;
+            }
+            if (!inRange) {
+                throw std::runtime_error(accessorContext + ": out of buffer range");
+            }
+            view.stride = static_cast<size_t>(stride);
+
+            view.data = buffer.data() + static_cast<size_t>(viewOffset + accessorOffset);
+            return view;
+        }
+
+        glm::mat4 gltfNodeTransform(const LveJsonValue& node, const std::string& context) {
+            auto readNumbers = [&](const char* key, size_t count, float* out) {
+                const LveJsonValue* value = node.find(key);
+                if (!value) return false;
+                if (value->type != LveJsonValue::Type::Array || value->array.size() != count) {
+                    throw std::runtime_error(context + ": \"" + key + "\" must have " + std::to_string(count) + " numbers");
+                }
+                for (size_t i = 0; i < count; i++) {
+                    out[i] = static_cast<float>(value->array[i].number);
+                }
+                return true;
+            };
+
+            // matrix는 column-major (glm과 같음)
+            float matrix[16];
+            if (readNumbers("matrix", 16, matrix)) {
+                glm::mat4 result{};
+                for (int column = 0; column < 4; column++) {
+                    for (int row = 0; row < 4; row++) {
+                        result[column][row] = matrix[column * 4 + row];
+                    }
+                }
+                return result;
+            }
+
+            float translation[3] = { 0.0f, 0.0f, 0.0f };
+            float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };  // quaternion x, y, z, w
+            float scale[3] = { 1.0f, 1.0f, 1.0f };
+            readNumbers("translation", 3, translation);
+            readNumbers("rotation", 4, rotation);
+            readNumbers("scale", 3, scale);
+
+            const float x = rotation[0], y = rotation[1], z = rotation[2], w = rotation[3];
+            glm::mat4 result{ 1.0f };
+            result[0] = glm::vec4(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + z * w), 2.0f * (x * z - y * w), 0.0f) * scale[0];
+            result[1] = glm::vec4(2.0f * (x * y - z * w), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + x * w), 0.0f) * scale[1];
+            result[2] = glm::vec4(2.0f * (x * z + y * w), 2.0f * (y * z - x * w), 1.0f - 2.0f * (x * x + y * y), 0.0f) * scale[2];
+            result[3] = glm::vec4(translation[0], translation[1], translation[2], 1.0f);
+            return result;
+        }
+    }
+
+    LveMeshHandle LveMeshLibrary::addMesh(
+        const std::string& name, std::vector<LveMeshVertex> vertices, std::vector<uint32_t> indices) {
+        if (vertices.empty() || indices.empty() || indices.size() % 3 != 0) {
+            throw std::runtime_error("mesh " + name + " has no triangles");
+        }
+        for (uint32_t index : indices) {
+            if (index >= vertices.size()) {
+                throw std::runtime_error("mesh " + name + " has an index out of range");
+            }
+        }
+
+        uint64_t hash = hashBytes(vertices.data(), sizeof(LveMeshVertex) * vertices.size());
+        hash = hashBytes(indices.data(), sizeof(uint32_t) * indices.size(), hash);
+
+        // hash가 같아도 내용이 같을 때만 재사용
+        auto range = meshesByHash.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            const LveMesh& existing = meshes[it->second];
+            if (existing.vertices.size() == vertices.size() && existing.indices.size() == indices.size() &&
+                std::memcmp(existing.vertices.data(), vertices.data(), sizeof(LveMeshVertex) * vertices.size()) == 0 &&
+                std::memcmp(existing.indices.data(), indices.data(), sizeof(uint32_t) * indices.size()) == 0) {
+                duplicateCount++;
+                std::cout << "Mesh " << name << " is a duplicate of " << existing.name << std::endl;
+                return it->second + 1;
+            }
+        }
+
+        LveMesh mesh{};
+        mesh.name = name;
+        mesh.hash = hash;
+        for (const LveMeshVertex& vertex : vertices) {
+            mesh.boundingRadius = std::max(mesh.boundingRadius, glm::length(vertex.position));
+        }
+        mesh.vertices = std::move(vertices);
+        mesh.indices = std::move(indices);
+
+        const uint32_t index = static_cast<uint32_t>(meshes.size());
+        meshesByHash.emplace(hash, index);
+        meshes.push_back(std::move(mesh));
+        return index + 1;
+    }
+
+    const LveMesh& LveMeshLibrary::getMesh(LveMeshHandle handle) const {
+        if (handle == INVALID_MESH_HANDLE || handle > meshes.size()) {
+            throw std::runtime_error("invalid mesh handle " + std::to_string(handle));
+        }
+        return meshes[handle - 1];
+    }
+
+    std::vector<LveMeshNode> LveMeshLibrary::load(const std::string& path) {
+        const std::string extension = extensionOf(path);
+        if (extension == "gltf" || extension == "glb") {
+            return loadGltf(path);
+        }
+        if (extension == "obj") {
+            LveMeshNode node{};
+            node.mesh = loadObj(path);
+            return { node };
+        }
+        throw std::runtime_error("unsupported mesh format (expected .obj, .gltf or .glb): " + path);
+    }
+
+    LveMeshHandle LveMeshLibrary::loadObj(const std::string& path) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("failed to open mesh: " + path);
+        }
+
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> texcoords;
+        std::vector<glm::vec3> normals;
+
+        std::vector<LveMeshVertex> vertices;
+        std::vector<uint32_t> indices;
+        std::unordered_map<ObjCorner, uint32_t, ObjCornerHash> cornerVertices;  // 같은 v/vt/vn 조합은 vertex 하나
+        std::vector<uint32_t> polygon;
+        std::vector<bool> missingNormal;  // vertex별: face corner에 vn이 없었음
+        bool missingNormals = false;
+
+        std::string line;
+        uint32_t lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+            std::istringstream stream(line);
+            std::string keyword;
+            if (!(stream >> keyword) || keyword[0] == '#') continue;
+
+            const std::string context = path + ":" + std::to_string(lineNumber);
+            if (keyword == "v") {
+                glm::vec3 position{};
+                if (!(stream >> position.x >> position.y >> position.z)) {
+                    throw std::runtime_error(context + ": expected \"v x y z\"");
+                }
+                positions.push_back(position);
+            }
+            else if (keyword == "vt") {
+                glm::vec2 texcoord{};
+                if (!(stream >> texcoord.x)) {
+                    throw std::runtime_error(context + ": expected \"vt u v\"");
+                }
+                stream >> texcoord.y;
+                texcoords.push_back(texcoord);
+            }
+            else if (keyword == "vn") {
+                glm::vec3 normal{};
+                if (!(stream >> normal.x >> normal.y >> normal.z)) {
+                    throw std::runtime_error(context + ": expected \"vn x y z\"");
+                }
+                normals.push_back(normal);
+            }
+            else if (keyword == "f") {
+                polygon.clear();
+                std::string token;
+                while (stream >> token) {
+                    ObjCorner corner{};
+                    try {
+                        corner = parseObjCorner(token, positions.size(), texcoords.size(), normals.size(), context);
+                    }
+                    catch (const std::logic_error&) {  // stoi: invalid_argument / out_of_range
+                        throw std::runtime_error(context + ": invalid face index \"" + token + "\"");
+                    }
+
+                    auto it = cornerVertices.find(corner);
+                    if (it == cornerVertices.end()) {
+                        LveMeshVertex vertex{};
+                        vertex.position = positions[corner.position - 1];
+                        if (corner.texcoord > 0) {
+                            // OBJ는 v가 아래에서 위로 - glTF와 같은 방향 (위에서 아래)으로 뒤집음
+                            vertex.u = texcoords[corner.texcoord - 1].x;
+                            vertex.v = 1.0f - texcoords[corner.texcoord - 1].y;
+                        }
+                        if (corner.normal > 0) {
+                            vertex.normal = normals[corner.normal - 1];
+                        }
+                        else {
+                            missingNormals = true;
+                        }
+                        it = cornerVertices.emplace(corner, static_cast<uint32_t>(vertices.size())).first;
+                        vertices.push_back(vertex);
+                        missingNormal.push_back(corner.normal == 0);
+                    }
+                    polygon.push_back(it->second);
+                }
+
+                if (polygon.size() < 3) {
+                    throw std::runtime_error(context + ": face needs at least 3 vertices");
+                }
+                // 볼록 다각형 가정, fan 분할
+                for (size_t i = 1; i + 1 < polygon.size(); i++) {
+                    indices.push_back(polygon[0]);
+                    indices.push_back(polygon[i]);
+                    indices.push_back(polygon[i + 1]);
+                }
+            }
+            // mtllib / usemtl / o / g / s: material은 instance 단위로 지정하므로 무시
+        }
+
+        // vn이 없는 corner의 vertex만 face normal로 채움 (vn이 있는 corner는 별도 vertex라 영향 없음)
+        if (missingNormals) {
+            generateNormals(vertices, indices, missingNormal);
+        }
+
+        const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+        const size_t vertexCount = vertices.size();
+        LveMeshHandle handle = addMesh(path, std::move(vertices), std::move(indices));
+
+        float loadMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "Loaded mesh " << path << ": " << vertexCount << " vertices, " << triangleCount << " triangles"
+            << (missingNormals ? " (generated normals)" : "") << " in " << loadMs << " ms" << std::endl;
+        return handle;
+    }
+
+    std::vector<LveMeshNode> LveMeshLibrary::loadGltf(const std::string& path) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        const std::vector<uint8_t> fileBytes = readBinaryFile(path);
+
+        // GLB: 12 byte header + JSON chunk + (선택) BIN chunk, 그 외는 JSON text
+        std::string jsonText;
+        std::vector<uint8_t> glbBinary;
+        uint32_t magic = 0;
+        if (fileBytes.size() >= 4) {
+            std::memcpy(&magic, fileBytes.data(), 4);
+        }
+        if (magic == GLB_MAGIC) {
+            size_t offset = 12;
+            while (offset + 8 <= fileBytes.size()) {
+                uint32_t chunkLength = 0;
+                uint32_t chunkType = 0;
+                std::memcpy(&chunkLength, fileBytes.data() + offset, 4);
+                std::memcpy(&chunkType, fileBytes.data() + offset + 4, 4);
+                offset += 8;
+                if (offset + chunkLength > fileBytes.size()) {
+                    throw std::runtime_error(path + ": truncated GLB chunk");
+                }
+                if (chunkType == GLB_CHUNK_JSON) {
+                    jsonText.assign(reinterpret_cast<const char*>(fileBytes.data() + offset), chunkLength);
+                }
+                else if (chunkType == GLB_CHUNK_BIN && glbBinary.empty()) {
+                    glbBinary.assign(fileBytes.begin() + offset, fileBytes.begin() + offset + chunkLength);
+                }
+                offset += chunkLength;
+            }
+            if (jsonText.empty()) {
+                throw std::runtime_error(path + ": GLB has no JSON chunk");
+            }
+        }
+        else {
+            jsonText.assign(fileBytes.begin(), fileBytes.end());
+        }
+
+        const LveJsonValue root = LveJsonValue::parse(jsonText, path);
+        if (root.type != LveJsonValue::Type::Object) {
+            throw std::runtime_error(path + ": top level must be an object");
+        }
+
+        // Buffers: data URI (base64), 같은 폴더의 파일, 또는 GLB BIN chunk (uri 없는 buffer 0)
+        std::vector<std::vector<uint8_t>> buffers;
+        if (const LveJsonValue* bufferArray = root.find("buffers")) {
+            for (size_t i = 0; i < bufferArray->array.size(); i++) {
+                const LveJsonValue& buffer = bufferArray->array[i];
+                const std::string context = path + ": buffers[" + std::to_string(i) + "]";
+                const LveJsonValue* uri = buffer.find("uri");
+
+                if (!uri) {
+                    if (i != 0 || magic != GLB_MAGIC) {
+                        throw std::runtime_error(context + ": missing \"uri\"");
+                    }
+                    buffers.push_back(glbBinary);
+                }
+                else if (uri->string.compare(0, 5, "data:") == 0) {
+                    const size_t comma = uri->string.find(',');
+                    if (comma == std::string::npos || uri->string.find(";base64") > comma) {
+                        throw std::runtime_error(context + ": only base64 data URIs are supported");
+                    }
+                    buffers.push_back(decodeBase64(uri->string.substr(comma + 1), context));
+                }
+                else {
+                    buffers.push_back(readBinaryFile(directoryOf(path) + uri->string));
+                }
+
+                if (buffers.back().size() < static_cast<size_t>(gltfInt(buffer, "byteLength", 0, context))) {
+                    throw std::runtime_error(context + ": shorter than byteLength");
+                }
+            }
+        }
+
+        // Mesh primitive마다 LveMesh 하나 (glTF mesh index → handle 목록)
+        std::vector<std::vector<LveMeshHandle>> meshPrimitives;
+        uint32_t triangleCount = 0;
+        if (const LveJsonValue* meshArray = root.find("meshes")) {
+            for (size_t m = 0; m < meshArray->array.size(); m++) {
+                const LveJsonValue& mesh = meshArray->array[m];
+                const LveJsonValue* name = mesh.find("name");
+                const std::string meshName = path + "#" +
+                    (name && name->type == LveJsonValue::Type::String ? name->string : std::to_string(m));
+
+                std::vector<LveMeshHandle> handles;
+                const LveJsonValue* primitives = mesh.find("primitives");
+                for (size_t p = 0; primitives && p < primitives->array.size(); p++) {
+                    const LveJsonValue& primitive = primitives->array[p];
+                    const std::string context = path + ": meshes[" + std::to_string(m) + "].primitives[" + std::to_string(p) + "]";
+
+                    if (gltfInt(primitive, "mode", GLTF_TRIANGLES, context) != GLTF_TRIANGLES) {
+                        std::cout << context << ": not a triangle list, skipped" << std::endl;
+                        continue;
+                    }
+                    const LveJsonValue* attributes = primitive.find("attributes");
+                    const LveJsonValue* positionAttribute = attributes ? attributes->find("POSITION") : nullptr;
+                    if (!positionAttribute) {
+                        throw std::runtime_error(context + ": missing POSITION");
+                    }
+
+                    const GltfAccessor positions = gltfAccessor(
+                        root, buffers, static_cast<int64_t>(positionAttribute->number), context);
+                    if (positions.components != 3 || positions.componentType != GLTF_FLOAT) {
+                        throw std::runtime_error(context + ": POSITION must be float VEC3");
+                    }
+
+                    std::vector<LveMeshVertex> vertices(positions.count, LveMeshVertex{});
+                    for (uint32_t i = 0; i < positions.count; i++) {
+                        vertices[i].position = glm::vec3(
+                            positions.readFloat(i, 0), positions.readFloat(i, 1), positions.readFloat(i, 2));
+                    }
+
+                    const LveJsonValue* normalAttribute = attributes->find("NORMAL");
+                    if (normalAttribute) {
+                        const GltfAccessor normals = gltfAccessor(
+                            root, buffers, static_cast<int64_t>(normalAttribute->number), context);
+                        if (normals.components != 3 || normals.count != positions.count) {
+                            throw std::runtime_error(context + ": NORMAL must be VEC3 with one per vertex");
+                        }
+                        for (uint32_t i = 0; i < normals.count; i++) {
+                            vertices[i].normal = glm::vec3(
+                                normals.readFloat(i, 0), normals.readFloat(i, 1), normals.readFloat(i, 2));
+                        }
+                    }
+
+                    if (const LveJsonValue* texcoordAttribute = attributes->find("TEXCOORD_0")) {
+                        const GltfAccessor texcoords = gltfAccessor(
+                            root, buffers, static_cast<int64_t>(texcoordAttribute->number), context);
+                        if (texcoords.components != 2 || texcoords.count != positions.count) {
+                            throw std::runtime_error(context + ": TEXCOORD_0 must be VEC2 with one per vertex");
+                        }
+                        for (uint32_t i = 0; i < texcoords.count; i++) {
+                            vertices[i].u = texcoords.readFloat(i, 0);
+                            vertices[i].v = texcoords.readFloat(i, 1);
+                        }
+                    }
+
+                    // index가 없으면 vertex 순서 그대로 triangle list
+                    std::vector<uint32_t> indices;
+                    const int64_t indexAccessor = gltfInt(primitive, "indices", -1, context);
+                    if (indexAccessor >= 0) {
+                        const GltfAccessor indexView = gltfAccessor(root, buffers, indexAccessor, context);
+                        if (indexView.components != 1 || indexView.componentType == GLTF_FLOAT ||
+                            indexView.componentType == GLTF_BYTE || indexView.componentType == GLTF_SHORT) {
+                            throw std::runtime_error(context + ": indices must be unsigned SCALAR");
+                        }
+                        indices.resize(indexView.count);
+                        for (uint32_t i = 0; i < indexView.count; i++) {
+                            indices[i] = indexView.readIndex(i);
+                        }
+                    }
+                    else {
+                        indices.resize(positions.count);
+                        for (uint32_t i = 0; i < positions.count; i++) {
+                            indices[i] = i;
+                        }
+                    }
+                    indices.resize(indices.size() - indices.size() % 3);
+
+                    if (!normalAttribute) {
+                        generateNormals(vertices, indices);
+                    }
+
+                    triangleCount += static_cast<uint32_t>(indices.size() / 3);
+                    const std::string primitiveName = primitives->array.size() > 1
+                        ? meshName + "/" + std::to_string(p) : meshName;
+                    handles.push_back(addMesh(primitiveName, std::move(vertices), std::move(indices)));
+                }
+                meshPrimitives.push_back(std::move(handles));
+            }
+        }
+
+        // Node 계층을 펼쳐 world transform 계산 (scene이 없으면 부모 없는 node 전부)
+        std::vector<int64_t> rootNodes;
+        const LveJsonValue* nodeArray = root.find("nodes");
+        const LveJsonValue* sceneArray = root.find("scenes");
+        if (sceneArray && !sceneArray->array.empty()) {
+            const LveJsonValue& scene = gltfElement(root, "scenes", gltfInt(root, "scene", 0, path), path);
+            if (const LveJsonValue* sceneNodes = scene.find("nodes")) {
+                for (const LveJsonValue& node : sceneNodes->array) {
+                    rootNodes.push_back(static_cast<int64_t>(node.number));
+                }
+            }
+        }
+        else if (nodeArray) {
+            std::vector<bool> isChild(nodeArray->array.size(), false);
+            for (const LveJsonValue& node : nodeArray->array) {
+                if (const LveJsonValue* children = node.find("children")) {
+                    for (const LveJsonValue& child : children->array) {
+                        const size_t index = static_cast<size_t>(child.number);
+                        if (index < isChild.size()) isChild[index] = true;
+                    }
+                }
+            }
+            for (size_t i = 0; i < isChild.size(); i++) {
+                if (!isChild[i]) rootNodes.push_back(static_cast<int64_t>(i));
+            }
+        }
+
+        std::vector<LveMeshNode> result;
+        std::vector<std::pair<int64_t, glm::mat4>> stack;
+        for (auto it = rootNodes.rbegin(); it != rootNodes.rend(); ++it) {
+            stack.emplace_back(*it, glm::mat4{ 1.0f });
+        }
+        size_t visited = 0;
+        while (!stack.empty()) {
+            const int64_t nodeIndex = stack.back().first;
+            const glm::mat4 parentTransform = stack.back().second;
+            stack.pop_back();
+
+            // 순환 참조 방지 (올바른 파일은 node마다 한 번)
+            if (++visited > (nodeArray ? nodeArray->array.size() : 0)) {
+                throw std::runtime_error(path + ": node hierarchy has a cycle");
+            }
+
+            const std::string context = path + ": nodes[" + std::to_string(nodeIndex) + "]";
+            const LveJsonValue& node = gltfElement(root, "nodes", nodeIndex, path);
+            const glm::mat4 transform = parentTransform * gltfNodeTransform(node, context);
+
+            const int64_t meshIndex = gltfInt(node, "mesh", -1, context);
+            if (meshIndex >= static_cast<int64_t>(meshPrimitives.size())) {
+                throw std::runtime_error(context + ": invalid mesh");
+            }
+            if (meshIndex >= 0) {
+                for (LveMeshHandle handle : meshPrimitives[static_cast<size_t>(meshIndex)]) {
+                    LveMeshNode meshNode{};
+                    meshNode.mesh = handle;
+                    meshNode.transform = transform;
+                    result.push_back(meshNode);
+                }
+            }
+
+            if (const LveJsonValue* children = node.find("children")) {
+                for (auto child = children->array.rbegin(); child != children->array.rend(); ++child) {
+                    stack.emplace_back(static_cast<int64_t>(child->number), transform);
+                }
+            }
+        }
+
+        float loadMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "Loaded glTF " << path << ": " << meshPrimitives.size() << " meshes, " << triangleCount
+            << " triangles, " << result.size() << " mesh nodes in " << loadMs << " ms" << std::endl;
+        return result;
+    }
+
+}  // namespace lve
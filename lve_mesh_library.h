@@ -0,0 +1,70 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm.hpp>
+
+// std lib headers
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lve {
+
+    // Mesh vertex (closest hit이 buffer device address로 읽는 layout, std430 32 bytes)
+    // BLAS build는 position만 사용 (vertexStride = 32)
+    struct LveMeshVertex {
+        glm::vec3 position;
+        float u;
+        glm::vec3 normal;
+        float v;
+    };
+    static_assert(sizeof(LveMeshVertex) == 32, "LveMeshVertex must match the shader layout");
+
+    // 0 = 없음 (SphereInfo::meshId 0 = 구), 그 외 mesh index + 1
+    using LveMeshHandle = uint32_t;
+    constexpr LveMeshHandle INVALID_MESH_HANDLE = 0;
+
+    struct LveMesh {
+        std::string name;  // 처음 읽은 파일 / primitive (로그용)
+        std::vector<LveMeshVertex> vertices;
+        std::vector<uint32_t> indices;  // triangle list
+        uint64_t hash = 0;              // vertex + index 내용 (중복 제거)
+        float boundingRadius = 0.0f;    // 원점 기준 (instance center / radius 계산용)
+    };
+
+    // glTF node 하나 (mesh primitive마다 하나, node 계층의 world transform)
+    struct LveMeshNode {
+        LveMeshHandle mesh = INVALID_MESH_HANDLE;
+        glm::mat4 transform{ 1.0f };
+    };
+
+    // OBJ / glTF에서 읽은 triangle mesh 목록 (CPU 쪽, GPU buffer / BLAS는 LveAccelerationStructure가 만듦)
+    // - 내용이 같은 mesh는 파일 / 이름이 달라도 handle 하나 → BLAS 하나를 모든 instance가 공유
+    // - normal이 없으면 면적 가중 vertex normal 생성, UV가 없으면 0
+    class LveMeshLibrary {
+    public:
+        // 같은 내용이 이미 있으면 기존 handle 반환
+        LveMeshHandle addMesh(const std::string& name, std::vector<LveMeshVertex> vertices, std::vector<uint32_t> indices);
+
+        // 파일 전체를 mesh 하나로 (group / object 구분 없음, 다각형은 fan으로 분할)
+        LveMeshHandle loadObj(const std::string& path);
+
+        // .gltf (외부 / base64 buffer) 또는 .glb, default scene의 node 계층을 펼침
+        std::vector<LveMeshNode> loadGltf(const std::string& path);
+
+        // 확장자로 선택 (OBJ는 identity transform node 하나)
+        std::vector<LveMeshNode> load(const std::string& path);
+
+        const LveMesh& getMesh(LveMeshHandle handle) const;
+        uint32_t getMeshCount() const { return static_cast<uint32_t>(meshes.size()); }
+        uint32_t getDuplicateCount() const { return duplicateCount; }  // 중복이라 재사용된 addMesh 수
+
+    private:
+        std::vector<LveMesh> meshes;
+        std::unordered_multimap<uint64_t, uint32_t> meshesByHash;  // hash → mesh index (충돌 시 내용 비교)
+        uint32_t duplicateCount = 0;
+    };
+
+}  // namespace lve
@@ -0,0 +1,61 @@
+#include "lve_pfm_writer.h"
+
+// std
+#include <stdexcept>
+
+namespace lve {
+
+    LvePfmTileWriter::LvePfmTileWriter(const std::string& path, uint32_t width, uint32_t height)
+        : path{ path }, width{ width }, height{ height } {
+        // 새 파일로 만든 뒤 read / write로 다시 열어야 seekp로 중간에 쓸 수 있음
+        {
+            std::ofstream create(path, std::ios::binary | std::ios::trunc);
+            if (!create) {
+                throw std::runtime_error("failed to open output file: " + path);
+            }
+            // scale < 0 = little endian
+            create << "PF\n" << width << " " << height << "\n-1.0\n";
+        }
+
+        file.open(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (!file) {
+            throw std::runtime_error("failed to open output file: " + path);
+        }
+
+        file.seekp(0, std::ios::end);
+        dataOffset = static_cast<std::streamoff>(file.tellp());
+
+        // 마지막 byte를 써서 파일 크기 확보 (아직 안 쓴 tile은 0 = 검정)
+        const std::streamoff dataSize = static_cast<std::streamoff>(width) * height * 3 * sizeof(float);
+        file.seekp(dataOffset + dataSize - 1);
+        file.put('\0');
+        if (!file) {
+            throw std::runtime_error("failed to allocate output file: " + path);
+        }
+    }
+
+    void LvePfmTileWriter::writeTile(uint32_t x, uint32_t y, uint32_t tileWidth, uint32_t tileHeight,
+        const float* rgba, uint32_t rowPixels) {
+        row.resize(static_cast<size_t>(tileWidth) * 3);
+
+        for (uint32_t ty = 0; ty < tileHeight; ty++) {
+            const float* src = rgba + static_cast<size_t>(ty) * rowPixels * 4;
+            for (uint32_t tx = 0; tx < tileWidth; tx++) {
+                row[tx * 3 + 0] = src[tx * 4 + 0];
+                row[tx * 3 + 1] = src[tx * 4 + 1];
+                row[tx * 3 + 2] = src[tx * 4 + 2];
+            }
+
+            const uint32_t fileRow = height - 1 - (y + ty);
+            const std::streamoff offset = dataOffset +
+                (static_cast<std::streamoff>(fileRow) * width + x) * 3 * static_cast<std::streamoff>(sizeof(float));
+            file.seekp(offset);
+            file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size() * sizeof(float)));
+        }
+
+        if (!file) {
+            throw std::runtime_error("failed to write tile to " + path);
+        }
+    }
+
+}  // namespace lve
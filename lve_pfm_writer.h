@@ -0,0 +1,36 @@
+#pragma once
+
+// std lib headers
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+    // PFM (RGB 32-bit float, little endian)을 tile 단위로 직접 파일에 씀
+    // - 생성 시 header를 쓰고 전체 크기로 파일을 늘려둠 → host에는 tile 한 줄만 있으면 됨
+    // - PFM은 아래 줄부터 저장하므로 이미지 y는 파일에서 height - 1 - y 줄
+    class LvePfmTileWriter {
+    public:
+        LvePfmTileWriter(const std::string& path, uint32_t width, uint32_t height);
+
+        LvePfmTileWriter(const LvePfmTileWriter&) = delete;
+        LvePfmTileWriter& operator=(const LvePfmTileWriter&) = delete;
+
+        // rgba: tile 크기의 RGBA32F, 한 줄에 rowPixels pixel (readback buffer 그대로)
+        void writeTile(uint32_t x, uint32_t y, uint32_t tileWidth, uint32_t tileHeight,
+            const float* rgba, uint32_t rowPixels);
+
+        const std::string& getPath() const { return path; }
+
+    private:
+        std::string path;
+        uint32_t width;
+        uint32_t height;
+        std::fstream file;
+        std::streamoff dataOffset = 0;  // header 바로 뒤
+        std::vector<float> row;         // RGBA → RGB 변환용 한 줄
+    };
+
+}  // namespace lve
@@ -0,0 +1,111 @@
+#include "lve_pipeline_cache.h"
+
+// std
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace lve {
+
+    LvePipelineCache::LvePipelineCache(
+        VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& path)
+        : device{ device }, properties{ properties }, path{ path } {
+        std::vector<char> data;
+
+        std::ifstream file{ path, std::ios::ate | std::ios::binary };
+        if (file.is_open()) {
+            data.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(data.data(), data.size());
+
+            if (!file || !isCompatible(data.data(), data.size())) {
+                std::cout << "Pipeline cache " << path << " is stale, starting cold" << std::endl;
+                data.clear();
+            }
+        }
+
+        VkPipelineCacheCreateInfo cacheInfo{};
+        cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        cacheInfo.initialDataSize = data.size();
+        cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+        VkResult result = vkCreatePipelineCache(device, &cacheInfo, nullptr, &cache);
+        if (result != VK_SUCCESS && !data.empty()) {
+            // header는 맞는데 드라이버가 거부한 경우: 빈 cache로 다시
+            std::cout << "Pipeline cache " << path << " rejected by driver, starting cold" << std::endl;
+            cacheInfo.initialDataSize = 0;
+            cacheInfo.pInitialData = nullptr;
+            data.clear();
+            result = vkCreatePipelineCache(device, &cacheInfo, nullptr, &cache);
+        }
+
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error("failed to create pipeline cache!");
+        }
+
+        warm = !data.empty();
+        if (warm) {
+            std::cout << "Loaded pipeline cache " << path << " (" << data.size() << " bytes)" << std::endl;
+        }
+    }
+
+    LvePipelineCache::~LvePipelineCache() {
+        save();
+        vkDestroyPipelineCache(device, cache, nullptr);
+    }
+
+    void LvePipelineCache::save() {
+        size_t size = 0;
+        if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS || size == 0) {
+            return;
+        }
+
+        std::vector<char> data(size);
+        if (vkGetPipelineCacheData(device, cache, &size, data.data()) != VK_SUCCESS) {
+            return;
+        }
+
+        // 쓰다가 죽어도 기존 파일이 깨지지 않도록 임시 파일 → rename
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file{ tempPath, std::ios::binary | std::ios::trunc };
+            if (!file) {
+                std::cerr << "failed to write pipeline cache: " << tempPath << std::endl;
+                return;
+            }
+            file.write(data.data(), size);
+            file.close();  // 마지막 flush 실패도 잡도록 검사 전에 닫음
+            if (!file) {
+                // 디스크 부족 등으로 잘린 임시 파일이 기존 캐시를 덮어쓰지 않도록
+                std::cerr << "failed to write pipeline cache: " << tempPath << std::endl;
+                std::remove(tempPath.c_str());
+                return;
+            }
+        }
+
+        std::remove(path.c_str());
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            std::cerr << "failed to write pipeline cache: " << path << std::endl;
+        }
+    }
+
+    bool LvePipelineCache::isCompatible(const char* data, size_t size) const {
+        if (size < sizeof(VkPipelineCacheHeaderVersionOne)) {
+            return false;
+        }
+
+        VkPipelineCacheHeaderVersionOne header{};
+        memcpy(&header, data, sizeof(header));
+
+        return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+            header.headerSize <= size &&
+            header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            header.vendorID == properties.vendorID &&
+            header.deviceID == properties.deviceID &&
+            memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+}  // namespace lve
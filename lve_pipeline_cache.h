@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+// std lib headers
+#include <string>
+
+namespace lve {
+
+    // Disk에 저장되는 VkPipelineCache
+    // 시작 시 파일 header (version / vendor / device / UUID)가 현재 device와 맞을 때만 초기 데이터로 사용,
+    // 아니면 (드라이버 업데이트, 다른 GPU 등) 빈 cache로 시작. 소멸 시 저장
+    class LvePipelineCache {
+    public:
+        static constexpr const char* DEFAULT_PATH = "pipeline_cache.bin";
+
+        LvePipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties,
+            const std::string& path = DEFAULT_PATH);
+        ~LvePipelineCache();
+
+        LvePipelineCache(const LvePipelineCache&) = delete;
+        LvePipelineCache& operator=(const LvePipelineCache&) = delete;
+
+        VkPipelineCache getCache() const { return cache; }
+
+        // 디스크 데이터로 시작했는지 (warm) - 생성 시간 로그용
+        bool isWarm() const { return warm; }
+
+        void save();
+
+    private:
+        bool isCompatible(const char* data, size_t size) const;
+
+        VkDevice device;
+        VkPhysicalDeviceProperties properties;
+        std::string path;
+        VkPipelineCache cache = VK_NULL_HANDLE;
+        bool warm = false;
+    };
+
+}  // namespace lve
@@ -1,17 +1,55 @@
 ﻿#include "lve_ray_tracing_pipeline.h"
-#include <fstream>
 #include <stdexcept>
 #include <cstring>
+#include <cstddef>
+#include <algorithm>
 #include <iostream>
+#include <chrono>
+#include <map>
 
 namespace lve {
 
+    namespace {
+        // raygen.rgen의 constant_id 0, 1, 2
+        struct SpecializationData {
+            uint32_t maxDepth;
+            uint32_t samplesPerPixel;
+            uint32_t russianRouletteDepth;
+        };
+    }
+
+    std::vector<LveQualityPreset> defaultQualityPresets() {
+        return {
+            { "interactive", 8, 1, 2 },
+            // Russian roulette 없음 (마지막 bounce에서만 판정 → 기존 raygen과 같은 이미지)
+            { "balanced", 50, 4, 50 },
+            { "final", 50, 16, 10 },
+        };
+    }
+
     LveRayTracingPipeline::LveRayTracingPipeline(
         LveDevice& device,
         const std::string& raygenShader,
-        const std::string& missShader,
-        const std::string& closestHitShader
+        const std::vector<std::string>& missShaders,
+        const LveMaterialRegistry& materials,
+        const std::string& intersectionShader,
+        const std::vector<LveQualityPreset>& presets,
+        const std::vector<VkDescriptorSetLayout>& extraSetLayouts
     ) : lveDevice{ device } {
+        if (presets.empty()) {
+            throw std::runtime_error("ray tracing pipeline needs at least one quality preset!");
+        }
+        if (missShaders.empty()) {
+            throw std::runtime_error("ray tracing pipeline needs at least one miss shader!");
+        }
+        if (materials.getMaterialCount() == 0) {
+            throw std::runtime_error("ray tracing pipeline needs at least one material!");
+        }
+        for (const LveQualityPreset& preset : presets) {
+            Variant variant{};
+            variant.preset = preset;
+            variants.push_back(variant);
+        }
 
         // Load function pointers
         vkGetRayTracingShaderGroupHandlesKHR = reinterpret_cast<PFN_vkGetRayTracingShaderGroupHandlesKHR>(
@@ -28,26 +66,27 @@ namespace lve {
         deviceProperties.pNext = &rtProperties;
         vkGetPhysicalDeviceProperties2(lveDevice.getPhysicalDevice(), &deviceProperties);
 
-        createPipelineLayout();
-        createRayTracingPipeline(raygenShader, missShader, closestHitShader);
+        createPipelineLayout(extraSetLayouts);
+        createRayTracingPipelines(raygenShader, missShaders, materials, intersectionShader);
         createShaderBindingTable();
     }
 
     LveRayTracingPipeline::~LveRayTracingPipeline() {
-        vkDestroyPipeline(lveDevice.device(), pipeline, nullptr);
+        for (Variant& variant : variants) {
+            vkDestroyPipeline(lveDevice.device(), variant.pipeline, nullptr);
+        }
         vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr);
         vkDestroyDescriptorSetLayout(lveDevice.device(), descriptorSetLayout, nullptr);
-        vkDestroyBuffer(lveDevice.device(), sbtBuffer, nullptr);
-        vkFreeMemory(lveDevice.device(), sbtMemory, nullptr);
+        lveDevice.destroyBuffer(sbtBuffer, sbtAllocation);
     }
 
-    void LveRayTracingPipeline::createPipelineLayout() {
-        // Binding 0: Acceleration Structure (raygen)
+    void LveRayTracingPipeline::createPipelineLayout(const std::vector<VkDescriptorSetLayout>& extraSetLayouts) {
+        // Binding 0: Acceleration Structure (raygen, closest hit의 shadow ray)
         VkDescriptorSetLayoutBinding accelerationStructureBinding{};
         accelerationStructureBinding.binding = 0;
         accelerationStructureBinding.descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
         accelerationStructureBinding.descriptorCount = 1;
-        accelerationStructureBinding.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+        accelerationStructureBinding.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR | VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
 
         // Binding 1: Storage Image (raygen)
         VkDescriptorSetLayoutBinding storageImageBinding{};
@@ -63,17 +102,71 @@ namespace lve {
         sphereInfoBinding.descriptorCount = 1;
         sphereInfoBinding.stageFlags = VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
 
-        // Binding 3 (UBO) 삭제됨!
-        VkDescriptorSetLayoutBinding bindings[] = {
+        // Binding 3: Accumulation Image (raygen, RGBA32F running average)
+        VkDescriptorSetLayoutBinding accumulationImageBinding{};
+        accumulationImageBinding.binding = 3;
+        accumulationImageBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        accumulationImageBinding.descriptorCount = 1;
+        accumulationImageBinding.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+
+        std::vector<VkDescriptorSetLayoutBinding> bindings = {
             accelerationStructureBinding,
             storageImageBinding,
-            sphereInfoBinding
+            sphereInfoBinding,
+            accumulationImageBinding
         };
 
+        // Binding 4-7: SVGF G-buffer (raygen, color / albedo / normal+depth / motion+mesh id)
+        for (uint32_t binding = 4; binding <= 7; binding++) {
+            VkDescriptorSetLayoutBinding gBufferBinding{};
+            gBufferBinding.binding = binding;
+            gBufferBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            gBufferBinding.descriptorCount = 1;
+            gBufferBinding.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+            bindings.push_back(gBufferBinding);
+        }
+
+        // Binding 8: 이전 프레임 카메라 (raygen, motion vector)
+        VkDescriptorSetLayoutBinding previousCameraBinding{};
+        previousCameraBinding.binding = 8;
+        previousCameraBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        previousCameraBinding.descriptorCount = 1;
+        previousCameraBinding.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+        bindings.push_back(previousCameraBinding);
+
+        // Binding 9: 발광 구 목록 (closest hit, NEE)
+        VkDescriptorSetLayoutBinding lightBinding{};
+        lightBinding.binding = 9;
+        lightBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        lightBinding.descriptorCount = 1;
+        lightBinding.stageFlags = VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+        bindings.push_back(lightBinding);
+
+        // Binding 10: blue-noise texture (raygen / closest hit, shaders/sampler.glsl)
+        VkDescriptorSetLayoutBinding blueNoiseBinding = lightBinding;
+        blueNoiseBinding.binding = 10;
+        blueNoiseBinding.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR | VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+        bindings.push_back(blueNoiseBinding);
+
+        // Binding 11-12: adaptive sampling moments / sample count map (raygen, LveAdaptiveSampler)
+        for (uint32_t binding = 11; binding <= 12; binding++) {
+            VkDescriptorSetLayoutBinding adaptiveBinding{};
+            adaptiveBinding.binding = binding;
+            adaptiveBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            adaptiveBinding.descriptorCount = 1;
+            adaptiveBinding.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+            bindings.push_back(adaptiveBinding);
+        }
+
+        // Binding 13: mesh table (closest hit, mesh id → vertex / index buffer device address)
+        VkDescriptorSetLayoutBinding meshTableBinding = lightBinding;
+        meshTableBinding.binding = 13;
+        bindings.push_back(meshTableBinding);
+
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layoutInfo.bindingCount = 3;  // 4 → 3
-        layoutInfo.pBindings = bindings;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
 
         if (vkCreateDescriptorSetLayout(lveDevice.device(), &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
             throw std::runtime_error("failed to create descriptor set layout!");
@@ -83,13 +176,16 @@ namespace lve {
         VkPushConstantRange pushConstantRange{};
         pushConstantRange.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
         pushConstantRange.offset = 0;
-        pushConstantRange.size = 80;  // sizeof(CameraPushConstants): 4 * vec3(16) + 4 * float(4) = 80 bytes
+        pushConstantRange.size = 112;  // sizeof(CameraPushConstants): 108 bytes of fields + padding to 16 = 112 bytes
+
+        // Pipeline Layout (set 0: 위 layout, 이후 호출자가 넘긴 layout - wavefront queue 등)
+        std::vector<VkDescriptorSetLayout> setLayouts = { descriptorSetLayout };
+        setLayouts.insert(setLayouts.end(), extraSetLayouts.begin(), extraSetLayouts.end());
 
-        // Pipeline Layout
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 1;
-        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+        pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+        pipelineLayoutInfo.pSetLayouts = setLayouts.data();
         pipelineLayoutInfo.pushConstantRangeCount = 1;           // 추가!
         pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;  // 추가!
 
@@ -98,38 +194,72 @@ namespace lve {
         }
     }
 
-    void LveRayTracingPipeline::createRayTracingPipeline(
+    void LveRayTracingPipeline::setActivePreset(uint32_t index) {
+        if (index >= variants.size()) {
+            throw std::runtime_error("invalid quality preset index!");
+        }
+        activeVariant = index;
+    }
+
+    bool LveRayTracingPipeline::setActivePreset(const std::string& name) {
+        for (uint32_t i = 0; i < variants.size(); i++) {
+            if (variants[i].preset.name == name) {
+                activeVariant = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void LveRayTracingPipeline::createRayTracingPipelines(
         const std::string& raygenShader,
-        const std::string& missShader,
-        const std::string& closestHitShader
+        const std::vector<std::string>& missShaders,
+        const LveMaterialRegistry& materials,
+        const std::string& intersectionShader
     ) {
-        auto raygenCode = readFile(raygenShader);
-        auto missCode = readFile(missShader);
-        auto chitCode = readFile(closestHitShader);
-
-        VkShaderModule raygenModule = createShaderModule(raygenCode);
-        VkShaderModule missModule = createShaderModule(missCode);
-        VkShaderModule chitModule = createShaderModule(chitCode);
-
-        VkPipelineShaderStageCreateInfo raygenStage{};
-        raygenStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        raygenStage.stage = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
-        raygenStage.module = raygenModule;
-        raygenStage.pName = "main";
-
-        VkPipelineShaderStageCreateInfo missStage{};
-        missStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        missStage.stage = VK_SHADER_STAGE_MISS_BIT_KHR;
-        missStage.module = missModule;
-        missStage.pName = "main";
-
-        VkPipelineShaderStageCreateInfo chitStage{};
-        chitStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        chitStage.stage = VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
-        chitStage.module = chitModule;
-        chitStage.pName = "main";
-
-        VkPipelineShaderStageCreateInfo stages[] = { raygenStage, missStage, chitStage };
+        const bool procedural = !intersectionShader.empty();
+        missGroupCount = static_cast<uint32_t>(missShaders.size());
+        hitGroupCount = materials.getMaterialCount();
+        // Procedural 모드는 triangle mesh instance용 hit group을 material마다 하나 더 (record hitGroupCount + material)
+        hitRecordCount = procedural ? hitGroupCount * 2 : hitGroupCount;
+
+        // 같은 SPIR-V는 module 하나로 (기본 material은 모두 closesthit.rchit.spv)
+        std::map<std::string, VkShaderModule> modules;
+        auto getModule = [&](const std::string& path) {
+            auto it = modules.find(path);
+            if (it == modules.end()) {
+                it = modules.emplace(path, lveDevice.createShaderModule(path)).first;
+            }
+            return it->second;
+        };
+
+        auto makeStage = [](VkShaderStageFlagBits stage, VkShaderModule module) {
+            VkPipelineShaderStageCreateInfo stageInfo{};
+            stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            stageInfo.stage = stage;
+            stageInfo.module = module;
+            stageInfo.pName = "main";
+            return stageInfo;
+        };
+
+        // Stage: 0 raygen, 1.. miss, (intersection), 이후 material별 closest hit
+        std::vector<VkPipelineShaderStageCreateInfo> stages = {
+            makeStage(VK_SHADER_STAGE_RAYGEN_BIT_KHR, getModule(raygenShader))
+        };
+        for (const std::string& missShader : missShaders) {
+            stages.push_back(makeStage(VK_SHADER_STAGE_MISS_BIT_KHR, getModule(missShader)));
+        }
+
+        uint32_t intersectionStage = VK_SHADER_UNUSED_KHR;
+        if (procedural) {
+            intersectionStage = static_cast<uint32_t>(stages.size());
+            stages.push_back(makeStage(VK_SHADER_STAGE_INTERSECTION_BIT_KHR, getModule(intersectionShader)));
+        }
+
+        // closest-hit specialization (constant_id 0: MATERIAL_TYPE)
+        const VkSpecializationMapEntry materialEntry = { 0, 0, sizeof(int32_t) };
+        std::vector<int32_t> materialSpecializations(hitGroupCount);
+        std::vector<VkSpecializationInfo> materialSpecializationInfos(hitGroupCount);
 
         VkRayTracingShaderGroupCreateInfoKHR raygenGroup{};
         raygenGroup.sType = VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR;
@@ -139,54 +269,132 @@ namespace lve {
         raygenGroup.anyHitShader = VK_SHADER_UNUSED_KHR;
         raygenGroup.intersectionShader = VK_SHADER_UNUSED_KHR;
 
-        VkRayTracingShaderGroupCreateInfoKHR missGroup{};
-        missGroup.sType = VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR;
-        missGroup.type = VK_RAY_TRACING_SHADER_GROUP_TYPE_GENERAL_KHR;
-        missGroup.generalShader = 1;
-        missGroup.closestHitShader = VK_SHADER_UNUSED_KHR;
-        missGroup.anyHitShader = VK_SHADER_UNUSED_KHR;
-        missGroup.intersectionShader = VK_SHADER_UNUSED_KHR;
-
-        VkRayTracingShaderGroupCreateInfoKHR hitGroup{};
-        hitGroup.sType = VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR;
-        hitGroup.type = VK_RAY_TRACING_SHADER_GROUP_TYPE_TRIANGLES_HIT_GROUP_KHR;
-        hitGroup.generalShader = VK_SHADER_UNUSED_KHR;
-        hitGroup.closestHitShader = 2;
-        hitGroup.anyHitShader = VK_SHADER_UNUSED_KHR;
-        hitGroup.intersectionShader = VK_SHADER_UNUSED_KHR;
-
-        VkRayTracingShaderGroupCreateInfoKHR groups[] = { raygenGroup, missGroup, hitGroup };
-
-        VkRayTracingPipelineCreateInfoKHR pipelineInfo{};
-        pipelineInfo.sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR;
-        pipelineInfo.stageCount = 3;
-        pipelineInfo.pStages = stages;
-        pipelineInfo.groupCount = 3;
-        pipelineInfo.pGroups = groups;
-        pipelineInfo.maxPipelineRayRecursionDepth = 1;
-        pipelineInfo.layout = pipelineLayout;
+        // Group: 0 raygen, 1.. miss, 이후 material별 hit group (SBT hit record 순서 = material id)
+        //        procedural이면 그 뒤에 같은 closest hit의 triangle hit group
+        std::vector<VkRayTracingShaderGroupCreateInfoKHR> groups = { raygenGroup };
+
+        for (uint32_t i = 0; i < missGroupCount; i++) {
+            VkRayTracingShaderGroupCreateInfoKHR missGroup{};
+            missGroup.sType = VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR;
+            missGroup.type = VK_RAY_TRACING_SHADER_GROUP_TYPE_GENERAL_KHR;
+            missGroup.generalShader = 1 + i;
+            missGroup.closestHitShader = VK_SHADER_UNUSED_KHR;
+            missGroup.anyHitShader = VK_SHADER_UNUSED_KHR;
+            missGroup.intersectionShader = VK_SHADER_UNUSED_KHR;
+            groups.push_back(missGroup);
+        }
+
+        for (uint32_t i = 0; i < hitGroupCount; i++) {
+            const LveMaterial& material = materials.getMaterial(i);
+
+            VkPipelineShaderStageCreateInfo chitStage =
+                makeStage(VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR, getModule(material.closestHitShader));
+            if (material.specialization >= 0) {
+                materialSpecializations[i] = material.specialization;
+                materialSpecializationInfos[i].mapEntryCount = 1;
+                materialSpecializationInfos[i].pMapEntries = &materialEntry;
+                materialSpecializationInfos[i].dataSize = sizeof(int32_t);
+                materialSpecializationInfos[i].pData = &materialSpecializations[i];
+                chitStage.pSpecializationInfo = &materialSpecializationInfos[i];
+            }
+
+            VkRayTracingShaderGroupCreateInfoKHR hitGroup{};
+            hitGroup.sType = VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR;
+            hitGroup.type = procedural ? VK_RAY_TRACING_SHADER_GROUP_TYPE_PROCEDURAL_HIT_GROUP_KHR
+                : VK_RAY_TRACING_SHADER_GROUP_TYPE_TRIANGLES_HIT_GROUP_KHR;
+            hitGroup.generalShader = VK_SHADER_UNUSED_KHR;
+            hitGroup.closestHitShader = static_cast<uint32_t>(stages.size());
+            hitGroup.anyHitShader = VK_SHADER_UNUSED_KHR;
+            hitGroup.intersectionShader = intersectionStage;
+
+            stages.push_back(chitStage);
+            groups.push_back(hitGroup);
+        }
+
+        for (uint32_t i = 0; procedural && i < hitGroupCount; i++) {
+            VkRayTracingShaderGroupCreateInfoKHR triangleGroup = groups[1 + missGroupCount + i];
+            triangleGroup.type = VK_RAY_TRACING_SHADER_GROUP_TYPE_TRIANGLES_HIT_GROUP_KHR;
+            triangleGroup.intersectionShader = VK_SHADER_UNUSED_KHR;
+            groups.push_back(triangleGroup);
+        }
+
+        // Preset별 raygen specialization (constant_id 0: MAX_DEPTH, 1: SAMPLES_PER_PIXEL, 2: RR_START_DEPTH)
+        const VkSpecializationMapEntry specializationEntries[] = {
+            { 0, offsetof(SpecializationData, maxDepth), sizeof(uint32_t) },
+            { 1, offsetof(SpecializationData, samplesPerPixel), sizeof(uint32_t) },
+            { 2, offsetof(SpecializationData, russianRouletteDepth), sizeof(uint32_t) },
+        };
+
+        // closest hit에서 shadow ray를 한 번 더 쏨 (raygen → closest hit → shadow)
+        const uint32_t recursionDepth = 2;
+        if (rtProperties.maxRayRecursionDepth < recursionDepth) {
+            throw std::runtime_error("device does not support ray recursion depth 2 (needed for shadow rays)!");
+        }
+
+        const size_t variantCount = variants.size();
+        std::vector<SpecializationData> specializationData(variantCount);
+        std::vector<VkSpecializationInfo> specializationInfos(variantCount);
+        std::vector<std::vector<VkPipelineShaderStageCreateInfo>> variantStages(variantCount, stages);
+        std::vector<VkRayTracingPipelineCreateInfoKHR> pipelineInfos(variantCount);
+
+        for (size_t i = 0; i < variantCount; i++) {
+            const LveQualityPreset& preset = variants[i].preset;
+            specializationData[i] = { preset.maxDepth, std::max(preset.samplesPerPixel, 1u), preset.russianRouletteDepth };
+
+            specializationInfos[i].mapEntryCount = 3;
+            specializationInfos[i].pMapEntries = specializationEntries;
+            specializationInfos[i].dataSize = sizeof(SpecializationData);
+            specializationInfos[i].pData = &specializationData[i];
+
+            variantStages[i][0].pSpecializationInfo = &specializationInfos[i];  // raygen
+
+            pipelineInfos[i] = {};
+            pipelineInfos[i].sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR;
+            pipelineInfos[i].stageCount = static_cast<uint32_t>(variantStages[i].size());
+            pipelineInfos[i].pStages = variantStages[i].data();
+            pipelineInfos[i].groupCount = static_cast<uint32_t>(groups.size());
+            pipelineInfos[i].pGroups = groups.data();
+            pipelineInfos[i].maxPipelineRayRecursionDepth = recursionDepth;
+            pipelineInfos[i].layout = pipelineLayout;
+        }
+
+        LvePipelineCache& pipelineCache = lveDevice.getPipelineCache();
+        auto startTime = std::chrono::high_resolution_clock::now();
 
+        // 모든 variant를 한 번에 생성
+        std::vector<VkPipeline> pipelines(variantCount, VK_NULL_HANDLE);
         if (vkCreateRayTracingPipelinesKHR(
             lveDevice.device(),
             VK_NULL_HANDLE,
-            VK_NULL_HANDLE,
-            1,
-            &pipelineInfo,
+            pipelineCache.getCache(),
+            static_cast<uint32_t>(variantCount),
+            pipelineInfos.data(),
             nullptr,
-            &pipeline) != VK_SUCCESS) {
+            pipelines.data()) != VK_SUCCESS) {
             throw std::runtime_error("failed to create ray tracing pipeline!");
         }
 
-        vkDestroyShaderModule(lveDevice.device(), raygenModule, nullptr);
-        vkDestroyShaderModule(lveDevice.device(), missModule, nullptr);
-        vkDestroyShaderModule(lveDevice.device(), chitModule, nullptr);
+        for (size_t i = 0; i < variantCount; i++) {
+            variants[i].pipeline = pipelines[i];
+        }
+
+        float createMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "Ray tracing pipelines (" << variantCount << " presets, " << hitRecordCount
+            << " hit groups) created in " << createMs << " ms ("
+            << (pipelineCache.isWarm() ? "warm" : "cold") << " cache)" << std::endl;
+
+        for (const auto& entry : modules) {
+            vkDestroyShaderModule(lveDevice.device(), entry.second, nullptr);
+        }
     }
 
     void LveRayTracingPipeline::createShaderBindingTable() {
         const uint32_t handleSize = rtProperties.shaderGroupHandleSize;
         const uint32_t handleAlignment = rtProperties.shaderGroupHandleAlignment;
         const uint32_t baseAlignment = rtProperties.shaderGroupBaseAlignment;
-        const uint32_t groupCount = 3;
+        const uint32_t groupCount = 1 + missGroupCount + hitRecordCount;
+        const uint32_t variantCount = static_cast<uint32_t>(variants.size());
 
         std::cout << "handleSize: " << handleSize << std::endl;
         std::cout << "handleAlignment: " << handleAlignment << std::endl;
@@ -196,100 +404,70 @@ namespace lve {
         std::cout << "handleSizeAligned: " << handleSizeAligned << std::endl;
 
         const uint32_t dataSize = groupCount * handleSize;
-        std::vector<uint8_t> shaderHandleStorage(dataSize);
-        if (vkGetRayTracingShaderGroupHandlesKHR(
-            lveDevice.device(),
-            pipeline,
-            0,
-            groupCount,
-            dataSize,
-            shaderHandleStorage.data()) != VK_SUCCESS) {
-            throw std::runtime_error("failed to get ray tracing shader group handles!");
+        std::vector<uint8_t> shaderHandleStorage(static_cast<size_t>(dataSize) * variantCount);
+        for (uint32_t v = 0; v < variantCount; v++) {
+            if (vkGetRayTracingShaderGroupHandlesKHR(
+                lveDevice.device(),
+                variants[v].pipeline,
+                0,
+                groupCount,
+                dataSize,
+                shaderHandleStorage.data() + static_cast<size_t>(v) * dataSize) != VK_SUCCESS) {
+                throw std::runtime_error("failed to get ray tracing shader group handles!");
+            }
         }
 
-        const uint32_t sbtSize = handleSizeAligned * groupCount;
+        const uint32_t sbtSize = handleSizeAligned * groupCount * variantCount;
 
+        // SBT buffer는 공유 host visible block에서 sub-allocation → 주소가 buffer alignment(최소 16)만 보장
+        // baseAlignment만큼 더 잡고 region 시작을 정렬된 위치로 옮김
         lveDevice.createBuffer(
-            sbtSize,
+            sbtSize + baseAlignment,
             VK_BUFFER_USAGE_SHADER_BINDING_TABLE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
             sbtBuffer,
-            sbtMemory
+            sbtAllocation
         );
 
-        void* mapped;
-        vkMapMemory(lveDevice.device(), sbtMemory, 0, sbtSize, 0, &mapped);
-        auto* pData = reinterpret_cast<uint8_t*>(mapped);
-
-        for (uint32_t i = 0; i < groupCount; i++) {
-            memcpy(pData + i * handleSizeAligned,
-                shaderHandleStorage.data() + i * handleSize,
-                handleSize);
-        }
-
-        vkUnmapMemory(lveDevice.device(), sbtMemory);
-
         VkBufferDeviceAddressInfo bufferInfo{};
         bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
         bufferInfo.buffer = sbtBuffer;
-        VkDeviceAddress sbtAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+        const VkDeviceAddress bufferAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &bufferInfo);
+        const VkDeviceAddress sbtAddress = (bufferAddress + baseAlignment - 1) & ~static_cast<VkDeviceAddress>(baseAlignment - 1);
 
-        std::cout << "sbtAddress: " << sbtAddress << std::endl;
-        std::cout << "sbtAddress % 64: " << (sbtAddress % 64) << std::endl;
+        auto* pData = reinterpret_cast<uint8_t*>(sbtAllocation.mapped) + (sbtAddress - bufferAddress);
 
-        if (sbtAddress % baseAlignment != 0) {
-            std::cerr << "ERROR: SBT buffer address not aligned!" << std::endl;
-            throw std::runtime_error("SBT buffer address not aligned to baseAlignment!");
+        for (uint32_t i = 0; i < groupCount * variantCount; i++) {
+            memcpy(pData + i * handleSizeAligned,
+                shaderHandleStorage.data() + i * handleSize,
+                handleSize);
         }
 
-        raygenRegion.deviceAddress = sbtAddress;
-        raygenRegion.stride = handleSizeAligned;
-        raygenRegion.size = handleSizeAligned;
-
-        missRegion.deviceAddress = sbtAddress + handleSizeAligned;
-        missRegion.stride = handleSizeAligned;
-        missRegion.size = handleSizeAligned;
-
-        hitRegion.deviceAddress = sbtAddress + handleSizeAligned * 2;
-        hitRegion.stride = handleSizeAligned;
-        hitRegion.size = handleSizeAligned;
+        std::cout << "sbtAddress: " << sbtAddress << " (buffer + " << (sbtAddress - bufferAddress) << ")" << std::endl;
 
-        callableRegion = {};
-
-        std::cout << "raygenRegion.deviceAddress: " << raygenRegion.deviceAddress << std::endl;
-        std::cout << "missRegion.deviceAddress: " << missRegion.deviceAddress << std::endl;
-        std::cout << "hitRegion.deviceAddress: " << hitRegion.deviceAddress << std::endl;
-    }
+        for (uint32_t v = 0; v < variantCount; v++) {
+            Variant& variant = variants[v];
+            VkDeviceAddress variantAddress = sbtAddress + static_cast<VkDeviceAddress>(handleSizeAligned) * groupCount * v;
 
-    std::vector<char> LveRayTracingPipeline::readFile(const std::string& filepath) {
-        std::ifstream file{ filepath, std::ios::ate | std::ios::binary };
-
-        if (!file.is_open()) {
-            throw std::runtime_error("failed to open file: " + filepath);
-        }
+            variant.raygenRegion.deviceAddress = variantAddress;
+            variant.raygenRegion.stride = handleSizeAligned;
+            variant.raygenRegion.size = handleSizeAligned;
 
-        size_t fileSize = static_cast<size_t>(file.tellg());
-        std::vector<char> buffer(fileSize);
+            // record i = traceRayEXT의 miss index
+            variant.missRegion.deviceAddress = variantAddress + handleSizeAligned;
+            variant.missRegion.stride = handleSizeAligned;
+            variant.missRegion.size = static_cast<VkDeviceSize>(handleSizeAligned) * missGroupCount;
 
-        file.seekg(0);
-        file.read(buffer.data(), fileSize);
-        file.close();
+            // record i = material i (instanceShaderBindingTableRecordOffset, sbtRecordStride 0)
+            variant.hitRegion.deviceAddress = variantAddress + static_cast<VkDeviceAddress>(handleSizeAligned) * (1 + missGroupCount);
+            variant.hitRegion.stride = handleSizeAligned;
+            variant.hitRegion.size = static_cast<VkDeviceSize>(handleSizeAligned) * hitRecordCount;
 
-        return buffer;
-    }
-
-    VkShaderModule LveRayTracingPipeline::createShaderModule(const std::vector<char>& code) {
-        VkShaderModuleCreateInfo createInfo{};
-        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        createInfo.codeSize = code.size();
-        createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
-
-        VkShaderModule shaderModule;
-        if (vkCreateShaderModule(lveDevice.device(), &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
-            throw std::runtime_error("failed to create shader module!");
+            std::cout << "[" << variant.preset.name << "] raygenRegion.deviceAddress: "
+                << variant.raygenRegion.deviceAddress << std::endl;
         }
 
-        return shaderModule;
+        callableRegion = {};
     }
 
 } // namespace lve
\ No newline at end of file
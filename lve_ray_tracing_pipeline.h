@@ -1,57 +1,90 @@
 ﻿#pragma once
 
 #include "lve_device.h"
+#include "lve_material_registry.h"
 #include <string>
 #include <vector>
 
 namespace lve {
 
+    // raygen specialization constant (constant_id 0, 1, 2) - preset별 pipeline 하나씩
+    struct LveQualityPreset {
+        std::string name;
+        uint32_t maxDepth;
+        uint32_t samplesPerPixel;
+        uint32_t russianRouletteDepth;  // 이 bounce부터 Russian roulette (>= maxDepth면 사실상 끔)
+    };
+
+    // interactive / balanced / final
+    std::vector<LveQualityPreset> defaultQualityPresets();
+
     class LveRayTracingPipeline {
     public:
         LveRayTracingPipeline(
             LveDevice& device,
             const std::string& raygenShader,
-            const std::string& missShader,
-            const std::string& closestHitShader
+            const std::vector<std::string>& missShaders,  // 순서 = traceRayEXT의 miss index (0: radiance, 1: shadow)
+            const LveMaterialRegistry& materials,        // material마다 hit group 하나
+            const std::string& intersectionShader = "",  // 비어있으면 triangle hit group
+            const std::vector<LveQualityPreset>& presets = defaultQualityPresets(),
+            const std::vector<VkDescriptorSetLayout>& extraSetLayouts = {}  // set 1..N (set 0은 이 pipeline의 layout)
         );
         ~LveRayTracingPipeline();
 
         LveRayTracingPipeline(const LveRayTracingPipeline&) = delete;
         LveRayTracingPipeline& operator=(const LveRayTracingPipeline&) = delete;
 
-        VkPipeline getPipeline() const { return pipeline; }
+        // 모든 preset pipeline이 미리 만들어져 있으므로 전환은 다음 기록부터 바로 적용 (GPU 대기 없음)
+        uint32_t getPresetCount() const { return static_cast<uint32_t>(variants.size()); }
+        const LveQualityPreset& getPreset(uint32_t index) const { return variants[index].preset; }
+        uint32_t getActivePreset() const { return activeVariant; }
+        void setActivePreset(uint32_t index);
+        bool setActivePreset(const std::string& name);
+
+        uint32_t getHitGroupCount() const { return hitGroupCount; }    // material 수
+        uint32_t getHitRecordCount() const { return hitRecordCount; }  // SBT hit record 수 (procedural이면 material × 2)
+
+        VkPipeline getPipeline() const { return variants[activeVariant].pipeline; }
         VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
         VkDescriptorSetLayout getDescriptorSetLayout() const { return descriptorSetLayout; }  // 추가!
 
-        VkStridedDeviceAddressRegionKHR getRaygenRegion() const { return raygenRegion; }
-        VkStridedDeviceAddressRegionKHR getMissRegion() const { return missRegion; }
-        VkStridedDeviceAddressRegionKHR getHitRegion() const { return hitRegion; }
+        VkStridedDeviceAddressRegionKHR getRaygenRegion() const { return variants[activeVariant].raygenRegion; }
+        VkStridedDeviceAddressRegionKHR getMissRegion() const { return variants[activeVariant].missRegion; }
+        VkStridedDeviceAddressRegionKHR getHitRegion() const { return variants[activeVariant].hitRegion; }
         VkStridedDeviceAddressRegionKHR getCallableRegion() const { return callableRegion; }
 
     private:
-        void createPipelineLayout();
-        void createRayTracingPipeline(
+        // preset별 pipeline + SBT region (shader group handle은 pipeline마다 다름)
+        struct Variant {
+            LveQualityPreset preset;
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            VkStridedDeviceAddressRegionKHR raygenRegion{};
+            VkStridedDeviceAddressRegionKHR missRegion{};
+            VkStridedDeviceAddressRegionKHR hitRegion{};
+        };
+
+        void createPipelineLayout(const std::vector<VkDescriptorSetLayout>& extraSetLayouts);
+        void createRayTracingPipelines(
             const std::string& raygenShader,
-            const std::string& missShader,
-            const std::string& closestHitShader
+            const std::vector<std::string>& missShaders,
+            const LveMaterialRegistry& materials,
+            const std::string& intersectionShader
         );
         void createShaderBindingTable();
 
-        std::vector<char> readFile(const std::string& filepath);
-        VkShaderModule createShaderModule(const std::vector<char>& code);
-
         LveDevice& lveDevice;
-        VkPipeline pipeline;
+        std::vector<Variant> variants;
+        uint32_t activeVariant = 0;
+        uint32_t missGroupCount = 0;
+        uint32_t hitGroupCount = 0;
+        uint32_t hitRecordCount = 0;
         VkPipelineLayout pipelineLayout;
         VkDescriptorSetLayout descriptorSetLayout;
 
-        // Shader Binding Table
+        // Shader Binding Table (variant마다 raygen / miss × missGroupCount / hit × hitRecordCount 연속)
         VkBuffer sbtBuffer;
-        VkDeviceMemory sbtMemory;
+        LveAllocation sbtAllocation;
 
-        VkStridedDeviceAddressRegionKHR raygenRegion{};
-        VkStridedDeviceAddressRegionKHR missRegion{};
-        VkStridedDeviceAddressRegionKHR hitRegion{};
         VkStridedDeviceAddressRegionKHR callableRegion{};
 
         // Ray Tracing Properties
@@ -0,0 +1,76 @@
+#include "lve_resolution_controller.h"
+
+// std
+#include <algorithm>
+#include <cmath>
+
+namespace lve {
+
+    namespace {
+        constexpr float SMOOTHING = 0.2f;        // frame time 지수 이동 평균 계수
+        constexpr uint32_t MIN_MEASUREMENTS = 4;  // settle 이후 이만큼 모여야 판단
+    }
+
+    LveResolutionController::LveResolutionController(const LveResolutionSettings& settings)
+        : settings{ settings } {
+        this->settings.minScale = std::clamp(this->settings.minScale, 0.1f, 1.0f);
+        this->settings.maxScale = std::clamp(this->settings.maxScale, this->settings.minScale, 1.0f);
+        reset();
+    }
+
+    void LveResolutionController::reset() {
+        scale = settings.maxScale;
+        smoothedMs = 0.0f;
+        sampleCount = 0;
+    }
+
+    float LveResolutionController::quantize(float value) const {
+        if (settings.scaleStep <= 0.0f) {
+            return value;
+        }
+        return std::round(value / settings.scaleStep) * settings.scaleStep;
+    }
+
+    bool LveResolutionController::update(float gpuFrameMs) {
+        // 배율을 바꾼 직후의 측정은 in-flight였던 이전 배율 프레임
+        sampleCount++;
+        if (sampleCount <= settings.settleFrames) {
+            return false;
+        }
+
+        const uint32_t measurements = sampleCount - settings.settleFrames;
+        smoothedMs = measurements == 1 ? gpuFrameMs : smoothedMs + SMOOTHING * (gpuFrameMs - smoothedMs);
+        if (measurements < MIN_MEASUREMENTS) {
+            return false;
+        }
+
+        const bool overBudget = smoothedMs > settings.targetMs * settings.downThreshold;
+        const bool underBudget = smoothedMs < settings.targetMs * settings.upThreshold;
+        if (!overBudget && !underBudget) {
+            return false;
+        }
+
+        // hysteresis 구간 가운데를 노려서 다음 측정이 바로 반대쪽으로 넘어가지 않게
+        const float aimMs = settings.targetMs * 0.5f * (settings.downThreshold + settings.upThreshold);
+        float desired = scale * std::sqrt(aimMs / std::max(smoothedMs, 1e-3f));
+        desired = std::clamp(quantize(desired), settings.minScale, settings.maxScale);
+
+        if (desired == scale) {
+            return false;
+        }
+
+        scale = desired;
+        sampleCount = 0;
+        return true;
+    }
+
+    VkExtent2D LveResolutionController::getExtent(VkExtent2D fullExtent) const {
+        VkExtent2D extent{};
+        extent.width = std::max(1u, static_cast<uint32_t>(std::lround(fullExtent.width * scale)));
+        extent.height = std::max(1u, static_cast<uint32_t>(std::lround(fullExtent.height * scale)));
+        extent.width = std::min(extent.width, fullExtent.width);
+        extent.height = std::min(extent.height, fullExtent.height);
+        return extent;
+    }
+
+}  // namespace lve
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+// std lib headers
+#include <cstdint>
+
+namespace lve {
+
+    struct LveResolutionSettings {
+        float targetMs = 16.6f;          // GPU frame time 목표
+        float minScale = 0.5f;           // 축 방향 배율 하한 (pixel 수는 제곱)
+        float maxScale = 1.0f;
+        float downThreshold = 1.05f;     // 평균이 목표 × 이 값보다 크면 줄임
+        float upThreshold = 0.85f;       // 평균이 목표 × 이 값보다 작으면 키움 (사이는 유지 = hysteresis)
+        float scaleStep = 1.0f / 32.0f;  // 배율 양자화 (작은 흔들림으로 누적이 reset되지 않도록)
+        uint32_t settleFrames = 8;       // 배율을 바꾼 뒤 이만큼은 측정만 (in-flight 프레임은 이전 배율)
+    };
+
+    // Dynamic resolution: 측정한 GPU frame time으로 trace 해상도 배율을 정함
+    // - 비용 ≈ pixel 수 ∝ scale² 라고 보고 sqrt(target / measured)로 한 번에 목표 배율로 이동
+    // - 평균이 [upThreshold, downThreshold] × target 안이면 그대로 (hysteresis)
+    class LveResolutionController {
+    public:
+        explicit LveResolutionController(const LveResolutionSettings& settings = LveResolutionSettings{});
+
+        // 새 GPU frame time 측정값. 배율이 바뀌면 true (누적 결과는 더 이상 맞지 않음)
+        bool update(float gpuFrameMs);
+
+        void reset();  // 배율 1 (maxScale)로, 측정 기록 삭제
+
+        float getScale() const { return scale; }
+        float getSmoothedMs() const { return smoothedMs; }
+        const LveResolutionSettings& getSettings() const { return settings; }
+
+        // fullExtent에 배율을 적용한 trace 해상도 (최소 1 × 1)
+        VkExtent2D getExtent(VkExtent2D fullExtent) const;
+
+    private:
+        float quantize(float value) const;
+
+        LveResolutionSettings settings;
+        float scale;
+        float smoothedMs = 0.0f;
+        uint32_t sampleCount = 0;  // 마지막 변경 이후 측정 수
+    };
+
+}  // namespace lve
@@ -0,0 +1,205 @@
+#include "lve_sampler.h"
+#include "lve_staging_ring.h"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace lve {
+
+    namespace {
+        constexpr float BLUE_NOISE_SIGMA = 1.5f;        // energy Gaussian 폭 (pixel)
+        constexpr float INITIAL_PATTERN_DENSITY = 0.1f;  // 처음에 찍는 점 비율
+
+        // 점(minority pixel)마다 toroidal Gaussian을 더한 energy
+        // 큰 값 = 점이 몰린 곳 (tightest cluster), 작은 값 = 비어 있는 곳 (largest void)
+        class EnergyField {
+        public:
+            explicit EnergyField(uint32_t size) : size{ size }, kernel(size * size), energy(size * size, 0.0f) {
+                for (uint32_t y = 0; y < size; y++) {
+                    for (uint32_t x = 0; x < size; x++) {
+                        float dx = static_cast<float>(std::min(x, size - x));
+                        float dy = static_cast<float>(std::min(y, size - y));
+                        kernel[y * size + x] = std::exp(-(dx * dx + dy * dy) / (2.0f * BLUE_NOISE_SIGMA * BLUE_NOISE_SIGMA));
+                    }
+                }
+            }
+
+            void splat(uint32_t index, float weight) {
+                const uint32_t px = index % size;
+                const uint32_t py = index / size;
+                for (uint32_t y = 0; y < size; y++) {
+                    const float* kernelRow = &kernel[((y + size - py) % size) * size];
+                    float* energyRow = &energy[y * size];
+                    for (uint32_t x = 0; x < size; x++) {
+                        energyRow[x] += weight * kernelRow[(x + size - px) % size];
+                    }
+                }
+            }
+
+            // pattern[i] == value인 pixel 중 energy 최대 / 최소
+            uint32_t findMax(const std::vector<uint8_t>& pattern, uint8_t value) const {
+                uint32_t best = 0;
+                float bestEnergy = -1e30f;
+                for (uint32_t i = 0; i < energy.size(); i++) {
+                    if (pattern[i] == value && energy[i] > bestEnergy) {
+                        bestEnergy = energy[i];
+                        best = i;
+                    }
+                }
+                return best;
+            }
+
+            uint32_t findMin(const std::vector<uint8_t>& pattern, uint8_t value) const {
+                uint32_t best = 0;
+                float bestEnergy = 1e30f;
+                for (uint32_t i = 0; i < energy.size(); i++) {
+                    if (pattern[i] == value && energy[i] < bestEnergy) {
+                        bestEnergy = energy[i];
+                        best = i;
+                    }
+                }
+                return best;
+            }
+
+        private:
+            uint32_t size;
+            std::vector<float> kernel;  // 원점 기준 toroidal 거리의 Gaussian
+            std::vector<float> energy;
+        };
+    }
+
+    LveSampler::LveSampler(LveDevice& device, LveSamplerType type) : lveDevice{ device }, type{ type } {
+        createBlueNoiseBuffer();
+    }
+
+    LveSampler::~LveSampler() {
+        lveDevice.destroyBuffer(blueNoiseBuffer, blueNoiseAllocation);
+    }
+
+    LveSamplerType LveSampler::nextType() const {
+        switch (type) {
+        case LveSamplerType::Random: return LveSamplerType::Sobol;
+        case LveSamplerType::Sobol: return LveSamplerType::BlueNoise;
+        default: return LveSamplerType::Random;
+        }
+    }
+
+    const char* LveSampler::getTypeName(LveSamplerType type) {
+        switch (type) {
+        case LveSamplerType::Random: return "random";
+        case LveSamplerType::BlueNoise: return "bluenoise";
+        default: return "sobol";
+        }
+    }
+
+    std::vector<uint32_t> LveSampler::generateBlueNoise(uint32_t size, uint32_t seed) {
+        const uint32_t pixelCount = size * size;
+        const uint32_t initialCount = std::max(1u, static_cast<uint32_t>(pixelCount * INITIAL_PATTERN_DENSITY));
+
+        // 초기 pattern: 무작위 점
+        std::vector<uint8_t> pattern(pixelCount, 0);
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint32_t> pick(0, pixelCount - 1);
+        for (uint32_t placed = 0; placed < initialCount;) {
+            uint32_t index = pick(rng);
+            if (!pattern[index]) {
+                pattern[index] = 1;
+                placed++;
+            }
+        }
+
+        EnergyField field(size);
+        for (uint32_t i = 0; i < pixelCount; i++) {
+            if (pattern[i]) field.splat(i, 1.0f);
+        }
+
+        // 가장 몰린 점을 가장 빈 곳으로 옮기기를 제자리로 돌아올 때까지 반복 (고르게 퍼진 초기 pattern)
+        for (uint32_t iteration = 0; iteration < pixelCount; iteration++) {
+            uint32_t cluster = field.findMax(pattern, 1);
+            pattern[cluster] = 0;
+            field.splat(cluster, -1.0f);
+
+            uint32_t largestVoid = field.findMin(pattern, 0);
+            pattern[largestVoid] = 1;
+            field.splat(largestVoid, 1.0f);
+
+            if (largestVoid == cluster) break;
+        }
+
+        std::vector<uint32_t> ranks(pixelCount, 0);
+
+        // Phase 1: 초기 점을 cluster부터 빼면서 rank initialCount - 1 → 0
+        {
+            std::vector<uint8_t> removing = pattern;
+            EnergyField removingField = field;
+            for (uint32_t rank = initialCount; rank-- > 0;) {
+                uint32_t cluster = removingField.findMax(removing, 1);
+                removing[cluster] = 0;
+                removingField.splat(cluster, -1.0f);
+                ranks[cluster] = rank;
+            }
+        }
+
+        // Phase 2: 절반까지 가장 빈 곳을 채움
+        uint32_t rank = initialCount;
+        for (; rank < pixelCount / 2; rank++) {
+            uint32_t largestVoid = field.findMin(pattern, 0);
+            pattern[largestVoid] = 1;
+            field.splat(largestVoid, 1.0f);
+            ranks[largestVoid] = rank;
+        }
+
+        // Phase 3: 나머지는 0이 minority → 0끼리 가장 몰린 곳부터 채움
+        EnergyField zeroField(size);
+        for (uint32_t i = 0; i < pixelCount; i++) {
+            if (!pattern[i]) zeroField.splat(i, 1.0f);
+        }
+        for (; rank < pixelCount; rank++) {
+            uint32_t cluster = zeroField.findMax(pattern, 0);
+            pattern[cluster] = 1;
+            zeroField.splat(cluster, -1.0f);
+            ranks[cluster] = rank;
+        }
+
+        return ranks;
+    }
+
+    void LveSampler::createBlueNoiseBuffer() {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        const uint32_t pixelCount = BLUE_NOISE_SIZE * BLUE_NOISE_SIZE;
+        std::vector<uint32_t> rankX = generateBlueNoise(BLUE_NOISE_SIZE, 1);
+        std::vector<uint32_t> rankY = generateBlueNoise(BLUE_NOISE_SIZE, 2);
+
+        // rank → pixel 중앙의 16-bit fixed point, x는 하위 / y는 상위 16 bit (sampler.glsl blue_noise_2d)
+        std::vector<uint32_t> texels(pixelCount);
+        for (uint32_t i = 0; i < pixelCount; i++) {
+            uint32_t x = static_cast<uint32_t>((2ull * rankX[i] + 1) * 65536 / (2ull * pixelCount));
+            uint32_t y = static_cast<uint32_t>((2ull * rankY[i] + 1) * 65536 / (2ull * pixelCount));
+            texels[i] = x | (y << 16);
+        }
+
+        const VkDeviceSize bufferSize = sizeof(uint32_t) * pixelCount;
+        lveDevice.createBuffer(
+            bufferSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            blueNoiseBuffer,
+            blueNoiseAllocation
+        );
+
+        LveStagingRing& stagingRing = lveDevice.getStagingRing();
+        stagingRing.uploadBuffer(texels.data(), bufferSize, blueNoiseBuffer);
+        stagingRing.flush();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        float ms = std::chrono::duration<float, std::milli>(end - start).count();
+        std::cout << "Blue noise: " << BLUE_NOISE_SIZE << "x" << BLUE_NOISE_SIZE << " x 2 channels generated in "
+            << ms << " ms" << std::endl;
+    }
+
+}  // namespace lve
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "lve_device.h"
+
+// std lib headers
+#include <cstdint>
+#include <vector>
+
+namespace lve {
+
+    // shaders/sampler.glsl의 SAMPLER_* 값과 같음 (push constant로 그대로 전달)
+    enum class LveSamplerType : uint32_t {
+        Random = 0,     // pixel / sample / dimension hash (이전 RNG와 같은 white noise)
+        Sobol = 1,      // Owen-scrambled Sobol, dimension pair마다 index shuffle
+        BlueNoise = 2   // blue-noise texture, sample마다 R2 회전
+    };
+
+    // Low-discrepancy sampler의 GPU 자원
+    // - 모든 backend가 같은 함수 (sample_2d)로 (pixel, sample index, dimension) → [0, 1)^2
+    // - Blue-noise texture는 시작 시 void-and-cluster로 만들어 storage buffer로 업로드
+    //   (ray tracing set, wavefront set 모두 binding 10)
+    class LveSampler {
+    public:
+        static constexpr uint32_t BLUE_NOISE_SIZE = 64;  // shaders/sampler.glsl과 같아야 함 (2의 거듭제곱)
+
+        LveSampler(LveDevice& device, LveSamplerType type);
+        ~LveSampler();
+
+        LveSampler(const LveSampler&) = delete;
+        LveSampler& operator=(const LveSampler&) = delete;
+
+        LveSamplerType getType() const { return type; }
+        void setType(LveSamplerType samplerType) { type = samplerType; }
+        LveSamplerType nextType() const;  // N 키 순환 순서
+
+        VkBuffer getBlueNoiseBuffer() const { return blueNoiseBuffer; }
+
+        static const char* getTypeName(LveSamplerType type);
+
+    private:
+        // 한 channel의 rank (0 ~ size² - 1), void-and-cluster (Ulichney 1993)
+        static std::vector<uint32_t> generateBlueNoise(uint32_t size, uint32_t seed);
+        void createBlueNoiseBuffer();
+
+        LveDevice& lveDevice;
+        LveSamplerType type;
+
+        VkBuffer blueNoiseBuffer = VK_NULL_HANDLE;
+        LveAllocation blueNoiseAllocation{};
+    };
+
+}  // namespace lve
@@ -0,0 +1,323 @@
+#include "lve_scene_file.h"
+#include "lve_json.h"
+
+// std
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lve {
+
+    namespace {
+        constexpr char SCENE_MAGIC[4] = { 'L', 'V', 'S', 'C' };
+        constexpr uint64_t TABLE_ALIGNMENT = 16;
+
+        uint64_t alignTable(uint64_t offset) {
+            return (offset + TABLE_ALIGNMENT - 1) & ~(TABLE_ALIGNMENT - 1);
+        }
+
+        float readNumber(const LveJsonValue& object, const char* key, float fallback, const std::string& context) {
+            const LveJsonValue* value = object.find(key);
+            if (!value) return fallback;
+            if (value->type != LveJsonValue::Type::Number) {
+                throw std::runtime_error(context + ": \"" + key + "\" must be a number");
+            }
+            return static_cast<float>(value->number);
+        }
+
+        glm::vec3 readVec3(const LveJsonValue& object, const char* key, const glm::vec3& fallback, const std::string& context,
+            bool required = false) {
+            const LveJsonValue* value = object.find(key);
+            if (!value) {
+                if (required) throw std::runtime_error(context + ": missing \"" + key + "\"");
+                return fallback;
+            }
+            if (value->type != LveJsonValue::Type::Array || value->array.size() != 3 ||
+                value->array[0].type != LveJsonValue::Type::Number ||
+                value->array[1].type != LveJsonValue::Type::Number ||
+                value->array[2].type != LveJsonValue::Type::Number) {
+                throw std::runtime_error(context + ": \"" + key + "\" must be [x, y, z]");
+            }
+            return glm::vec3(static_cast<float>(value->array[0].number), static_cast<float>(value->array[1].number),
+                static_cast<float>(value->array[2].number));
+        }
+
+        // material 객체 → SphereInfo의 color / materialType / materialParam (center / radius는 채우지 않음)
+        SphereInfo parseMaterial(const LveJsonValue& material, const std::string& context) {
+            if (material.type != LveJsonValue::Type::Object) {
+                throw std::runtime_error(context + ": material must be an object");
+            }
+
+            const LveJsonValue* type = material.find("type");
+            if (!type || type->type != LveJsonValue::Type::String) {
+                throw std::runtime_error(context + ": material needs a \"type\" string");
+            }
+
+            SphereInfo info{};
+            info.color = readVec3(material, "color", glm::vec3(1.0f), context);
+
+            if (type->string == "lambertian") {
+                info.materialType = MATERIAL_LAMBERTIAN;
+            }
+            else if (type->string == "metal") {
+                info.materialType = MATERIAL_METAL;
+                info.materialParam = readNumber(material, "fuzz", 0.0f, context);
+            }
+            else if (type->string == "dielectric") {
+                info.materialType = MATERIAL_DIELECTRIC;
+                info.materialParam = readNumber(material, "ior", 1.5f, context);
+            }
+            else if (type->string == "emissive") {
+                info.materialType = MATERIAL_EMISSIVE;
+                info.materialParam = readNumber(material, "intensity", 1.0f, context);
+            }
+            else {
+                throw std::runtime_error(context + ": unknown material type \"" + type->string + "\"");
+            }
+            return info;
+        }
+    }
+
+    LveSceneFile::LveSceneFile(const std::string& path) : path{ path } {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("failed to open scene file: " + path);
+        }
+        fileHandle = file;
+
+        LARGE_INTEGER fileSize{};
+        GetFileSizeEx(file, &fileSize);
+        size = static_cast<size_t>(fileSize.QuadPart);
+
+        if (size > 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) {
+                unmap();
+                throw std::runtime_error("failed to map scene file: " + path);
+            }
+            mappingHandle = mapping;
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+#else
+        fileDescriptor = open(path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0) {
+            throw std::runtime_error("failed to open scene file: " + path);
+        }
+
+        struct stat fileStat {};
+        if (fstat(fileDescriptor, &fileStat) < 0) {
+            unmap();
+            throw std::runtime_error("failed to stat scene file: " + path);
+        }
+        size = static_cast<size_t>(fileStat.st_size);
+
+        if (size > 0) {
+            void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            data = mapped == MAP_FAILED ? nullptr : static_cast<const char*>(mapped);
+            if (data) {
+                // table은 처음부터 끝까지 한 번 복사하므로 미리 읽어 두도록 (advice는 flag가 아니라 하나씩)
+                madvise(mapped, size, MADV_SEQUENTIAL);
+                madvise(mapped, size, MADV_WILLNEED);
+            }
+        }
+#endif
+        if (!data) {
+            unmap();
+            throw std::runtime_error("failed to map scene file: " + path);
+        }
+
+        // 검증 실패 시 소멸자가 불리지 않으므로 직접 해제
+        auto reject = [&](const std::string& reason) {
+            unmap();
+            throw std::runtime_error("invalid scene file " + path + ": " + reason);
+        };
+
+        if (size < sizeof(LveSceneFileHeader)) reject("file too small");
+        header = reinterpret_cast<const LveSceneFileHeader*>(data);
+
+        if (std::memcmp(header->magic, SCENE_MAGIC, sizeof(SCENE_MAGIC)) != 0) reject("bad magic");
+        if (header->version != VERSION) {
+            reject("version " + std::to_string(header->version) + ", expected " + std::to_string(VERSION));
+        }
+        if (header->headerSize != sizeof(LveSceneFileHeader)) reject("unexpected header size");
+        if (header->sphereStride != sizeof(SphereInfo)) reject("SphereInfo layout mismatch (re-export the scene)");
+        if (header->sphereCount > MAX_SPHERES) reject("too many spheres");
+        if (header->lightCount > header->sphereCount) reject("more lights than spheres");
+        if (header->sphereOffset % TABLE_ALIGNMENT != 0 || header->lightOffset % TABLE_ALIGNMENT != 0) {
+            reject("misaligned table");
+        }
+
+        // offset + count * stride는 overflow할 수 있으므로 남은 크기로 나눠서 비교
+        auto tableFits = [&](uint64_t offset, uint32_t count, uint64_t stride) {
+            return offset >= sizeof(LveSceneFileHeader) && offset <= size && count <= (size - offset) / stride;
+        };
+        if (!tableFits(header->sphereOffset, header->sphereCount, sizeof(SphereInfo)) ||
+            !tableFits(header->lightOffset, header->lightCount, sizeof(uint32_t))) {
+            reject("table out of range");
+        }
+
+        const uint32_t* lights = getLightIndices();
+        for (uint32_t i = 0; i < header->lightCount; i++) {
+            if (lights[i] >= header->sphereCount) reject("light index out of range");
+        }
+
+        // meshId는 예전 padding 자리 - scene 파일에는 mesh가 없으므로 (export가 거부) 항상 0
+        const SphereInfo* spheres = getSpheres();
+        for (uint32_t i = 0; i < header->sphereCount; i++) {
+            if (spheres[i].meshId != 0) reject("sphere " + std::to_string(i) + " has a mesh id");
+        }
+    }
+
+    LveSceneFile::~LveSceneFile() {
+        unmap();
+    }
+
+    void LveSceneFile::unmap() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+        if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        if (data) munmap(const_cast<char*>(data), size);
+        if (fileDescriptor >= 0) close(fileDescriptor);
+        fileDescriptor = -1;
+#endif
+        data = nullptr;
+        header = nullptr;
+    }
+
+    const SphereInfo* LveSceneFile::getSpheres() const {
+        return reinterpret_cast<const SphereInfo*>(data + header->sphereOffset);
+    }
+
+    const uint32_t* LveSceneFile::getLightIndices() const {
+        return reinterpret_cast<const uint32_t*>(data + header->lightOffset);
+    }
+
+    void LveSceneFile::write(const std::string& path, const std::vector<SphereInfo>& spheres,
+        const std::vector<uint32_t>& lightIndices, float skyIntensity) {
+        if (spheres.size() > MAX_SPHERES) {
+            throw std::runtime_error("too many spheres for a scene file: " + std::to_string(spheres.size()));
+        }
+
+        LveSceneFileHeader header{};
+        std::memcpy(header.magic, SCENE_MAGIC, sizeof(SCENE_MAGIC));
+        header.version = VERSION;
+        header.headerSize = sizeof(LveSceneFileHeader);
+        header.sphereStride = sizeof(SphereInfo);
+        header.sphereCount = static_cast<uint32_t>(spheres.size());
+        header.lightCount = static_cast<uint32_t>(lightIndices.size());
+        header.skyIntensity = skyIntensity;
+        header.sphereOffset = alignTable(sizeof(LveSceneFileHeader));
+        header.lightOffset = alignTable(header.sphereOffset + sizeof(SphereInfo) * spheres.size());
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("failed to open scene output: " + path);
+        }
+
+        const char zeros[TABLE_ALIGNMENT] = {};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(zeros, static_cast<std::streamsize>(header.sphereOffset - sizeof(header)));
+        file.write(reinterpret_cast<const char*>(spheres.data()), static_cast<std::streamsize>(sizeof(SphereInfo) * spheres.size()));
+        file.write(zeros, static_cast<std::streamsize>(header.lightOffset - header.sphereOffset - sizeof(SphereInfo) * spheres.size()));
+        file.write(reinterpret_cast<const char*>(lightIndices.data()), static_cast<std::streamsize>(sizeof(uint32_t) * lightIndices.size()));
+
+        if (!file) {
+            throw std::runtime_error("failed to write scene file: " + path);
+        }
+
+        std::cout << "Wrote scene " << path << " (" << spheres.size() << " spheres, " << lightIndices.size()
+            << " lights)" << std::endl;
+    }
+
+    void LveSceneFile::convertJson(const std::string& jsonPath, const std::string& outputPath) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        const LveJsonValue root = LveJsonValue::load(jsonPath);
+        if (root.type != LveJsonValue::Type::Object) {
+            throw std::runtime_error(jsonPath + ": top level must be an object");
+        }
+
+        // 이름 있는 material (sphere에서 이름 또는 inline 객체로 참조)
+        std::unordered_map<std::string, SphereInfo> materials;
+        if (const LveJsonValue* materialTable = root.find("materials")) {
+            if (materialTable->type != LveJsonValue::Type::Object) {
+                throw std::runtime_error(jsonPath + ": \"materials\" must be an object");
+            }
+            for (const auto& member : materialTable->object) {
+                materials[member.first] = parseMaterial(member.second, jsonPath + ": materials." + member.first);
+            }
+        }
+
+        const LveJsonValue* sphereArray = root.find("spheres");
+        if (!sphereArray || sphereArray->type != LveJsonValue::Type::Array) {
+            throw std::runtime_error(jsonPath + ": missing \"spheres\" array");
+        }
+
+        std::vector<SphereInfo> spheres;
+        std::vector<uint32_t> lightIndices;
+        spheres.reserve(sphereArray->array.size());
+
+        for (size_t i = 0; i < sphereArray->array.size(); i++) {
+            const LveJsonValue& sphere = sphereArray->array[i];
+            const std::string context = jsonPath + ": spheres[" + std::to_string(i) + "]";
+            if (sphere.type != LveJsonValue::Type::Object) {
+                throw std::runtime_error(context + ": sphere must be an object");
+            }
+
+            const LveJsonValue* material = sphere.find("material");
+            SphereInfo info{};
+            if (!material) {
+                throw std::runtime_error(context + ": missing \"material\"");
+            }
+            if (material->type == LveJsonValue::Type::String) {
+                auto it = materials.find(material->string);
+                if (it == materials.end()) {
+                    throw std::runtime_error(context + ": unknown material \"" + material->string + "\"");
+                }
+                info = it->second;
+            }
+            else {
+                info = parseMaterial(*material, context);
+            }
+
+            info.center = readVec3(sphere, "center", glm::vec3(0.0f), context, true);
+            info.radius = readNumber(sphere, "radius", 1.0f, context);
+            if (info.radius <= 0.0f) {
+                throw std::runtime_error(context + ": radius must be positive");
+            }
+
+            if (info.materialType == MATERIAL_EMISSIVE) {
+                lightIndices.push_back(static_cast<uint32_t>(spheres.size()));
+            }
+            spheres.push_back(info);
+        }
+
+        const float skyIntensity = readNumber(root, "skyIntensity", 1.0f, jsonPath);
+        write(outputPath, spheres, lightIndices, skyIntensity);
+
+        float totalMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "Converted " << jsonPath << " in " << totalMs << " ms" << std::endl;
+    }
+
+}  // namespace lve
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "lve_acceleration_structure.h"
+
+// std lib headers
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+    // Binary scene 파일 (.lvscene, little endian)
+    // [header 64 bytes][SphereInfo × sphereCount (std430, GPU sphere info buffer와 같은 layout)][uint32 light index × lightCount]
+    // - material은 SphereInfo 안에 있고 instance transform은 center / radius에서 만들어지므로 table은 이 두 개
+    // - 각 table은 16 bytes 정렬, 읽을 때 parsing 없이 mmap한 그대로 복사
+    struct LveSceneFileHeader {
+        char magic[4];              // "LVSC"
+        uint32_t version;           // LveSceneFile::VERSION
+        uint32_t headerSize;        // sizeof(LveSceneFileHeader)
+        uint32_t sphereStride;      // sizeof(SphereInfo) - layout이 바뀌면 읽기 거부
+        uint64_t sphereOffset;
+        uint64_t lightOffset;
+        uint32_t sphereCount;
+        uint32_t lightCount;
+        float skyIntensity;
+        uint32_t reserved[5];
+    };
+    static_assert(sizeof(LveSceneFileHeader) == 64, "scene file header must stay 64 bytes");
+
+    // 읽기 전용으로 mmap한 scene 파일 (객체가 살아있는 동안 table pointer 유효)
+    class LveSceneFile {
+    public:
+        static constexpr uint32_t VERSION = 1;
+        static constexpr uint32_t MAX_SPHERES = 1u << 24;  // instanceCustomIndex가 24 bit
+
+        explicit LveSceneFile(const std::string& path);  // mmap + header / 범위 검증
+        ~LveSceneFile();
+
+        LveSceneFile(const LveSceneFile&) = delete;
+        LveSceneFile& operator=(const LveSceneFile&) = delete;
+
+        const SphereInfo* getSpheres() const;
+        uint32_t getSphereCount() const { return header->sphereCount; }
+        const uint32_t* getLightIndices() const;
+        uint32_t getLightCount() const { return header->lightCount; }
+        float getSkyIntensity() const { return header->skyIntensity; }
+
+        static void write(const std::string& path, const std::vector<SphereInfo>& spheres,
+            const std::vector<uint32_t>& lightIndices, float skyIntensity);
+
+        // 사람이 쓰는 JSON 장면 → binary (Vulkan 없이 실행)
+        static void convertJson(const std::string& jsonPath, const std::string& outputPath);
+
+    private:
+        void unmap();
+
+        std::string path;
+        const char* data = nullptr;
+        size_t size = 0;
+        const LveSceneFileHeader* header = nullptr;
+
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#else
+        int fileDescriptor = -1;
+#endif
+    };
+
+}  // namespace lve
@@ -0,0 +1,251 @@
+#include "lve_staging_ring.h"
+#include "lve_device.h"
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace lve {
+
+    namespace {
+        constexpr VkDeviceSize RING_ALIGNMENT = 16;
+
+        VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    LveStagingRing::LveStagingRing(LveDevice& device, VkDeviceSize capacity)
+        : lveDevice{ device }, capacity{ capacity } {
+        lveDevice.createBuffer(
+            capacity,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            ringBuffer,
+            ringAllocation
+        );
+        mapped = static_cast<uint8_t*>(ringAllocation.mapped);
+
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.queueFamilyIndex = lveDevice.findPhysicalQueueFamilies().graphicsFamily;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+        if (vkCreateCommandPool(lveDevice.device(), &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create staging command pool!");
+        }
+    }
+
+    LveStagingRing::~LveStagingRing() {
+        waitIdle();
+
+        for (Batch& batch : freeBatches) {
+            vkDestroyFence(lveDevice.device(), batch.fence, nullptr);
+        }
+        vkDestroyCommandPool(lveDevice.device(), commandPool, nullptr);
+        lveDevice.destroyBuffer(ringBuffer, ringAllocation);
+    }
+
+    LveStagingRing::Ticket LveStagingRing::uploadBuffer(
+        const void* data, VkDeviceSize size, VkBuffer dstBuffer, VkDeviceSize dstOffset) {
+        const uint8_t* src = static_cast<const uint8_t*>(data);
+
+        // ring보다 큰 데이터는 나눠서 (앞 조각이 submit되어야 공간이 생김)
+        const VkDeviceSize maxChunk = capacity / 2;
+        VkDeviceSize copied = 0;
+
+        while (copied < size) {
+            VkDeviceSize chunk = std::min(size - copied, maxChunk);
+            VkDeviceSize offset = reserve(chunk);
+
+            if (!hasPending) {
+                beginPendingBatch();
+            }
+
+            memcpy(mapped + offset, src + copied, chunk);
+
+            VkBufferCopy copyRegion{};
+            copyRegion.srcOffset = offset;
+            copyRegion.dstOffset = dstOffset + copied;
+            copyRegion.size = chunk;
+            vkCmdCopyBuffer(pending.commandBuffer, ringBuffer, dstBuffer, 1, &copyRegion);
+
+            pending.ringEnd = head;
+            copied += chunk;
+        }
+
+        return hasPending ? pending.ticket : nextTicket - 1;
+    }
+
+    LveStagingRing::Ticket LveStagingRing::flush() {
+        if (!hasPending) {
+            return nextTicket - 1;
+        }
+
+        // 이후 submit (AS build, shader read 등)에서 copy 결과가 보이도록
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+        vkCmdPipelineBarrier(pending.commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        if (vkEndCommandBuffer(pending.commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to record staging command buffer!");
+        }
+
+        vkResetFences(lveDevice.device(), 1, &pending.fence);
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &pending.commandBuffer;
+
+        if (vkQueueSubmit(lveDevice.graphicsQueue(), 1, &submitInfo, pending.fence) != VK_SUCCESS) {
+            throw std::runtime_error("failed to submit staging command buffer!");
+        }
+
+        Ticket ticket = pending.ticket;
+        inFlight.push_back(pending);
+        pending = Batch{};
+        hasPending = false;
+        nextTicket++;
+
+        return ticket;
+    }
+
+    bool LveStagingRing::isComplete(Ticket ticket) {
+        retireCompleted();
+        return ticket <= completedTicket;
+    }
+
+    void LveStagingRing::wait(Ticket ticket) {
+        if (hasPending && ticket >= pending.ticket) {
+            flush();
+        }
+
+        retireCompleted();
+        while (completedTicket < ticket && !inFlight.empty()) {
+            waitOldest();
+        }
+    }
+
+    void LveStagingRing::waitIdle() {
+        flush();
+        while (!inFlight.empty()) {
+            waitOldest();
+        }
+    }
+
+    VkDeviceSize LveStagingRing::reserve(VkDeviceSize size) {
+        retireCompleted();
+
+        VkDeviceSize offset = 0;
+        while (!tryReserve(size, offset)) {
+            // 공간 부족: 쌓인 copy를 먼저 내보내고, 그래도 없으면 가장 오래된 batch만 기다림
+            if (hasPending) {
+                flush();
+            }
+            else if (!inFlight.empty()) {
+                waitOldest();
+            }
+            else {
+                throw std::runtime_error("staging upload larger than staging ring!");
+            }
+        }
+
+        return offset;
+    }
+
+    bool LveStagingRing::tryReserve(VkDeviceSize size, VkDeviceSize& offset) {
+        if (isEmpty()) {
+            head = 0;
+            tail = 0;
+        }
+
+        // 사용 중인 구간: [tail, head) 또는 wrap된 경우 [tail, capacity) + [0, head)
+        const bool wrapped = head < tail || (head == tail && !isEmpty());
+        VkDeviceSize aligned = alignUp(head, RING_ALIGNMENT);
+
+        if (!wrapped) {
+            if (aligned + size <= capacity) {
+                offset = aligned;
+                head = aligned + size;
+                return true;
+            }
+            // 끝부분은 버리고 앞으로 돌아감
+            if (size <= tail) {
+                offset = 0;
+                head = size;
+                return true;
+            }
+            return false;
+        }
+
+        if (aligned + size <= tail) {
+            offset = aligned;
+            head = aligned + size;
+            return true;
+        }
+        return false;
+    }
+
+    void LveStagingRing::beginPendingBatch() {
+        if (freeBatches.empty()) {
+            Batch batch{};
+
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = commandPool;
+            allocInfo.commandBufferCount = 1;
+            if (vkAllocateCommandBuffers(lveDevice.device(), &allocInfo, &batch.commandBuffer) != VK_SUCCESS) {
+                throw std::runtime_error("failed to allocate staging command buffer!");
+            }
+
+            VkFenceCreateInfo fenceInfo{};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            if (vkCreateFence(lveDevice.device(), &fenceInfo, nullptr, &batch.fence) != VK_SUCCESS) {
+                vkFreeCommandBuffers(lveDevice.device(), commandPool, 1, &batch.commandBuffer);
+                throw std::runtime_error("failed to create staging fence!");
+            }
+
+            freeBatches.push_back(batch);
+        }
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        // 실패하면 batch는 free list에 남겨 둠 (pending 없음)
+        if (vkBeginCommandBuffer(freeBatches.back().commandBuffer, &beginInfo) != VK_SUCCESS) {
+            throw std::runtime_error("failed to begin staging command buffer!");
+        }
+
+        pending = freeBatches.back();
+        freeBatches.pop_back();
+        pending.ticket = nextTicket;
+        pending.ringEnd = head;
+        hasPending = true;
+    }
+
+    void LveStagingRing::retireCompleted() {
+        while (!inFlight.empty() &&
+            vkGetFenceStatus(lveDevice.device(), inFlight.front().fence) == VK_SUCCESS) {
+            Batch& batch = inFlight.front();
+            tail = batch.ringEnd;
+            completedTicket = batch.ticket;
+            freeBatches.push_back(batch);
+            inFlight.pop_front();
+        }
+    }
+
+    void LveStagingRing::waitOldest() {
+        vkWaitForFences(lveDevice.device(), 1, &inFlight.front().fence, VK_TRUE, UINT64_MAX);
+        retireCompleted();
+    }
+
+}  // namespace lve
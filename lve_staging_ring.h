@@ -0,0 +1,77 @@
+#pragma once
+
+#include "lve_memory_allocator.h"
+
+#include <vulkan/vulkan.h>
+
+// std lib headers
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace lve {
+
+    class LveDevice;
+
+    // Persistent map된 staging ring buffer
+    // upload는 ring에 memcpy + 대기 중인 command buffer에 copy 기록만 하고,
+    // flush()에서 한 번에 submit (fence로 ring 구간 회수, vkQueueWaitIdle 없음)
+    class LveStagingRing {
+    public:
+        using Ticket = uint64_t;
+
+        static constexpr VkDeviceSize DEFAULT_CAPACITY = 32ull * 1024 * 1024;
+
+        LveStagingRing(LveDevice& device, VkDeviceSize capacity = DEFAULT_CAPACITY);
+        ~LveStagingRing();
+
+        LveStagingRing(const LveStagingRing&) = delete;
+        LveStagingRing& operator=(const LveStagingRing&) = delete;
+
+        // 반환된 ticket은 이 upload가 포함될 batch (flush 전에는 아직 submit 안 됨)
+        Ticket uploadBuffer(const void* data, VkDeviceSize size, VkBuffer dstBuffer, VkDeviceSize dstOffset = 0);
+
+        // 대기 중인 copy를 submit. 끝에 transfer → 모든 stage barrier가 들어가므로
+        // 같은 queue의 이후 submit은 따로 기다리지 않고 결과를 읽을 수 있음
+        Ticket flush();
+
+        bool isComplete(Ticket ticket);
+        void wait(Ticket ticket);
+        void waitIdle();
+
+    private:
+        struct Batch {
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            VkFence fence = VK_NULL_HANDLE;
+            Ticket ticket = 0;
+            VkDeviceSize ringEnd = 0;  // 완료되면 tail이 여기까지 이동
+        };
+
+        VkDeviceSize reserve(VkDeviceSize size);
+        bool tryReserve(VkDeviceSize size, VkDeviceSize& offset);
+        bool isEmpty() const { return inFlight.empty() && !hasPending; }
+        void beginPendingBatch();
+        void retireCompleted();
+        void waitOldest();
+
+        LveDevice& lveDevice;
+        VkDeviceSize capacity;
+
+        VkBuffer ringBuffer = VK_NULL_HANDLE;
+        LveAllocation ringAllocation{};
+        uint8_t* mapped = nullptr;
+
+        VkDeviceSize head = 0;  // 다음 쓰기 위치
+        VkDeviceSize tail = 0;  // GPU가 아직 읽을 수 있는 가장 오래된 위치
+
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        std::vector<Batch> freeBatches;
+        std::deque<Batch> inFlight;
+        Batch pending{};
+        bool hasPending = false;
+
+        Ticket nextTicket = 1;
+        Ticket completedTicket = 0;
+    };
+
+}  // namespace lve
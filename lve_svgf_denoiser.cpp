@@ -0,0 +1,354 @@
+#include "lve_svgf_denoiser.h"
+
+// std
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace lve {
+
+    namespace {
+        constexpr uint32_t WORKGROUP_SIZE = 16;
+        constexpr float MAX_HISTORY_LENGTH = 32.0f;
+
+        // shaders/svgf_*.comp push_constant block과 같은 layout
+        struct TemporalPushConstants {
+            float alphaColor;
+            float alphaMoments;
+            float maxHistoryLength;
+            uint32_t reset;
+        };
+
+        struct VariancePushConstants {
+            float phiNormal;
+            float phiDepth;
+        };
+
+        struct AtrousPushConstants {
+            int32_t stepSize;
+            float phiColor;
+            float phiNormal;
+            float phiDepth;
+            uint32_t writeHistory;
+        };
+
+        struct ModulatePushConstants {
+            uint32_t source;
+        };
+    }
+
+    LveSvgfDenoiser::LveSvgfDenoiser(
+        LveDevice& device,
+        VkExtent2D extent,
+        const std::vector<VkImageView>& outputViews,
+        const LveSvgfSettings& settings)
+        : lveDevice{ device }, extent{ extent }, settings{ settings } {
+        this->settings.atrousIterations = std::max(this->settings.atrousIterations, 1u);
+
+        createImages();
+        createDescriptorPool(static_cast<uint32_t>(outputViews.size()));
+
+        createPass(temporalPass, "shaders/svgf_temporal.comp.spv", 9, sizeof(TemporalPushConstants), 1);
+        createPass(variancePass, "shaders/svgf_variance.comp.spv", 5, sizeof(VariancePushConstants), 1);
+        createPass(atrousPass, "shaders/svgf_atrous.comp.spv", 5, sizeof(AtrousPushConstants), 2);
+        createPass(modulatePass, "shaders/svgf_modulate.comp.spv", 4, sizeof(ModulatePushConstants),
+            static_cast<uint32_t>(outputViews.size()));
+
+        writeDescriptorSets(outputViews);
+    }
+
+    LveSvgfDenoiser::~LveSvgfDenoiser() {
+        destroyPass(temporalPass);
+        destroyPass(variancePass);
+        destroyPass(atrousPass);
+        destroyPass(modulatePass);
+        vkDestroyDescriptorPool(lveDevice.device(), descriptorPool, nullptr);
+
+        for (Image* image : { &color, &albedo, &normalDepth, &motionMesh,
+                              &prevNormalDepth, &prevMotionMesh, &historyColor, &historyMoments,
+                              &integratedColor, &integratedMoments, &pingA, &pingB }) {
+            destroyImage(*image);
+        }
+    }
+
+    void LveSvgfDenoiser::createImages() {
+        createImage(color, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(albedo, VK_FORMAT_R16G16B16A16_SFLOAT);
+        createImage(normalDepth, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(motionMesh, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(prevNormalDepth, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(prevMotionMesh, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(historyColor, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(historyMoments, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(integratedColor, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(integratedMoments, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(pingA, VK_FORMAT_R32G32B32A32_SFLOAT);
+        createImage(pingB, VK_FORMAT_R32G32B32A32_SFLOAT);
+
+        // 전부 GENERAL로 두고 storage image / copy 모두 그 layout에서 사용
+        VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+
+        std::vector<VkImageMemoryBarrier> barriers;
+        for (Image* image : { &color, &albedo, &normalDepth, &motionMesh,
+                              &prevNormalDepth, &prevMotionMesh, &historyColor, &historyMoments,
+                              &integratedColor, &integratedMoments, &pingA, &pingB }) {
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = image->image;
+            barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            barriers.push_back(barrier);
+        }
+
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            0, nullptr,
+            0, nullptr,
+            static_cast<uint32_t>(barriers.size()), barriers.data()
+        );
+
+        lveDevice.endSingleTimeCommands(commandBuffer);
+    }
+
+    void LveSvgfDenoiser::createImage(Image& target, VkFormat format) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = extent.width;
+        imageInfo.extent.height = extent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        lveDevice.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, target.image, target.allocation);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = target.image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+        if (vkCreateImageView(lveDevice.device(), &viewInfo, nullptr, &target.view) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create SVGF image view!");
+        }
+    }
+
+    void LveSvgfDenoiser::destroyImage(Image& target) {
+        vkDestroyImageView(lveDevice.device(), target.view, nullptr);
+        lveDevice.destroyImage(target.image, target.allocation);
+        target.view = VK_NULL_HANDLE;
+    }
+
+    void LveSvgfDenoiser::createDescriptorPool(uint32_t outputCount) {
+        // temporal(9) + variance(5) + à-trous(5 × 2) + modulate(4 × output 수)
+        const uint32_t maxSets = 4 + outputCount;
+        const uint32_t imageCount = 9 + 5 + 5 * 2 + 4 * outputCount;
+
+        VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, imageCount };
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        poolInfo.maxSets = maxSets;
+
+        if (vkCreateDescriptorPool(lveDevice.device(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create SVGF descriptor pool!");
+        }
+    }
+
+    void LveSvgfDenoiser::createPass(ComputePass& pass, const std::string& shaderPath,
+        uint32_t imageCount, uint32_t pushConstantSize, uint32_t setCount) {
+        // binding 0..imageCount-1: storage image
+        std::vector<VkDescriptorSetLayoutBinding> bindings(imageCount);
+        for (uint32_t i = 0; i < imageCount; i++) {
+            bindings[i] = {};
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = imageCount;
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(lveDevice.device(), &layoutInfo, nullptr, &pass.setLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create SVGF descriptor set layout!");
+        }
+
+        lveDevice.createComputePipeline(shaderPath, pass.setLayout, pushConstantSize, pass.pipelineLayout, pass.pipeline);
+
+        std::vector<VkDescriptorSetLayout> layouts(setCount, pass.setLayout);
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = setCount;
+        allocInfo.pSetLayouts = layouts.data();
+
+        pass.descriptorSets.resize(setCount);
+        if (vkAllocateDescriptorSets(lveDevice.device(), &allocInfo, pass.descriptorSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate SVGF descriptor sets!");
+        }
+    }
+
+    void LveSvgfDenoiser::destroyPass(ComputePass& pass) {
+        vkDestroyPipeline(lveDevice.device(), pass.pipeline, nullptr);
+        vkDestroyPipelineLayout(lveDevice.device(), pass.pipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(lveDevice.device(), pass.setLayout, nullptr);
+    }
+
+    void LveSvgfDenoiser::writePassImages(VkDescriptorSet set, const std::vector<VkImageView>& views) {
+        std::vector<VkDescriptorImageInfo> imageInfos(views.size());
+        std::vector<VkWriteDescriptorSet> writes(views.size());
+
+        for (size_t i = 0; i < views.size(); i++) {
+            imageInfos[i].imageView = views[i];
+            imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+            writes[i] = {};
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = set;
+            writes[i].dstBinding = static_cast<uint32_t>(i);
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[i].pImageInfo = &imageInfos[i];
+        }
+
+        vkUpdateDescriptorSets(lveDevice.device(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void LveSvgfDenoiser::writeDescriptorSets(const std::vector<VkImageView>& outputViews) {
+        // binding 순서는 각 shader의 layout(binding = N) 순서
+        writePassImages(temporalPass.descriptorSets[0], {
+            color.view, normalDepth.view, motionMesh.view,
+            prevNormalDepth.view, prevMotionMesh.view,
+            historyColor.view, historyMoments.view,
+            integratedColor.view, integratedMoments.view });
+
+        // variance 결과는 pingA → à-trous 1회차 입력
+        writePassImages(variancePass.descriptorSets[0], {
+            integratedColor.view, integratedMoments.view, normalDepth.view, motionMesh.view, pingA.view });
+
+        writePassImages(atrousPass.descriptorSets[0], {
+            pingA.view, normalDepth.view, motionMesh.view, pingB.view, historyColor.view });
+        writePassImages(atrousPass.descriptorSets[1], {
+            pingB.view, normalDepth.view, motionMesh.view, pingA.view, historyColor.view });
+
+        for (size_t i = 0; i < outputViews.size(); i++) {
+            writePassImages(modulatePass.descriptorSets[i], {
+                pingA.view, pingB.view, albedo.view, outputViews[i] });
+        }
+    }
+
+    void LveSvgfDenoiser::dispatch(VkCommandBuffer commandBuffer, const ComputePass& pass, uint32_t setIndex,
+        const void* pushConstants, uint32_t pushConstantSize) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pass.pipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pass.pipelineLayout,
+            0, 1, &pass.descriptorSets[setIndex], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pass.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, pushConstantSize, pushConstants);
+
+        vkCmdDispatch(commandBuffer,
+            (extent.width + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+            (extent.height + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+            1);
+    }
+
+    void LveSvgfDenoiser::computeBarrier(VkCommandBuffer commandBuffer) {
+        // 모든 image가 GENERAL이므로 pass 사이에는 global memory barrier 하나로 충분
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+            VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void LveSvgfDenoiser::record(VkCommandBuffer commandBuffer, uint32_t outputIndex) {
+        // raygen G-buffer 쓰기 완료 대기
+        computeBarrier(commandBuffer);
+
+        // 1. Temporal accumulation
+        TemporalPushConstants temporal{};
+        temporal.alphaColor = settings.alphaColor;
+        temporal.alphaMoments = settings.alphaMoments;
+        temporal.maxHistoryLength = MAX_HISTORY_LENGTH;
+        temporal.reset = historyValid ? 0u : 1u;
+        {
+            LveGpuProfiler::Scope scope{ profiler, commandBuffer, "svgf temporal" };
+            dispatch(commandBuffer, temporalPass, 0, &temporal, sizeof(temporal));
+        }
+        computeBarrier(commandBuffer);
+
+        // 2. Variance estimation (history가 짧은 pixel은 spatial)
+        VariancePushConstants variance{};
+        variance.phiNormal = settings.phiNormal;
+        variance.phiDepth = settings.phiDepth;
+        {
+            LveGpuProfiler::Scope scope{ profiler, commandBuffer, "svgf variance" };
+            dispatch(commandBuffer, variancePass, 0, &variance, sizeof(variance));
+        }
+        computeBarrier(commandBuffer);
+
+        // 3. À-trous wavelet (A ↔ B ping-pong, 1회차 결과는 다음 프레임 history)
+        uint32_t atrousScope = profiler ? profiler->beginScope(commandBuffer, "svgf atrous") : 0;
+        for (uint32_t i = 0; i < settings.atrousIterations; i++) {
+            AtrousPushConstants atrous{};
+            atrous.stepSize = 1 << i;
+            atrous.phiColor = settings.phiColor;
+            atrous.phiNormal = settings.phiNormal;
+            atrous.phiDepth = settings.phiDepth;
+            atrous.writeHistory = i == 0 ? 1u : 0u;
+            dispatch(commandBuffer, atrousPass, i % 2, &atrous, sizeof(atrous));
+            computeBarrier(commandBuffer);
+        }
+        if (profiler) profiler->endScope(commandBuffer, atrousScope);
+
+        // 4. Albedo 곱해서 output storage image로 (홀수 번 반복이면 결과는 B)
+        ModulatePushConstants modulate{};
+        modulate.source = settings.atrousIterations % 2 == 1 ? 1u : 0u;
+        {
+            LveGpuProfiler::Scope scope{ profiler, commandBuffer, "svgf modulate" };
+            dispatch(commandBuffer, modulatePass, outputIndex, &modulate, sizeof(modulate));
+        }
+
+        // 다음 프레임 reprojection용 G-buffer / moments 보관
+        VkImageCopy copyRegion{};
+        copyRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        copyRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        copyRegion.extent = { extent.width, extent.height, 1 };
+
+        LveGpuProfiler::Scope copyScope{ profiler, commandBuffer, "svgf history copy" };
+        vkCmdCopyImage(commandBuffer, normalDepth.image, VK_IMAGE_LAYOUT_GENERAL,
+            prevNormalDepth.image, VK_IMAGE_LAYOUT_GENERAL, 1, &copyRegion);
+        vkCmdCopyImage(commandBuffer, motionMesh.image, VK_IMAGE_LAYOUT_GENERAL,
+            prevMotionMesh.image, VK_IMAGE_LAYOUT_GENERAL, 1, &copyRegion);
+        vkCmdCopyImage(commandBuffer, integratedMoments.image, VK_IMAGE_LAYOUT_GENERAL,
+            historyMoments.image, VK_IMAGE_LAYOUT_GENERAL, 1, &copyRegion);
+
+        historyValid = true;
+    }
+
+}  // namespace lve
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "lve_device.h"
+#include "lve_gpu_profiler.h"
+
+// std lib headers
+#include <string>
+#include <vector>
+
+namespace lve {
+
+    struct LveSvgfSettings {
+        uint32_t atrousIterations = 5;  // 반복 i의 step = 1 << i (최소 1)
+        float alphaColor = 0.2f;        // temporal blend (history 길이가 짧으면 1/len 사용)
+        float alphaMoments = 0.2f;
+        float phiColor = 10.0f;         // luminance edge-stopping (표준편차 배수)
+        float phiNormal = 128.0f;
+        float phiDepth = 1.0f;
+    };
+
+    // SVGF (Spatiotemporal Variance-Guided Filtering)
+    // raygen이 1 spp 조명 (albedo로 나눈 값) + G-buffer를 쓰면,
+    // record()에서 temporal → variance → à-trous × N → modulate compute pass로
+    // frame별 output storage image (B8G8R8A8)에 결과를 씀
+    class LveSvgfDenoiser {
+    public:
+        LveSvgfDenoiser(
+            LveDevice& device,
+            VkExtent2D extent,
+            const std::vector<VkImageView>& outputViews,  // frame in flight별
+            const LveSvgfSettings& settings = LveSvgfSettings{});
+        ~LveSvgfDenoiser();
+
+        LveSvgfDenoiser(const LveSvgfDenoiser&) = delete;
+        LveSvgfDenoiser& operator=(const LveSvgfDenoiser&) = delete;
+
+        // raygen이 쓰는 G-buffer (GENERAL layout)
+        VkImageView getColorView() const { return color.view; }              // RGBA32F 조명 / albedo
+        VkImageView getAlbedoView() const { return albedo.view; }            // RGBA16F 첫 hit attenuation
+        VkImageView getNormalDepthView() const { return normalDepth.view; }  // RGBA32F normal, view depth
+        VkImageView getMotionMeshView() const { return motionMesh.view; }    // RGBA32F motion (pixel), mesh id
+
+        const LveSvgfSettings& getSettings() const { return settings; }
+
+        // pass별 GPU 시간 측정 (nullptr이면 측정 안 함)
+        void setProfiler(LveGpuProfiler* gpuProfiler) { profiler = gpuProfiler; }
+
+        // 다음 record에서 history를 버림 (처음 켤 때, 장면이 통째로 바뀔 때)
+        void resetHistory() { historyValid = false; }
+
+        // vkCmdTraceRaysKHR 뒤에 호출. outputIndex = frame in flight
+        void record(VkCommandBuffer commandBuffer, uint32_t outputIndex);
+
+    private:
+        struct Image {
+            VkImage image = VK_NULL_HANDLE;
+            LveAllocation allocation{};
+            VkImageView view = VK_NULL_HANDLE;
+        };
+
+        struct ComputePass {
+            VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+            VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            std::vector<VkDescriptorSet> descriptorSets;
+        };
+
+        void createImages();
+        void createImage(Image& target, VkFormat format);
+        void destroyImage(Image& target);
+        void createDescriptorPool(uint32_t outputCount);
+        void createPass(ComputePass& pass, const std::string& shaderPath,
+            uint32_t imageCount, uint32_t pushConstantSize, uint32_t setCount);
+        void destroyPass(ComputePass& pass);
+        void writePassImages(VkDescriptorSet set, const std::vector<VkImageView>& views);
+        void writeDescriptorSets(const std::vector<VkImageView>& outputViews);
+
+        void dispatch(VkCommandBuffer commandBuffer, const ComputePass& pass, uint32_t setIndex,
+            const void* pushConstants, uint32_t pushConstantSize);
+        void computeBarrier(VkCommandBuffer commandBuffer);
+
+        LveDevice& lveDevice;
+        VkExtent2D extent;
+        LveSvgfSettings settings;
+        bool historyValid = false;
+        LveGpuProfiler* profiler = nullptr;
+
+        // raygen 출력
+        Image color;
+        Image albedo;
+        Image normalDepth;
+        Image motionMesh;
+
+        // 이전 프레임 (reprojection용, record 끝에서 copy)
+        Image prevNormalDepth;
+        Image prevMotionMesh;
+        Image historyColor;    // à-trous 1회차 결과
+        Image historyMoments;  // m1, m2, history 길이
+
+        Image integratedColor;    // rgb, variance
+        Image integratedMoments;
+        Image pingA;
+        Image pingB;
+
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        ComputePass temporalPass;
+        ComputePass variancePass;
+        ComputePass atrousPass;    // set 0: A → B, set 1: B → A
+        ComputePass modulatePass;  // set = output index
+    };
+
+}  // namespace lve
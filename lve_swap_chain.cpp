@@ -218,8 +218,7 @@ namespace lve {
 
         for (int i = 0; i < depthImages.size(); i++) {
             vkDestroyImageView(device_.device(), depthImageViews[i], nullptr);
-            vkDestroyImage(device_.device(), depthImages[i], nullptr);
-            vkFreeMemory(device_.device(), depthImageMemorys[i], nullptr);
+            device_.destroyImage(depthImages[i], depthImageAllocations[i]);
         }
 
         for (auto framebuffer : swapChainFramebuffers) {
@@ -326,7 +325,7 @@ namespace lve {
         VkExtent2D swapChainExtent = getSwapChainExtent();
 
         depthImages.resize(imageCount());
-        depthImageMemorys.resize(imageCount());
+        depthImageAllocations.resize(imageCount());
         depthImageViews.resize(imageCount());
 
         for (int i = 0; i < depthImages.size(); i++) {
@@ -350,7 +349,7 @@ namespace lve {
                 imageInfo,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 depthImages[i],
-                depthImageMemorys[i]);
+                depthImageAllocations[i]);
 
             VkImageViewCreateInfo viewInfo{};
             viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
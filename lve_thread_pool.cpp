@@ -0,0 +1,79 @@
+#include "lve_thread_pool.h"
+
+// std
+#include <algorithm>
+
+namespace lve {
+
+    LveThreadPool::LveThreadPool(uint32_t workerCount) {
+        workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; i++) {
+            workers.emplace_back(&LveThreadPool::workerLoop, this);
+        }
+    }
+
+    LveThreadPool::~LveThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            stopping = true;
+        }
+        wakeCondition.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    uint32_t LveThreadPool::defaultWorkerCount() {
+        const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    void LveThreadPool::run(uint32_t concurrency, const std::function<void()>& task) {
+        const uint32_t helpers = std::min(concurrency > 0 ? concurrency - 1 : 0u, static_cast<uint32_t>(workers.size()));
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            currentTask = &task;
+            openSlots = helpers;
+            runningWorkers = helpers;
+            generation++;
+        }
+        if (helpers > 0) {
+            wakeCondition.notify_all();
+        }
+
+        task();
+
+        // worker가 task 참조를 다 놓을 때까지 대기 (task는 호출자 stack에 있음)
+        std::unique_lock<std::mutex> lock{ mutex };
+        doneCondition.wait(lock, [this] { return runningWorkers == 0; });
+        currentTask = nullptr;
+    }
+
+    void LveThreadPool::workerLoop() {
+        uint64_t joinedGeneration = 0;
+        for (;;) {
+            const std::function<void()>* task = nullptr;
+            {
+                std::unique_lock<std::mutex> lock{ mutex };
+                wakeCondition.wait(lock, [&] {
+                    return stopping || (generation != joinedGeneration && openSlots > 0);
+                });
+                if (stopping) return;
+
+                joinedGeneration = generation;
+                openSlots--;
+                task = currentTask;
+            }
+
+            (*task)();
+
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                if (--runningWorkers == 0) {
+                    doneCondition.notify_all();
+                }
+            }
+        }
+    }
+
+}  // namespace lve
@@ -0,0 +1,46 @@
+#pragma once
+
+// std lib headers
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lve {
+
+    // 고정 개수 worker thread (생성 시 한 번 만들고 재사용)
+    // run()은 같은 task를 여러 thread에서 동시에 실행 - deferred operation join처럼
+    // 작업 분배를 task 쪽 (driver)이 하는 경우용. 호출 thread도 task를 실행
+    class LveThreadPool {
+    public:
+        explicit LveThreadPool(uint32_t workerCount = defaultWorkerCount());
+        ~LveThreadPool();
+
+        LveThreadPool(const LveThreadPool&) = delete;
+        LveThreadPool& operator=(const LveThreadPool&) = delete;
+
+        // 호출 thread 포함 최대 동시 실행 수
+        uint32_t getThreadCount() const { return static_cast<uint32_t>(workers.size()) + 1; }
+
+        // task를 최대 concurrency개 thread (호출 thread 포함)에서 실행, 모두 끝나면 반환
+        void run(uint32_t concurrency, const std::function<void()>& task);
+
+        static uint32_t defaultWorkerCount();  // hardware thread 수 - 1 (호출 thread 몫)
+
+    private:
+        void workerLoop();
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wakeCondition;
+        std::condition_variable doneCondition;
+        const std::function<void()>* currentTask = nullptr;
+        uint64_t generation = 0;      // run()마다 증가 (worker가 같은 run에 두 번 참여하지 않도록)
+        uint32_t openSlots = 0;       // 이번 run에서 아직 시작 안 한 worker 자리
+        uint32_t runningWorkers = 0;  // 이번 run에서 아직 안 끝난 worker
+        bool stopping = false;
+    };
+
+}  // namespace lve
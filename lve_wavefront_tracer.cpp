@@ -0,0 +1,438 @@
+#include "lve_wavefront_tracer.h"
+
+// std
+#include <algorithm>
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+
+namespace lve {
+
+    namespace {
+        constexpr uint32_t WORKGROUP_SIZE_2D = 16;  // generate / resolve
+        constexpr uint32_t WORKGROUP_SIZE_1D = 64;  // queue kernel (wf_control.comp의 dispatch 계산과 같아야 함)
+
+        // shaders/wavefront.glsl과 같은 크기
+        constexpr VkDeviceSize PATH_STATE_SIZE = 80;
+        constexpr VkDeviceSize HIT_SIZE = 8;
+        constexpr VkDeviceSize SHADOW_RAY_SIZE = 48;
+        constexpr VkDeviceSize COUNTER_BUFFER_SIZE = 16 * 3 + 4 * 4 + 4 * LveWavefrontTracer::BIN_COUNT * 3;
+
+        // CounterBuffer 안의 indirect argument 위치
+        constexpr VkDeviceSize TRACE_ARGS_OFFSET = 0;
+        constexpr VkDeviceSize SHADOW_ARGS_OFFSET = 16;
+        constexpr VkDeviceSize QUEUE_DISPATCH_OFFSET = 32;
+
+        // wf_control.comp의 op
+        constexpr uint32_t OP_BEGIN_BOUNCE = 0;
+        constexpr uint32_t OP_SCAN_BINS = 1;
+        constexpr uint32_t OP_END_SHADE = 2;
+
+        // wf_trace.rgen의 mode
+        constexpr uint32_t TRACE_MODE_RAYS = 0;
+        constexpr uint32_t TRACE_MODE_SHADOW = 1;
+
+        // shaders/wf_*.comp / wf_trace.rgen push_constant block과 같은 layout
+        struct GeneratePushConstants {
+            alignas(16) glm::vec3 position;
+            alignas(16) glm::vec3 forward;
+            alignas(16) glm::vec3 right;
+            alignas(16) glm::vec3 up;
+            float vfov;
+            float defocusAngle;
+            float focusDist;
+            uint32_t frameIndex;
+            uint32_t sampleIndex;
+            uint32_t samplesPerPixel;
+            uint32_t samplerType;
+            uint32_t width;
+            uint32_t height;
+        };
+
+        struct ControlPushConstants {
+            uint32_t op;
+            uint32_t queue;
+        };
+
+        struct SortPushConstants {
+            uint32_t queue;
+        };
+
+        struct ShadePushConstants {
+            uint32_t queue;
+            uint32_t depth;
+            uint32_t maxDepth;
+            uint32_t russianRouletteDepth;
+            float skyIntensity;
+            uint32_t samplerType;
+        };
+
+        struct ResolvePushConstants {
+            uint32_t frameIndex;
+            uint32_t samplesPerPixel;
+        };
+
+        struct TracePushConstants {
+            uint32_t mode;
+            uint32_t queue;
+        };
+    }
+
+    LveWavefrontTracer::LveWavefrontTracer(
+        LveDevice& device,
+        VkExtent2D extent,
+        const LveAccelerationStructure& accelerationStructure,
+        const LveSampler& sampler,
+        VkImageView accumulationView,
+        const std::vector<VkImageView>& outputViews,
+        const std::string& intersectionShader)
+        : lveDevice{ device }, accelerationStructure{ accelerationStructure }, extent{ extent },
+        capacity{ extent.width * extent.height } {
+        vkCmdTraceRaysKHR = reinterpret_cast<PFN_vkCmdTraceRaysKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkCmdTraceRaysKHR"));
+        vkCmdTraceRaysIndirectKHR = reinterpret_cast<PFN_vkCmdTraceRaysIndirectKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkCmdTraceRaysIndirectKHR"));
+        vkGetBufferDeviceAddressKHR = reinterpret_cast<PFN_vkGetBufferDeviceAddressKHR>(
+            vkGetDeviceProcAddr(lveDevice.device(), "vkGetBufferDeviceAddressKHR"));
+
+        // 지원 안 하면 pixel 수만큼 launch하고 queue 밖의 invocation은 바로 return
+        indirectTrace = lveDevice.supportsTraceRaysIndirect() && vkCmdTraceRaysIndirectKHR != nullptr;
+
+        createBuffers();
+        createDescriptorSets(sampler.getBlueNoiseBuffer(), accumulationView, outputViews);
+
+        createPass(generatePass, "shaders/wf_generate.comp.spv", sizeof(GeneratePushConstants));
+        createPass(controlPass, "shaders/wf_control.comp.spv", sizeof(ControlPushConstants));
+        createPass(binPass, "shaders/wf_bin.comp.spv", sizeof(SortPushConstants));
+        createPass(scatterPass, "shaders/wf_scatter.comp.spv", sizeof(SortPushConstants));
+        createPass(shadePass, "shaders/wf_shade.comp.spv", sizeof(ShadePushConstants));
+        createPass(resolvePass, "shaders/wf_resolve.comp.spv", sizeof(ResolvePushConstants));
+
+        // preset은 record에서 push constant로 넘기므로 variant 하나면 충분
+        tracePipeline = std::make_unique<LveRayTracingPipeline>(
+            lveDevice,
+            "shaders/wf_trace.rgen.spv",
+            std::vector<std::string>{ "shaders/wf_trace.rmiss.spv", "shaders/shadow.rmiss.spv" },
+            LveMaterialRegistry::createDefault(LveHitGroupMode::Branching, "shaders/wf_trace.rchit.spv"),
+            intersectionShader,
+            std::vector<LveQualityPreset>{ { "wavefront", 1, 1, 1 } },
+            std::vector<VkDescriptorSetLayout>{ setLayout }
+        );
+
+        std::cout << "Wavefront tracer: " << capacity << " paths, "
+            << (indirectTrace ? "indirect trace rays" : "full-size trace rays with early-out") << std::endl;
+    }
+
+    LveWavefrontTracer::~LveWavefrontTracer() {
+        tracePipeline.reset();
+
+        destroyPass(generatePass);
+        destroyPass(controlPass);
+        destroyPass(binPass);
+        destroyPass(scatterPass);
+        destroyPass(shadePass);
+        destroyPass(resolvePass);
+        vkDestroyDescriptorPool(lveDevice.device(), descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(lveDevice.device(), setLayout, nullptr);
+
+        for (Buffer* buffer : { &paths, &hits, &rayQueues, &counters, &sortedPaths, &shadowRays }) {
+            lveDevice.destroyBuffer(buffer->buffer, buffer->allocation);
+        }
+    }
+
+    void LveWavefrontTracer::createBuffers() {
+        const VkBufferUsageFlags storage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        const VkMemoryPropertyFlags deviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        lveDevice.createBuffer(PATH_STATE_SIZE * capacity, storage, deviceLocal, paths.buffer, paths.allocation);
+        lveDevice.createBuffer(HIT_SIZE * capacity, storage, deviceLocal, hits.buffer, hits.allocation);
+        lveDevice.createBuffer(sizeof(uint32_t) * 2 * static_cast<VkDeviceSize>(capacity), storage, deviceLocal,
+            rayQueues.buffer, rayQueues.allocation);
+        lveDevice.createBuffer(sizeof(uint32_t) * static_cast<VkDeviceSize>(capacity), storage, deviceLocal,
+            sortedPaths.buffer, sortedPaths.allocation);
+        lveDevice.createBuffer(SHADOW_RAY_SIZE * capacity, storage, deviceLocal, shadowRays.buffer, shadowRays.allocation);
+
+        // indirect argument도 여기서 읽음 (trace rays indirect는 device address로)
+        lveDevice.createBuffer(
+            COUNTER_BUFFER_SIZE,
+            storage | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            deviceLocal,
+            counters.buffer,
+            counters.allocation);
+
+        VkBufferDeviceAddressInfo addressInfo{};
+        addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        addressInfo.buffer = counters.buffer;
+        countersAddress = vkGetBufferDeviceAddressKHR(lveDevice.device(), &addressInfo);
+
+        // 첫 bounce 전까지 읽히는 카운터가 쓰레기 값이 되지 않도록
+        VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+        vkCmdFillBuffer(commandBuffer, counters.buffer, 0, VK_WHOLE_SIZE, 0);
+        lveDevice.endSingleTimeCommands(commandBuffer);
+    }
+
+    void LveWavefrontTracer::createDescriptorSets(
+        VkBuffer blueNoiseBuffer, VkImageView accumulationView, const std::vector<VkImageView>& outputViews) {
+        // binding 0-7: storage buffer, 8: accumulation image, 9: output image (shaders/wavefront.glsl)
+        // 10: blue-noise texture (shaders/sampler.glsl)
+        // trace pipeline의 raygen도 같은 layout을 set 1로 사용
+        std::vector<VkDescriptorSetLayoutBinding> bindings(11);
+        for (uint32_t i = 0; i < bindings.size(); i++) {
+            bool image = i == 8 || i == 9;
+            bindings[i] = {};
+            bindings[i].binding = i;
+            bindings[i].descriptorType = image ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(lveDevice.device(), &layoutInfo, nullptr, &setLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create wavefront descriptor set layout!");
+        }
+
+        const uint32_t setCount = static_cast<uint32_t>(outputViews.size());
+        VkDescriptorPoolSize poolSizes[] = {
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 9 * setCount },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 2 * setCount },
+        };
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes = poolSizes;
+        poolInfo.maxSets = setCount;
+
+        if (vkCreateDescriptorPool(lveDevice.device(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create wavefront descriptor pool!");
+        }
+
+        std::vector<VkDescriptorSetLayout> layouts(setCount, setLayout);
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = setCount;
+        allocInfo.pSetLayouts = layouts.data();
+
+        descriptorSets.resize(setCount);
+        if (vkAllocateDescriptorSets(lveDevice.device(), &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate wavefront descriptor sets!");
+        }
+
+        // binding 2-7, 10: 모든 frame이 공유 (frame 사이는 record 시작의 barrier로 직렬화)
+        const VkBuffer sharedBuffers[] = {
+            paths.buffer, hits.buffer, rayQueues.buffer, counters.buffer, sortedPaths.buffer, shadowRays.buffer,
+            blueNoiseBuffer
+        };
+        const uint32_t sharedBindings[] = { 2, 3, 4, 5, 6, 7, 10 };
+
+        for (uint32_t i = 0; i < setCount; i++) {
+            VkDescriptorBufferInfo bufferInfos[7];
+            std::vector<VkWriteDescriptorSet> writes;
+
+            for (uint32_t b = 0; b < 7; b++) {
+                bufferInfos[b] = { sharedBuffers[b], 0, VK_WHOLE_SIZE };
+
+                VkWriteDescriptorSet write{};
+                write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                write.dstSet = descriptorSets[i];
+                write.dstBinding = sharedBindings[b];
+                write.descriptorCount = 1;
+                write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                write.pBufferInfo = &bufferInfos[b];
+                writes.push_back(write);
+            }
+
+            VkDescriptorImageInfo imageInfos[] = {
+                { VK_NULL_HANDLE, accumulationView, VK_IMAGE_LAYOUT_GENERAL },
+                { VK_NULL_HANDLE, outputViews[i], VK_IMAGE_LAYOUT_GENERAL },
+            };
+
+            for (uint32_t image = 0; image < 2; image++) {
+                VkWriteDescriptorSet write{};
+                write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                write.dstSet = descriptorSets[i];
+                write.dstBinding = 8 + image;
+                write.descriptorCount = 1;
+                write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                write.pImageInfo = &imageInfos[image];
+                writes.push_back(write);
+            }
+
+            vkUpdateDescriptorSets(lveDevice.device(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        }
+
+        writeSceneDescriptors();
+    }
+
+    void LveWavefrontTracer::writeSceneDescriptors() {
+        for (uint32_t i = 0; i < descriptorSets.size(); i++) {
+            // Binding 0: sphere info, 1: 발광 구 목록 (frame별)
+            VkDescriptorBufferInfo bufferInfos[] = {
+                { accelerationStructure.getSphereInfoBuffer(i), 0, VK_WHOLE_SIZE },
+                { accelerationStructure.getLightBuffer(i), 0, VK_WHOLE_SIZE },
+            };
+
+            VkWriteDescriptorSet writes[2]{};
+            for (uint32_t b = 0; b < 2; b++) {
+                writes[b].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[b].dstSet = descriptorSets[i];
+                writes[b].dstBinding = b;
+                writes[b].descriptorCount = 1;
+                writes[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                writes[b].pBufferInfo = &bufferInfos[b];
+            }
+
+            vkUpdateDescriptorSets(lveDevice.device(), 2, writes, 0, nullptr);
+        }
+    }
+
+    void LveWavefrontTracer::createPass(ComputePass& pass, const std::string& shaderPath, uint32_t pushConstantSize) {
+        pass.pushConstantSize = pushConstantSize;
+
+        lveDevice.createComputePipeline(shaderPath, setLayout, pushConstantSize, pass.pipelineLayout, pass.pipeline);
+    }
+
+    void LveWavefrontTracer::destroyPass(ComputePass& pass) {
+        vkDestroyPipeline(lveDevice.device(), pass.pipeline, nullptr);
+        vkDestroyPipelineLayout(lveDevice.device(), pass.pipelineLayout, nullptr);
+    }
+
+    void LveWavefrontTracer::dispatch(VkCommandBuffer commandBuffer, const ComputePass& pass, uint32_t frameIndex,
+        const void* pushConstants, uint32_t groupCountX, uint32_t groupCountY) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pass.pipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pass.pipelineLayout,
+            0, 1, &descriptorSets[frameIndex], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pass.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, pass.pushConstantSize, pushConstants);
+        vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
+    }
+
+    void LveWavefrontTracer::dispatchIndirect(VkCommandBuffer commandBuffer, const ComputePass& pass, uint32_t frameIndex,
+        const void* pushConstants) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pass.pipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pass.pipelineLayout,
+            0, 1, &descriptorSets[frameIndex], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pass.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, pass.pushConstantSize, pushConstants);
+
+        // 현재 ray queue 길이 기준 (OP_BEGIN_BOUNCE에서 계산), 빈 bounce는 work group 0개
+        vkCmdDispatchIndirect(commandBuffer, counters.buffer, QUEUE_DISPATCH_OFFSET);
+    }
+
+    void LveWavefrontTracer::control(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t op, uint32_t queue) {
+        ControlPushConstants params{ op, queue };
+        dispatch(commandBuffer, controlPass, frameIndex, &params, 1, 1);
+        barrier(commandBuffer);
+    }
+
+    void LveWavefrontTracer::traceRays(VkCommandBuffer commandBuffer, uint32_t frameIndex, VkDescriptorSet rayTracingSet,
+        uint32_t mode, uint32_t queue) {
+        VkDescriptorSet sets[] = { rayTracingSet, descriptorSets[frameIndex] };
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, tracePipeline->getPipeline());
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR,
+            tracePipeline->getPipelineLayout(), 0, 2, sets, 0, nullptr);
+
+        TracePushConstants params{ mode, queue };
+        vkCmdPushConstants(commandBuffer, tracePipeline->getPipelineLayout(), VK_SHADER_STAGE_RAYGEN_BIT_KHR,
+            0, sizeof(params), &params);
+
+        VkStridedDeviceAddressRegionKHR raygenRegion = tracePipeline->getRaygenRegion();
+        VkStridedDeviceAddressRegionKHR missRegion = tracePipeline->getMissRegion();
+        VkStridedDeviceAddressRegionKHR hitRegion = tracePipeline->getHitRegion();
+        VkStridedDeviceAddressRegionKHR callableRegion = tracePipeline->getCallableRegion();
+
+        if (indirectTrace) {
+            VkDeviceAddress args = countersAddress + (mode == TRACE_MODE_RAYS ? TRACE_ARGS_OFFSET : SHADOW_ARGS_OFFSET);
+            vkCmdTraceRaysIndirectKHR(commandBuffer, &raygenRegion, &missRegion, &hitRegion, &callableRegion, args);
+        }
+        else {
+            vkCmdTraceRaysKHR(commandBuffer, &raygenRegion, &missRegion, &hitRegion, &callableRegion, capacity, 1, 1);
+        }
+        barrier(commandBuffer);
+    }
+
+    void LveWavefrontTracer::barrier(VkCommandBuffer commandBuffer) {
+        // kernel 사이: storage buffer / image 쓰기 → 다음 kernel의 읽기 + indirect argument 읽기
+        VkMemoryBarrier memoryBarrier{};
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+            VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    void LveWavefrontTracer::record(VkCommandBuffer commandBuffer, uint32_t frameIndex, VkDescriptorSet rayTracingSet,
+        const LveWavefrontCamera& camera, const LveQualityPreset& preset) {
+        const uint32_t samplesPerPixel = std::max(preset.samplesPerPixel, 1u);
+        const uint32_t maxDepth = std::max(preset.maxDepth, 1u);
+        const uint32_t groupsX = (extent.width + WORKGROUP_SIZE_2D - 1) / WORKGROUP_SIZE_2D;
+        const uint32_t groupsY = (extent.height + WORKGROUP_SIZE_2D - 1) / WORKGROUP_SIZE_2D;
+
+        // 이전 프레임 (다른 frame in flight)이 공유 buffer / accumulation image를 다 쓴 뒤에 시작
+        barrier(commandBuffer);
+
+        for (uint32_t sample = 0; sample < samplesPerPixel; sample++) {
+            GeneratePushConstants generate{};
+            generate.position = camera.position;
+            generate.forward = camera.forward;
+            generate.right = camera.right;
+            generate.up = camera.up;
+            generate.vfov = camera.vfov;
+            generate.defocusAngle = camera.defocusAngle;
+            generate.focusDist = camera.focusDist;
+            generate.frameIndex = camera.frameIndex;
+            generate.sampleIndex = sample;
+            generate.samplesPerPixel = samplesPerPixel;
+            generate.samplerType = static_cast<uint32_t>(camera.sampler);
+            generate.width = extent.width;
+            generate.height = extent.height;
+            dispatch(commandBuffer, generatePass, frameIndex, &generate, groupsX, groupsY);
+            barrier(commandBuffer);
+
+            // 모든 bounce를 기록하지만 path가 다 끝나면 이후 launch / dispatch 크기는 0
+            for (uint32_t depth = 0; depth < maxDepth; depth++) {
+                const uint32_t queue = depth % 2;
+
+                control(commandBuffer, frameIndex, OP_BEGIN_BOUNCE, queue);
+                traceRays(commandBuffer, frameIndex, rayTracingSet, TRACE_MODE_RAYS, queue);
+
+                // material별 counting sort: 개수 → prefix sum → 자리 배정
+                SortPushConstants sort{ queue };
+                dispatchIndirect(commandBuffer, binPass, frameIndex, &sort);
+                barrier(commandBuffer);
+                control(commandBuffer, frameIndex, OP_SCAN_BINS, queue);
+                dispatchIndirect(commandBuffer, scatterPass, frameIndex, &sort);
+                barrier(commandBuffer);
+
+                ShadePushConstants shade{};
+                shade.queue = queue;
+                shade.depth = depth;
+                shade.maxDepth = maxDepth;
+                shade.russianRouletteDepth = preset.russianRouletteDepth;
+                shade.skyIntensity = camera.skyIntensity;
+                shade.samplerType = static_cast<uint32_t>(camera.sampler);
+                dispatchIndirect(commandBuffer, shadePass, frameIndex, &shade);
+                barrier(commandBuffer);
+
+                control(commandBuffer, frameIndex, OP_END_SHADE, queue);
+                traceRays(commandBuffer, frameIndex, rayTracingSet, TRACE_MODE_SHADOW, queue);
+            }
+        }
+
+        ResolvePushConstants resolve{ camera.frameIndex, samplesPerPixel };
+        LveGpuProfiler::Scope scope{ profiler, commandBuffer, "wavefront resolve" };
+        dispatch(commandBuffer, resolvePass, frameIndex, &resolve, groupsX, groupsY);
+    }
+
+}  // namespace lve
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "lve_device.h"
+#include "lve_acceleration_structure.h"
+#include "lve_gpu_profiler.h"
+#include "lve_ray_tracing_pipeline.h"
+#include "lve_sampler.h"
+
+// std lib headers
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lve {
+
+    // 한 프레임 렌더에 필요한 카메라 값 (CameraPushConstants와 같은 의미)
+    struct LveWavefrontCamera {
+        glm::vec3 position;
+        glm::vec3 forward;
+        glm::vec3 right;
+        glm::vec3 up;
+        float vfov;
+        float defocusAngle;
+        float focusDist;
+        float skyIntensity;
+        uint32_t frameIndex;  // 누적 프레임 수 (0 = reset), sample index 시작
+        LveSamplerType sampler;
+    };
+
+    // Wavefront path tracing: raygen.rgen의 megakernel loop를 bounce 단위 kernel로 나눔
+    //   generate → [control → trace → bin → scan → scatter → shade → control → shadow trace] × maxDepth → resolve
+    // - trace는 closest hit만 찾음 (모든 material hit group이 같은 가벼운 shader)
+    // - shade 전에 hit을 material별로 counting sort (divergence 감소)
+    // - 살아남은 path만 다음 ray queue에 추가 (stream compaction), 끝난 bounce는 indirect launch 크기 0
+    // 결과는 megakernel과 같은 accumulation image / frame output image에 씀
+    class LveWavefrontTracer {
+    public:
+        static constexpr uint32_t BIN_COUNT = 8;  // material bin 7개 + miss bin (shaders/wavefront.glsl)
+
+        LveWavefrontTracer(
+            LveDevice& device,
+            VkExtent2D extent,
+            const LveAccelerationStructure& accelerationStructure,
+            const LveSampler& sampler,  // blue-noise texture (binding 10)
+            VkImageView accumulationView,
+            const std::vector<VkImageView>& outputViews,  // frame in flight별
+            const std::string& intersectionShader);       // 비어있으면 triangle hit group
+        ~LveWavefrontTracer();
+
+        LveWavefrontTracer(const LveWavefrontTracer&) = delete;
+        LveWavefrontTracer& operator=(const LveWavefrontTracer&) = delete;
+
+        // sphere / light buffer가 다시 만들어졌을 때 (updateInstances가 true를 반환하면)
+        void writeSceneDescriptors();
+
+        void setProfiler(LveGpuProfiler* gpuProfiler) { profiler = gpuProfiler; }
+        bool usesIndirectTrace() const { return indirectTrace; }
+
+        // rayTracingSet: 앱의 ray tracing descriptor set (TLAS, trace pipeline의 set 0)
+        // preset: bounce 수 / sample 수 / Russian roulette 시작 (megakernel과 같은 값)
+        void record(VkCommandBuffer commandBuffer, uint32_t frameIndex, VkDescriptorSet rayTracingSet,
+            const LveWavefrontCamera& camera, const LveQualityPreset& preset);
+
+    private:
+        struct Buffer {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            LveAllocation allocation{};
+        };
+
+        struct ComputePass {
+            VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            uint32_t pushConstantSize = 0;
+        };
+
+        void createBuffers();
+        void createDescriptorSets(
+            VkBuffer blueNoiseBuffer, VkImageView accumulationView, const std::vector<VkImageView>& outputViews);
+        void createPass(ComputePass& pass, const std::string& shaderPath, uint32_t pushConstantSize);
+        void destroyPass(ComputePass& pass);
+
+        void dispatch(VkCommandBuffer commandBuffer, const ComputePass& pass, uint32_t frameIndex,
+            const void* pushConstants, uint32_t groupCountX, uint32_t groupCountY);
+        void dispatchIndirect(VkCommandBuffer commandBuffer, const ComputePass& pass, uint32_t frameIndex,
+            const void* pushConstants);
+        void control(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t op, uint32_t queue);
+        void traceRays(VkCommandBuffer commandBuffer, uint32_t frameIndex, VkDescriptorSet rayTracingSet,
+            uint32_t mode, uint32_t queue);
+        void barrier(VkCommandBuffer commandBuffer);
+
+        LveDevice& lveDevice;
+        const LveAccelerationStructure& accelerationStructure;
+        VkExtent2D extent;
+        uint32_t capacity;  // path 수 = pixel 수
+        bool indirectTrace = false;
+        LveGpuProfiler* profiler = nullptr;
+
+        Buffer paths;        // PathState × capacity
+        Buffer hits;         // Hit × capacity
+        Buffer rayQueues;    // path id × capacity × 2 (ping-pong)
+        Buffer counters;     // indirect args + queue / bin 카운터
+        Buffer sortedPaths;  // material별로 정렬된 path id
+        Buffer shadowRays;   // ShadowRay × capacity
+        VkDeviceAddress countersAddress = 0;
+
+        VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        std::vector<VkDescriptorSet> descriptorSets;  // frame in flight별 (sphere / light buffer, output image)
+
+        ComputePass generatePass;
+        ComputePass controlPass;
+        ComputePass binPass;
+        ComputePass scatterPass;
+        ComputePass shadePass;
+        ComputePass resolvePass;
+
+        // 모든 material hit group이 wf_trace.rchit (instance SBT offset은 megakernel과 같음)
+        std::unique_ptr<LveRayTracingPipeline> tracePipeline;
+
+        PFN_vkCmdTraceRaysKHR vkCmdTraceRaysKHR;
+        PFN_vkCmdTraceRaysIndirectKHR vkCmdTraceRaysIndirectKHR;
+        PFN_vkGetBufferDeviceAddressKHR vkGetBufferDeviceAddressKHR;
+    };
+
+}  // namespace lve
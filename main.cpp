@@ -1,12 +1,185 @@
 #include "first_app_raytracing.h"
+#include "lve_acceleration_structure_cache.h"
+#include "lve_scene_file.h"
 
 // std
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 
-int main() {
-    lve::FirstAppRayTracing app{};
+int main(int argc, char** argv) {
+    lve::AppOptions options{};
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--geometry=triangles") == 0) {
+            options.geometryMode = lve::SphereGeometryMode::Triangles;
+        }
+        else if (std::strcmp(argv[i], "--geometry=procedural") == 0) {
+            options.geometryMode = lve::SphereGeometryMode::Procedural;
+        }
+        else if (std::strcmp(argv[i], "--scene=weekend") == 0) {
+            options.scene = lve::SceneType::OneWeekend;
+        }
+        else if (std::strcmp(argv[i], "--scene=lights") == 0) {
+            options.scene = lve::SceneType::SmallLights;
+        }
+        else if (std::strcmp(argv[i], "--scene=stress") == 0) {
+            options.scene = lve::SceneType::Stress;
+        }
+        else if (std::strncmp(argv[i], "--scene-file=", 13) == 0) {
+            options.sceneFile = argv[i] + 13;
+        }
+        else if (std::strncmp(argv[i], "--export-scene=", 15) == 0) {
+            options.exportScene = argv[i] + 15;
+        }
+        else if (std::strncmp(argv[i], "--convert-scene=", 16) == 0) {
+            // JSON 장면 → 같은 이름의 .lvscene (Vulkan 없이 변환만 하고 종료)
+            const std::string input = argv[i] + 16;
+            const size_t extension = input.find_last_of('.');
+            const size_t separator = input.find_last_of("/\\");
+            const bool hasExtension = extension != std::string::npos &&
+                (separator == std::string::npos || extension > separator);
+            const std::string output = (hasExtension ? input.substr(0, extension) : input) + ".lvscene";
+            try {
+                lve::LveSceneFile::convertJson(input, output);
+            }
+            catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+                return EXIT_FAILURE;
+            }
+            return EXIT_SUCCESS;
+        }
+        else if (std::strcmp(argv[i], "--integrator=megakernel") == 0) {
+            options.integrator = lve::IntegratorMode::Megakernel;
+        }
+        else if (std::strcmp(argv[i], "--integrator=wavefront") == 0) {
+            options.integrator = lve::IntegratorMode::Wavefront;
+        }
+        else if (std::strcmp(argv[i], "--sampler=random") == 0) {
+            options.sampler = lve::LveSamplerType::Random;
+        }
+        else if (std::strcmp(argv[i], "--sampler=sobol") == 0) {
+            options.sampler = lve::LveSamplerType::Sobol;
+        }
+        else if (std::strcmp(argv[i], "--sampler=bluenoise") == 0) {
+            options.sampler = lve::LveSamplerType::BlueNoise;
+        }
+        else if (std::strcmp(argv[i], "--denoiser=svgf") == 0) {
+            options.denoiser = lve::DenoiserMode::Svgf;
+        }
+        else if (std::strcmp(argv[i], "--denoiser=none") == 0) {
+            options.denoiser = lve::DenoiserMode::None;
+        }
+        else if (std::strcmp(argv[i], "--adaptive") == 0) {
+            options.adaptive = true;
+        }
+        else if (std::strncmp(argv[i], "--adaptive-threshold=", 21) == 0) {
+            options.adaptiveSettings.errorThreshold = std::strtof(argv[i] + 21, nullptr);
+        }
+        else if (std::strcmp(argv[i], "--dynamic-resolution") == 0) {
+            options.dynamicResolution = true;
+        }
+        else if (std::strncmp(argv[i], "--target-ms=", 12) == 0) {
+            options.dynamicResolution = true;
+            options.resolutionSettings.targetMs = std::strtof(argv[i] + 12, nullptr);
+        }
+        else if (std::strncmp(argv[i], "--preset=", 9) == 0) {
+            options.qualityPreset = argv[i] + 9;
+        }
+        else if (std::strcmp(argv[i], "--hit-groups=branching") == 0) {
+            options.hitGroupMode = lve::LveHitGroupMode::Branching;
+        }
+        else if (std::strcmp(argv[i], "--hit-groups=specialized") == 0) {
+            options.hitGroupMode = lve::LveHitGroupMode::Specialized;
+        }
+        else if (std::strcmp(argv[i], "--benchmark-hit-groups") == 0) {
+            options.hitGroupBenchmark = true;
+        }
+        else if (std::strcmp(argv[i], "--benchmark-integrators") == 0) {
+            options.integratorBenchmark = true;
+        }
+        else if (std::strcmp(argv[i], "--benchmark-path") == 0) {
+            options.pathBenchmark = true;
+        }
+        else if (std::strncmp(argv[i], "--camera-path=", 14) == 0) {
+            options.pathBenchmark = true;
+            options.cameraPathFile = argv[i] + 14;
+        }
+        else if (std::strncmp(argv[i], "--benchmark-json=", 17) == 0) {
+            options.benchmarkJsonPath = argv[i] + 17;
+        }
+        else if (std::strncmp(argv[i], "--warmup-frames=", 16) == 0) {
+            options.warmupFrames = static_cast<uint32_t>(std::strtoul(argv[i] + 16, nullptr, 10));
+        }
+        else if (std::strncmp(argv[i], "--record-path=", 14) == 0) {
+            options.recordPathFile = argv[i] + 14;
+        }
+        else if (std::strncmp(argv[i], "--stress-size=", 14) == 0) {
+            options.scene = lve::SceneType::Stress;
+            options.stressGridSize = static_cast<uint32_t>(std::strtoul(argv[i] + 14, nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--as-cache") == 0) {
+            options.accelerationCachePath = lve::LveAccelerationStructureCache::DEFAULT_PATH;
+        }
+        else if (std::strncmp(argv[i], "--as-cache=", 11) == 0) {
+            options.accelerationCachePath = argv[i] + 11;
+        }
+        else if (std::strcmp(argv[i], "--as-build=host") == 0) {
+            options.hostAccelerationBuilds = true;
+        }
+        else if (std::strcmp(argv[i], "--as-build=device") == 0) {
+            options.hostAccelerationBuilds = false;
+        }
+        else if (std::strncmp(argv[i], "--mesh=", 7) == 0) {
+            // 여러 번 지정 가능 (.obj / .gltf / .glb)
+            options.meshFiles.push_back(argv[i] + 7);
+        }
+        else if (std::strncmp(argv[i], "--mesh-grid=", 12) == 0) {
+            options.meshGridSize = static_cast<uint32_t>(std::strtoul(argv[i] + 12, nullptr, 10));
+        }
+        else if (std::strncmp(argv[i], "--benchmark-frames=", 19) == 0) {
+            options.benchmarkFrames = static_cast<uint32_t>(std::strtoul(argv[i] + 19, nullptr, 10));
+        }
+        else if (std::strncmp(argv[i], "--atrous-iterations=", 20) == 0) {
+            options.svgfSettings.atrousIterations = static_cast<uint32_t>(std::strtoul(argv[i] + 20, nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        }
+        else if (std::strncmp(argv[i], "--frames=", 9) == 0) {
+            options.headlessFrames = static_cast<uint32_t>(std::strtoul(argv[i] + 9, nullptr, 10));
+        }
+        else if (std::strncmp(argv[i], "--output=", 9) == 0) {
+            options.outputPrefix = argv[i] + 9;
+        }
+        else if (std::strncmp(argv[i], "--offline=", 10) == 0) {
+            // --offline=16384x16384: window 없이 tile 단위로 렌더해 <output>.pfm 저장
+            char* end = nullptr;
+            options.offlineWidth = static_cast<uint32_t>(std::strtoul(argv[i] + 10, &end, 10));
+            options.offlineHeight = (end && *end == 'x') ? static_cast<uint32_t>(std::strtoul(end + 1, nullptr, 10)) : 0;
+            if (options.offlineWidth == 0 || options.offlineHeight == 0) {
+                std::cerr << "invalid offline size: " << argv[i] + 10 << " (expected WIDTHxHEIGHT)\n";
+                return EXIT_FAILURE;
+            }
+            options.headless = true;
+        }
+        else if (std::strncmp(argv[i], "--tile-size=", 12) == 0) {
+            options.tileSize = static_cast<uint32_t>(std::strtoul(argv[i] + 12, nullptr, 10));
+        }
+        else if (std::strncmp(argv[i], "--spp=", 6) == 0) {
+            options.offlineSamples = static_cast<uint32_t>(std::strtoul(argv[i] + 6, nullptr, 10));
+        }
+        else if (std::strncmp(argv[i], "--profile-csv=", 14) == 0) {
+            options.profileCsvPath = argv[i] + 14;
+        }
+        else {
+            std::cerr << "unknown option: " << argv[i] << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    lve::FirstAppRayTracing app{ options };
 
     try {
         app.run();
@@ -17,4 +190,4 @@ int main() {
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,167 @@
+// BSDFs of the sphere materials, shared by closesthit.rchit and wf_shade.comp.
+// Include after sampler.glsl (make_basis, sample_cosine_hemisphere, PI).
+//
+// Conventions: n is the shading normal on the side of the incoming ray, wo points back
+// along the incoming ray, wi is the scattered direction. eval_* returns f * cos(theta_i),
+// pdf_* the solid angle pdf of sample_*; delta lobes report pdf 0 (nothing to weight by MIS).
+
+struct BsdfSample {
+    vec3 direction;
+    vec3 weight;  // f * cos / pdf, multiplies the path throughput
+    float pdf;    // solid angle, 0 for delta lobes
+    bool valid;   // false when the sample went below the surface
+};
+
+// ===== Lambertian =====
+vec3 eval_lambertian(vec3 n, vec3 albedo, vec3 wi) {
+    return albedo * (max(dot(n, wi), 0.0) / PI);
+}
+
+float pdf_lambertian(vec3 n, vec3 wi) {
+    return max(dot(n, wi), 0.0) / PI;
+}
+
+BsdfSample sample_lambertian(vec3 n, vec3 albedo, vec2 u) {
+    BsdfSample s;
+    s.direction = sample_cosine_hemisphere(n, u);
+    s.pdf = pdf_lambertian(n, s.direction);
+    s.weight = albedo;  // cosine sampling cancels cos / pi exactly
+    s.valid = s.pdf > 0.0;
+    return s;
+}
+
+// ===== GGX metal =====
+// The old fuzz perturbed the mirror direction by up to `fuzz` radians, GGX spreads the
+// reflected lobe by about twice the microfacet slope spread, so alpha = fuzz / 2 keeps
+// the scenes looking the same. Below GGX_MIN_ALPHA the metal is a perfect mirror.
+const float GGX_MIN_ALPHA = 1e-3;
+
+float ggx_alpha(float fuzz) {
+    return clamp(0.5 * fuzz, 0.0, 1.0);
+}
+
+vec3 fresnel_schlick(vec3 f0, float cos_theta) {
+    return f0 + (1.0 - f0) * pow(1.0 - clamp(cos_theta, 0.0, 1.0), 5.0);
+}
+
+float ggx_d(float n_dot_h, float alpha) {
+    float a2 = alpha * alpha;
+    float d = n_dot_h * n_dot_h * (a2 - 1.0) + 1.0;
+    return a2 / (PI * d * d);
+}
+
+// Smith Lambda for GGX
+float ggx_lambda(float cos_theta, float alpha) {
+    float cos2 = max(cos_theta * cos_theta, 1e-8);
+    float tan2 = max(1.0 - cos2, 0.0) / cos2;
+    return 0.5 * (-1.0 + sqrt(1.0 + alpha * alpha * tan2));
+}
+
+float ggx_g1(float cos_theta, float alpha) {
+    return 1.0 / (1.0 + ggx_lambda(cos_theta, alpha));
+}
+
+// Height-correlated masking-shadowing
+float ggx_g2(float cos_o, float cos_i, float alpha) {
+    return 1.0 / (1.0 + ggx_lambda(cos_o, alpha) + ggx_lambda(cos_i, alpha));
+}
+
+// Visible normal sampling (Heitz 2018), local frame with the normal on +z
+vec3 sample_ggx_vndf(vec3 wo_local, float alpha, vec2 u) {
+    vec3 vh = normalize(vec3(alpha * wo_local.x, alpha * wo_local.y, wo_local.z));
+    float lensq = vh.x * vh.x + vh.y * vh.y;
+    vec3 t1 = lensq > 0.0 ? vec3(-vh.y, vh.x, 0.0) * inversesqrt(lensq) : vec3(1.0, 0.0, 0.0);
+    vec3 t2 = cross(vh, t1);
+
+    float r = sqrt(u.x);
+    float phi = 2.0 * PI * u.y;
+    float p1 = r * cos(phi);
+    float p2 = r * sin(phi);
+    float s = 0.5 * (1.0 + vh.z);
+    p2 = (1.0 - s) * sqrt(max(0.0, 1.0 - p1 * p1)) + s * p2;
+
+    vec3 nh = p1 * t1 + p2 * t2 + sqrt(max(0.0, 1.0 - p1 * p1 - p2 * p2)) * vh;
+    return normalize(vec3(alpha * nh.x, alpha * nh.y, max(0.0, nh.z)));
+}
+
+vec3 eval_ggx_metal(vec3 n, vec3 wo, vec3 wi, vec3 albedo, float fuzz) {
+    float alpha = ggx_alpha(fuzz);
+    float cos_o = dot(n, wo);
+    float cos_i = dot(n, wi);
+    if (alpha < GGX_MIN_ALPHA || cos_o <= 0.0 || cos_i <= 0.0) {
+        return vec3(0.0);
+    }
+    vec3 h = normalize(wo + wi);
+    vec3 f = fresnel_schlick(albedo, dot(wi, h));
+    return f * (ggx_d(dot(n, h), alpha) * ggx_g2(cos_o, cos_i, alpha) / (4.0 * cos_o));
+}
+
+float pdf_ggx_metal(vec3 n, vec3 wo, vec3 wi, float fuzz) {
+    float alpha = ggx_alpha(fuzz);
+    float cos_o = dot(n, wo);
+    if (alpha < GGX_MIN_ALPHA || cos_o <= 0.0 || dot(n, wi) <= 0.0) {
+        return 0.0;
+    }
+    vec3 h = normalize(wo + wi);
+    // D_v(h) / (4 (wo . h)) = G1(wo) D(h) / (4 cos_o)
+    return ggx_g1(cos_o, alpha) * ggx_d(dot(n, h), alpha) / (4.0 * cos_o);
+}
+
+BsdfSample sample_ggx_metal(vec3 n, vec3 wo, vec3 albedo, float fuzz, vec2 u) {
+    BsdfSample s;
+    float alpha = ggx_alpha(fuzz);
+    float cos_o = max(dot(n, wo), 1e-6);
+
+    if (alpha < GGX_MIN_ALPHA) {
+        s.direction = reflect(-wo, n);
+        s.weight = fresnel_schlick(albedo, cos_o);
+        s.pdf = 0.0;
+        s.valid = true;
+        return s;
+    }
+
+    vec3 tangent;
+    vec3 bitangent;
+    make_basis(n, tangent, bitangent);
+    vec3 wo_local = vec3(dot(wo, tangent), dot(wo, bitangent), cos_o);
+    vec3 h_local = sample_ggx_vndf(wo_local, alpha, u);
+    vec3 h = tangent * h_local.x + bitangent * h_local.y + n * h_local.z;
+
+    s.direction = reflect(-wo, h);
+    float cos_i = dot(n, s.direction);
+    s.valid = cos_i > 0.0;
+    s.pdf = s.valid ? pdf_ggx_metal(n, wo, s.direction, fuzz) : 0.0;
+
+    // VNDF sampling leaves only Fresnel and the shadowing term in the weight
+    s.weight = s.valid
+        ? fresnel_schlick(albedo, dot(s.direction, h)) * (ggx_g2(cos_o, cos_i, alpha) / ggx_g1(cos_o, alpha))
+        : vec3(0.0);
+    return s;
+}
+
+// ===== Dielectric =====
+float reflectance(float cosine, float refraction_index) {
+    float r0 = (1.0 - refraction_index) / (1.0 + refraction_index);
+    r0 = r0 * r0;
+    return r0 + (1.0 - r0) * pow((1.0 - cosine), 5.0);
+}
+
+// Delta lobes only: reflect or refract, chosen with probability equal to the Fresnel term
+BsdfSample sample_dielectric(vec3 n, vec3 wo, bool front_face, float refraction_index, float u) {
+    float ri = front_face ? (1.0 / refraction_index) : refraction_index;
+    float cos_theta = min(dot(wo, n), 1.0);
+    float sin_theta = sqrt(max(0.0, 1.0 - cos_theta * cos_theta));
+    bool cannot_refract = ri * sin_theta > 1.0;
+
+    BsdfSample s;
+    if (cannot_refract || reflectance(cos_theta, ri) > u) {
+        s.direction = reflect(-wo, n);
+    } else {
+        s.direction = refract(-wo, n, ri);
+    }
+    s.direction = normalize(s.direction);
+    s.weight = vec3(1.0);
+    s.pdf = 0.0;
+    s.valid = true;
+    return s;
+}
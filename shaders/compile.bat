@@ -0,0 +1,8 @@
+@echo off
+rem Compile all ray tracing shaders to SPIR-V (glslangValidator from the Vulkan SDK)
+cd /d "%~dp0"
+
+for %%f in (*.rgen *.rmiss *.rchit *.rint *.rahit *.comp) do (
+    echo %%f
+    "%VULKAN_SDK%\Bin\glslangValidator.exe" --target-env vulkan1.2 -o %%f.spv %%f || exit /b 1
+)
@@ -0,0 +1,9 @@
+#!/bin/sh
+# Compile all ray tracing shaders to SPIR-V (glslangValidator from the Vulkan SDK)
+cd "$(dirname "$0")" || exit 1
+
+for shader in *.rgen *.rmiss *.rchit *.rint *.rahit *.comp; do
+    [ -f "$shader" ] || continue
+    echo "$shader"
+    glslangValidator --target-env vulkan1.2 -o "$shader.spv" "$shader" || exit 1
+done
@@ -0,0 +1,176 @@
+// Sample generator shared by the megakernel and the wavefront kernels (must match LveSampler).
+// Every value is a pure function of (pixel, sample index, dimension), so nothing but the
+// first dimension of the current bounce has to travel between shaders.
+//
+// Backends (uniform over a launch, so the branch does not diverge):
+//   SAMPLER_RANDOM      hash of (pixel, index, dimension), same quality as the old hash chain
+//   SAMPLER_SOBOL       Owen-scrambled Sobol (0,2)-sequence, index shuffled per dimension pair
+//   SAMPLER_BLUE_NOISE  tiled blue-noise texture, shifted per dimension, rotated per sample (R2)
+//
+// The blue-noise texture is descriptor binding 10 of set 0 in both the ray tracing set and
+// the wavefront compute set.
+
+const uint SAMPLER_RANDOM = 0u;
+const uint SAMPLER_SOBOL = 1u;
+const uint SAMPLER_BLUE_NOISE = 2u;
+
+const uint BLUE_NOISE_SIZE = 64u;  // LveSampler::BLUE_NOISE_SIZE
+
+// Per texel: two independent blue-noise channels as 16-bit fixed point (x low, y high)
+layout(binding = 10, set = 0, std430) readonly buffer BlueNoiseBuffer {
+    uint blue_noise[];
+};
+
+// Dimension pairs: camera first, then a fixed block per bounce so that every material
+// at the same depth draws from the same (stratified) dimensions
+const uint SAMPLER_DIM_PIXEL = 0u;         // pixel jitter
+const uint SAMPLER_DIM_LENS = 1u;          // defocus disk
+const uint SAMPLER_DIM_FIRST_BOUNCE = 2u;
+const uint SAMPLER_DIMS_PER_BOUNCE = 3u;
+
+// Slots inside a bounce block
+const uint SAMPLER_SLOT_BSDF = 0u;    // scattered direction, x also picks reflect / refract
+const uint SAMPLER_SLOT_LIGHT = 1u;   // direction inside the light cone
+const uint SAMPLER_SLOT_CHOICE = 2u;  // x: light selection, y: Russian roulette
+
+struct SamplerState {
+    uint pixel;      // x | y << 16
+    uint index;      // sample index of this pixel since the last accumulation reset
+    uint dimension;  // first dimension pair of the current bounce
+    uint backend;    // SAMPLER_*
+};
+
+uint hash(uint x) {
+    x += (x << 10u);
+    x ^= (x >> 6u);
+    x += (x << 3u);
+    x ^= (x >> 11u);
+    x += (x << 15u);
+    return x;
+}
+
+uint hash_combine(uint seed, uint value) {
+    return seed ^ (value + 0x9e3779b9u + (seed << 6u) + (seed >> 2u));
+}
+
+SamplerState sampler_init(uvec2 pixel, uint index, uint backend) {
+    return SamplerState(pixel.x | (pixel.y << 16u), index, SAMPLER_DIM_PIXEL, backend);
+}
+
+uint sampler_bounce_dimension(uint depth) {
+    return SAMPLER_DIM_FIRST_BOUNCE + depth * SAMPLER_DIMS_PER_BOUNCE;
+}
+
+// 32-bit fixed point [0, 1) -> float, keeping 24 bits so the result never rounds up to 1
+vec2 fixed_to_unit(uvec2 v) {
+    return vec2(v >> 8u) * (1.0 / 16777216.0);
+}
+
+// ===== Owen-scrambled Sobol (Burley 2020, "Practical Hash-based Owen Scrambling") =====
+uint laine_karras_permutation(uint x, uint seed) {
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return x;
+}
+
+uint nested_uniform_scramble(uint x, uint seed) {
+    return bitfieldReverse(laine_karras_permutation(bitfieldReverse(x), seed));
+}
+
+// Second Sobol dimension: direction numbers v[i + 1] = v[i] ^ (v[i] >> 1), no table needed
+uint sobol_second_dimension(uint index) {
+    uint result = 0u;
+    uint direction = 0x80000000u;
+    for (; index != 0u; index >>= 1u) {
+        if ((index & 1u) != 0u) {
+            result ^= direction;
+        }
+        direction ^= direction >> 1u;
+    }
+    return result;
+}
+
+vec2 sobol_2d(uint index, uint seed) {
+    // Shuffling the index decorrelates dimension pairs (padding), scrambling each axis randomizes the points
+    uint shuffled = nested_uniform_scramble(index, seed);
+    uint x = nested_uniform_scramble(bitfieldReverse(shuffled), hash_combine(seed, 1u));
+    uint y = nested_uniform_scramble(sobol_second_dimension(shuffled), hash_combine(seed, 2u));
+    return fixed_to_unit(uvec2(x, y));
+}
+
+// ===== Blue noise =====
+vec2 blue_noise_2d(uint pixel, uint index, uint dimension) {
+    // Toroidal shift per dimension pair so the dimensions do not share the same pattern
+    uint shift = hash(hash_combine(0x5bd1e995u, dimension));
+    uvec2 p = (uvec2(pixel & 0xFFFFu, pixel >> 16u) + uvec2(shift, shift >> 16u)) & (BLUE_NOISE_SIZE - 1u);
+    uint texel = blue_noise[p.y * BLUE_NOISE_SIZE + p.x];
+
+    // R2 rotation (Cranley-Patterson with the plastic constant) in 32-bit fixed point:
+    // each sample stays blue in screen space and the sequence per pixel is low discrepancy
+    uvec2 rotation = uvec2(index * 3242174889u, index * 2447445414u);
+    return fixed_to_unit(uvec2(texel << 16u, texel & 0xFFFF0000u) + rotation);
+}
+
+// ===== Sampling =====
+vec2 sample_2d(SamplerState s, uint slot) {
+    uint dimension = s.dimension + slot;
+    if (s.backend == SAMPLER_SOBOL) {
+        return sobol_2d(s.index, hash_combine(hash(s.pixel), dimension));
+    }
+    if (s.backend == SAMPLER_BLUE_NOISE) {
+        return blue_noise_2d(s.pixel, s.index, dimension);
+    }
+    uint h = hash(hash_combine(hash_combine(hash(s.pixel), s.index), dimension));
+    return fixed_to_unit(uvec2(h, hash(h ^ 0x68e31da4u)));
+}
+
+// ===== Closed-form warps (no rejection loops) =====
+const float PI = 3.14159265359;
+
+// Shirley-Chiu concentric mapping, keeps the stratification of u
+vec2 sample_disk(vec2 u) {
+    vec2 offset = 2.0 * u - 1.0;
+    if (offset.x == 0.0 && offset.y == 0.0) {
+        return vec2(0.0);
+    }
+
+    float r;
+    float theta;
+    if (abs(offset.x) > abs(offset.y)) {
+        r = offset.x;
+        theta = (PI / 4.0) * (offset.y / offset.x);
+    } else {
+        r = offset.y;
+        theta = (PI / 2.0) - (PI / 4.0) * (offset.x / offset.y);
+    }
+    return r * vec2(cos(theta), sin(theta));
+}
+
+vec3 sample_sphere(vec2 u) {
+    float z = 1.0 - 2.0 * u.x;
+    float r = sqrt(max(0.0, 1.0 - z * z));
+    float phi = 2.0 * PI * u.y;
+    return vec3(r * cos(phi), r * sin(phi), z);
+}
+
+// Orthonormal basis around a unit vector (Duff et al. 2017)
+void make_basis(vec3 n, out vec3 tangent, out vec3 bitangent) {
+    float s = n.z >= 0.0 ? 1.0 : -1.0;
+    float a = -1.0 / (s + n.z);
+    float b = n.x * n.y * a;
+    tangent = vec3(1.0 + s * n.x * n.x * a, s * b, -s * n.x);
+    bitangent = vec3(b, s + n.y * n.y * a, -n.y);
+}
+
+// pdf = cos(theta) / pi, the same distribution as normal + random unit vector
+vec3 sample_cosine_hemisphere(vec3 n, vec2 u) {
+    vec2 d = sample_disk(u);
+    float z = sqrt(max(0.0, 1.0 - dot(d, d)));
+    vec3 tangent;
+    vec3 bitangent;
+    make_basis(n, tangent, bitangent);
+    return normalize(tangent * d.x + bitangent * d.y + n * z);
+}
@@ -0,0 +1,111 @@
+// Shared layout of the wavefront path tracer buffers (included by the wf_* shaders).
+// Must match LveWavefrontTracer. In the trace pipeline this is descriptor set 1
+// (set 0 is the regular ray tracing set with the TLAS), in the compute kernels set 0.
+
+#ifndef WF_SET
+#define WF_SET 0
+#endif
+
+// Bin per material type, the last bin collects misses (sky)
+const uint WF_BIN_COUNT = 8u;
+const uint WF_MISS_BIN = WF_BIN_COUNT - 1u;
+
+// One path per pixel, path id = y * width + x
+struct PathState {
+    vec3 origin;
+    float pdf;          // solid angle pdf of the current ray (0 = camera / specular)
+    vec3 direction;
+    uint sample_index;  // SamplerState.index (sampler.glsl)
+    vec3 throughput;
+    uint pixel;         // SamplerState.pixel
+    vec3 radiance;      // current sample
+    float padding1;
+    vec3 sample_sum;    // finished samples of this frame
+    float padding2;
+};
+
+struct Hit {
+    float t;
+    int instance;  // sphere index, -1 on miss
+};
+
+// Shadow ray of a Lambertian NEE sample; adds contribution to the path if unoccluded
+struct ShadowRay {
+    vec3 origin;
+    float t_max;
+    vec3 direction;
+    uint path;
+    vec3 contribution;
+    float padding;
+};
+
+struct SphereInfo {
+    vec3 center;
+    float radius;
+    vec3 color;
+    float materialType;
+    float materialParam;
+    uint meshId;  // 0 = sphere (meshes are megakernel only)
+    float padding1;
+    float padding2;
+};
+
+layout(binding = 0, set = WF_SET, std430) readonly buffer SphereInfoBuffer {
+    SphereInfo spheres[];
+};
+
+layout(binding = 1, set = WF_SET, std430) readonly buffer LightBuffer {
+    uint light_count;
+    uint light_padding0;
+    uint light_padding1;
+    uint light_padding2;
+    uint light_indices[];
+};
+
+layout(binding = 2, set = WF_SET, std430) buffer PathBuffer {
+    PathState paths[];
+};
+
+layout(binding = 3, set = WF_SET, std430) buffer HitBuffer {
+    Hit hits[];  // indexed by path id
+};
+
+// Two queues of path ids back to back: [0, capacity) and [capacity, 2 * capacity)
+layout(binding = 4, set = WF_SET, std430) buffer RayQueueBuffer {
+    uint ray_queue[];
+};
+
+// Offsets 0 / 16 / 32 are read by vkCmdTraceRaysIndirectKHR / vkCmdDispatchIndirect
+layout(binding = 5, set = WF_SET, std430) buffer CounterBuffer {
+    uvec4 trace_args;      // (ray count, 1, 1, -)
+    uvec4 shadow_args;     // (shadow ray count, 1, 1, -)
+    uvec4 queue_dispatch;  // (work groups over the ray count, 1, 1, -)
+    uint ray_count[2];
+    uint shadow_count;
+    uint counter_padding;
+    uint bin_count[WF_BIN_COUNT];
+    uint bin_offset[WF_BIN_COUNT];
+    uint bin_cursor[WF_BIN_COUNT];
+};
+
+// Queue entries of the current bounce grouped by bin (material)
+layout(binding = 6, set = WF_SET, std430) buffer SortedPathBuffer {
+    uint sorted_paths[];
+};
+
+layout(binding = 7, set = WF_SET, std430) buffer ShadowRayBuffer {
+    ShadowRay shadow_rays[];
+};
+
+uint queue_capacity() {
+    return uint(paths.length());
+}
+
+// Sort key of a traced path: its material, or the miss bin
+uint hit_bin(uint path_id) {
+    int instance = hits[path_id].instance;
+    if (instance < 0) {
+        return WF_MISS_BIN;
+    }
+    return min(uint(spheres[instance].materialType + 0.5), WF_MISS_BIN - 1u);
+}